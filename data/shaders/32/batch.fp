@@ -0,0 +1,172 @@
+#version 150
+
+uniform sampler2D tex;
+uniform sampler2D eggTex;
+uniform sampler2D palette;
+uniform int indexed;
+uniform vec4 fade;
+uniform vec2 eggpos;
+in vec2 UV;
+in vec2 ScreenPos;
+flat in vec2 FrameSpan;
+flat in ivec4 Style;
+out vec4 fragColor;
+
+// indexed textures keep palette index in red channel
+float paletteIndex(vec2 uv)
+{
+    return floor(texture(tex, uv).r * 255.0 + 0.5);
+}
+
+vec4 paletteColor(float index)
+{
+    return texture(palette, vec2((index + 0.5) / 256.0, 0.5));
+}
+
+// index 0 is the only transparent color of the palette
+bool opaque(vec2 uv)
+{
+    if (indexed != 0)
+    {
+        return paletteIndex(uv) != 0.0;
+    }
+    return texture(tex, uv).a != 0.0;
+}
+
+void main(void)
+{
+    int global_light = Style.x;
+    int trans = Style.y;
+    int outline = Style.z;
+    bool doegg = Style.w != 0;
+
+    vec4 origColor;
+    // animated colors of the palette are not lit
+    bool animated = false;
+    if (indexed != 0)
+    {
+        float index = paletteIndex(UV);
+        origColor = paletteColor(index);
+        animated = index >= 229.0 && index <= 254.0;
+    }
+    else
+    {
+        origColor = texture(tex, UV);
+    }
+
+    if (outline == 0)
+    {
+        if (trans == 3) // glass
+        {
+            //origColor.r=0.0;
+            //origColor.g=0.0;
+            //origColor.b=1.0;
+            if (origColor.a>0)
+            {
+                origColor.a=0.5;
+            }
+            origColor.rgb = origColor.rgb/100*global_light;
+        }
+        else if (trans == 4) // steam
+        {
+            if (origColor.a>0)
+            {
+                float gray = dot(origColor.rgb, vec3( 0.21, 0.72, 0.07 ));
+                origColor.rgb = vec3(gray,gray,gray);
+                origColor.a = 0.75;
+            }
+            origColor.rgb = origColor.rgb/100*global_light;
+        }
+        else if (trans == 5) // energy
+        {
+            origColor.r=0.78;
+            origColor.g=0.78;
+            origColor.b=0.0;
+            if (origColor.a>0)
+            {
+                origColor.a=0.5;
+            }
+            origColor.rgb = origColor.rgb/100*global_light;
+        }
+        else if (trans == 6) // red
+        {
+            origColor.r=1.0;
+            origColor.g=0.0;
+            origColor.b=0.0;
+            if (origColor.a>0)
+            {
+                origColor.a=0.5;
+            }
+            origColor.rgb = origColor.rgb/100*global_light;
+        }
+        else if (!animated)
+        {
+            // add light
+            origColor.rgb = origColor.rgb/100*global_light;
+        }
+    }
+    else
+    {
+        vec4 outlineColor = vec4(0.0,0.0,0.0,0.0);
+        if (outline == 1 && FrameSpan.y > 0.0) // red, animated
+        {
+            float texPos = UV.y - FrameSpan.x;
+            float prop = FrameSpan.y/5;
+            int idx = int(texPos / prop);
+            if (idx>4) idx = 4;
+
+            // fast fire colors cycle in the palette
+            outlineColor = vec4(paletteColor(243.0 + float(idx)).rgb,1.0);
+        }
+        else if (outline == 1) // red
+        {
+            outlineColor = vec4(0.25,0.0,0.0,1.0);
+        }
+        else if (outline == 2) // yellow
+        {
+            outlineColor = vec4(1.0,1.0,0.0,1.0);
+        }
+        else if (outline == 3) // green
+        {
+            outlineColor = vec4(0.0,1.0,0.0,1.0);
+        }
+
+        ivec2 texSize = textureSize(tex,0);
+
+        vec2 off = 1.0 / texSize;
+        vec2 tc = UV.st;
+
+        bool n = opaque(vec2(tc.x, tc.y - off.y));
+        bool e = opaque(vec2(tc.x + off.x, tc.y));
+        bool s = opaque(vec2(tc.x, tc.y + off.y));
+        bool w = opaque(vec2(tc.x - off.x, tc.y));
+
+        if (!opaque(tc) && (n || e || s || w))
+        {
+            origColor = outlineColor;
+        }
+        else
+        {
+            origColor = vec4(0.0, 0.0, 0.0, 0.0);
+        }
+    }
+
+    fragColor = mix(origColor, fade, fade.a);
+    fragColor.a = origColor.a;
+
+    if (doegg && outline == 0)
+    {
+        ivec2 pixelpos = ivec2(ScreenPos - eggpos);
+
+
+        if (pixelpos.x>=0 && pixelpos.x<129 && pixelpos.y>=0 && pixelpos.y<98)
+        {
+            vec4 pixel2 = texelFetch(eggTex, pixelpos, 0);
+
+            if (pixel2.a < fragColor.a)
+            {
+                fragColor.a = pixel2.a;
+            }
+        }
+    }
+}
@@ -0,0 +1,132 @@
+#include <chrono>
+#include "../Audio/DecodeThread.h"
+#include "../Format/Acm/File.h"
+
+namespace Falltergeist
+{
+    namespace Audio
+    {
+        DecodeThread::DecodeThread(size_t chunk, size_t depth) : _ring(chunk * depth), _chunk(chunk), _monoChunk(chunk / 2)
+        {
+            _thread = std::thread([this]() { _run(); });
+        }
+
+        DecodeThread::~DecodeThread()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _condition.notify_one();
+            _thread.join();
+        }
+
+        void DecodeThread::start(Format::Acm::File* acm, bool mono, bool loop)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _ring.clear();
+                _acm = acm;
+                _mono = mono;
+                _loop = loop;
+                _rewind = true;
+                _rewound = true;
+                _ended = false;
+                ++_generation;
+            }
+            _condition.notify_one();
+        }
+
+        void DecodeThread::stop()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _ring.clear();
+            _acm = nullptr;
+            _ended = true;
+            ++_generation;
+        }
+
+        size_t DecodeThread::read(uint16_t* samples, size_t count)
+        {
+            return _ring.read(samples, count);
+        }
+
+        bool DecodeThread::finished() const
+        {
+            return _ended && _ring.available() == 0;
+        }
+
+        void DecodeThread::_run()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (!_stopping)
+            {
+                if (!_acm || _ring.space() < _chunk.size())
+                {
+                    // the audio callback doesn't wake the thread up, so the ring is checked every few milliseconds
+                    _condition.wait_for(lock, std::chrono::milliseconds(5));
+                    continue;
+                }
+
+                auto acm = _acm;
+                auto mono = _mono;
+                auto rewind = _rewind;
+                auto generation = _generation;
+                _rewind = false;
+
+                lock.unlock();
+                size_t requested;
+                size_t count = _decodeChunk(acm, mono, rewind, requested);
+                lock.lock();
+
+                // the file was restarted or stopped meanwhile
+                if (generation != _generation)
+                {
+                    continue;
+                }
+                _finishChunk(count, requested);
+            }
+        }
+
+        size_t DecodeThread::_decodeChunk(Format::Acm::File* acm, bool mono, bool rewind, size_t& requested)
+        {
+            if (rewind)
+            {
+                acm->rewind();
+            }
+            if (!mono)
+            {
+                requested = _chunk.size();
+                return acm->readSamples(_chunk.data(), requested);
+            }
+            requested = _monoChunk.size();
+            size_t count = acm->readSamples(_monoChunk.data(), requested);
+            for (size_t i = 0; i != count; ++i)
+            {
+                _chunk[i * 2] = _monoChunk[i];
+                _chunk[i * 2 + 1] = _monoChunk[i];
+            }
+            return count;
+        }
+
+        void DecodeThread::_finishChunk(size_t count, size_t requested)
+        {
+            _ring.write(_chunk.data(), _mono ? count * 2 : count);
+
+            if (count == requested)
+            {
+                _rewound = false;
+                return;
+            }
+            // the file has ended; a file which gives nothing right after rewinding is not looped forever
+            if (_loop && !(_rewound && count == 0))
+            {
+                _rewind = true;
+                _rewound = true;
+                return;
+            }
+            _acm = nullptr;
+            _ended = true;
+        }
+    }
+}
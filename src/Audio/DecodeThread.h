@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../Base/RingBuffer.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Acm
+        {
+            class File;
+        }
+    }
+    namespace Audio
+    {
+        /**
+         * @brief Decodes ACM music and speech ahead of the audio callback on its own thread
+         *
+         * Samples are queued as interleaved stereo into a lock-free ring, so the callback only copies them
+         * and a slow decode shows up as a shorter queue instead of an underrun.
+         * Files are only touched by the thread, chunks are decoded without the lock, so start() and stop() don't wait for them.
+         */
+        class DecodeThread
+        {
+            public:
+                // chunk is the number of samples decoded at once, the ring holds depth chunks
+                DecodeThread(size_t chunk, size_t depth);
+                ~DecodeThread();
+
+                DecodeThread(const DecodeThread&) = delete;
+                DecodeThread& operator= (const DecodeThread&) = delete;
+
+                // Starts decoding file from its beginning, samples of mono files go to both channels.
+                // The audio callback must not read meanwhile.
+                void start(Format::Acm::File* acm, bool mono, bool loop);
+                // Drops the file and queued samples. The audio callback must not read meanwhile.
+                void stop();
+
+                // Takes up to count queued samples, called from the audio callback
+                size_t read(uint16_t* samples, size_t count);
+                // Whether the file has ended and all of its samples were taken
+                bool finished() const;
+
+            private:
+                Base::RingBuffer<uint16_t> _ring;
+                std::vector<uint16_t> _chunk;
+                std::vector<uint16_t> _monoChunk;
+
+                std::thread _thread;
+                std::mutex _mutex;
+                std::condition_variable _condition;
+                bool _stopping = false;
+
+                // guarded by _mutex
+                Format::Acm::File* _acm = nullptr;
+                bool _mono = false;
+                bool _loop = false;
+                // file has to be rewound before the next chunk
+                bool _rewind = false;
+                bool _rewound = false;
+                // changed by start() and stop(), chunks decoded for an older one are dropped
+                uint32_t _generation = 0;
+                std::atomic<bool> _ended{true};
+
+                void _run();
+                // Decodes a chunk without the lock, returns number of samples read from the file
+                size_t _decodeChunk(Format::Acm::File* acm, bool mono, bool rewind, size_t& requested);
+                // Queues decoded chunk and handles the end of the file, called with the lock
+                void _finishChunk(size_t count, size_t requested);
+        };
+    }
+}
@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <string>
 #include <SDL.h>
+#include "../Audio/DecodeThread.h"
 #include "../Audio/Mixer.h"
 #include "../Base/Buffer.h"
 #include "../Exception.h"
@@ -50,11 +52,18 @@ namespace Falltergeist
             logger->info() << message + "[OK]" << std::endl;
             int frequency, channels;
             Mix_QuerySpec(&frequency, &_format, &channels);
+
+            // a buffer of the audio device holds audioBufferSize stereo frames
+            auto settings = Game::getInstance()->settings();
+            size_t bufferSamples = static_cast<size_t>(std::max(settings->audioBufferSize(), 1)) * 2;
+            _decoder = std::make_unique<DecodeThread>(bufferSamples, std::max(settings->audioRingBuffers(), 1u));
+            _mixBuffer.resize(bufferSamples);
         }
 
         void Mixer::stopMusic()
         {
             Mix_HookMusic(NULL, NULL);
+            _decoder->stop();
         }
 
         std::function<void(void*, uint8_t*, uint32_t)> musicCallback;
@@ -68,68 +77,64 @@ namespace Falltergeist
         {
             if (_paused) return;
 
-            auto pacm = (Format::Acm::File*)(udata);
-            if (pacm->samplesLeft() <= 0)
+            if (_decoder->finished())
             {
-                if (_loop)
-                {
-                    pacm->rewind();
-                }
-                else
-                {
-                    Mix_HookMusic(NULL,NULL);
-                    return;
-                }
+                Mix_HookMusic(NULL,NULL);
+                return;
             }
 
-            // music is stereo. just fetch
-            Base::Buffer<uint16_t> tmp(len / 2);
-            pacm->readSamples(tmp.data(), len / 2);
+            // music is stereo. mix whatever is decoded, the rest stays silent
             SDL_memset(stream, 0, len);
-            SDL_MixAudioFormat(stream, (uint8_t*)tmp.data(), _format, len, static_cast<int>(SDL_MIX_MAXVOLUME * _musicVolume));
+            size_t samples = len / 2;
+            size_t mixed = 0;
+            while (mixed < samples)
+            {
+                size_t count = _decoder->read(_mixBuffer.data(), std::min(samples - mixed, _mixBuffer.size()));
+                if (count == 0)
+                {
+                    break;
+                }
+                SDL_MixAudioFormat(stream + mixed * 2, (uint8_t*)_mixBuffer.data(), _format, static_cast<uint32_t>(count * 2), static_cast<int>(SDL_MIX_MAXVOLUME * _musicVolume));
+                mixed += count;
+            }
         }
 
         void Mixer::playACMMusic(const std::string& filename, bool loop)
         {
+            // unhooking waits for a running callback, so it doesn't read the decoder while it's restarted
             Mix_HookMusic(NULL, NULL);
             auto acm = ResourceManager::getInstance()->acmFileType(Game::getInstance()->settings()->musicPath()+filename);
             if (!acm) return;
             _lastMusic = filename;
-            _loop = loop;
             musicCallback = std::bind(&Mixer::_musicCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-            acm->rewind();
-            Mix_HookMusic(myMusicPlayer, (void *)acm);
+            _decoder->start(acm, false, loop);
+            Mix_HookMusic(myMusicPlayer, NULL);
         }
 
         void Mixer::_speechCallback(void *udata, uint8_t *stream, uint32_t len)
         {
             if (_paused) return;
 
-            auto pacm = (Format::Acm::File*)(udata);
-            if (pacm->samplesLeft() <= 0)
+            if (_decoder->finished())
             {
                 Mix_HookMusic(NULL,NULL);
                 return;
             }
 
-            Base::Buffer<uint16_t> tmp(len / 2);
-            uint16_t* sstr = (uint16_t*)stream;
-            pacm->readSamples(tmp.data(), len / 4);
-            for (size_t i = 0; i < len / 4; i++)
-            {
-                sstr[i*2] = tmp[i];
-                sstr[i*2 + 1] = tmp[i];
-            }
+            // speech is already duplicated to both channels by the decoder
+            size_t count = _decoder->read((uint16_t*)stream, len / 2);
+            SDL_memset(stream + count * 2, 0, len - count * 2);
         }
 
         void Mixer::playACMSpeech(const std::string& filename)
         {
+            // speech may start over music, whose callback must not read the decoder while it's restarted
             Mix_HookMusic(NULL, NULL);
             auto acm = ResourceManager::getInstance()->acmFileType("sound/speech/"+filename);
             if (!acm) return;
             musicCallback = std::bind(&Mixer::_speechCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-            acm->rewind();
-            Mix_HookMusic(myMusicPlayer, (void *)acm);
+            _decoder->start(acm, true, false);
+            Mix_HookMusic(myMusicPlayer, NULL);
         }
 
         void Mixer::_movieCallback(void *udata, uint8_t *stream, uint32_t len)
@@ -147,6 +152,8 @@ namespace Falltergeist
 
         void Mixer::playMovieMusic(UI::MvePlayer* mve)
         {
+            Mix_HookMusic(NULL, NULL);
+            _decoder->stop();
             musicCallback = std::bind(&Mixer::_movieCallback,this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
             Mix_HookMusic(myMusicPlayer, reinterpret_cast<void *>(mve));
         }
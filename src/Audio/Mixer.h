@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <SDL_mixer.h>
 #include "../ILogger.h"
 
@@ -15,6 +16,8 @@ namespace Falltergeist
     }
     namespace Audio
     {
+        class DecodeThread;
+
         class Mixer
         {
             public:
@@ -46,7 +49,10 @@ namespace Falltergeist
                 void _movieCallback(void* udata, uint8_t* stream, uint32_t len);
                 std::unordered_map<std::string, Mix_Chunk*> _sfx;
                 bool _paused = false;
-                bool _loop = false;
+                // decodes music and speech ahead, so callbacks only copy and mix samples
+                std::unique_ptr<DecodeThread> _decoder;
+                // samples taken from the decoder before they are mixed at music volume
+                std::vector<uint16_t> _mixBuffer;
 
                 double _musicVolume = 1.0;
                 SDL_AudioFormat _format;
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Falltergeist
+{
+    namespace Base
+    {
+        // A packed two-dimensional set of bits, one bit per pixel of an image.
+        // Each row starts at a 64-bit word boundary, so rows are filled and queried a word at a time.
+        class Bitmask
+        {
+            public:
+                // Creates empty mask with no bits
+                Bitmask()
+                {
+                }
+
+                // Creates mask of given size with all bits cleared
+                Bitmask(unsigned int width, unsigned int height)
+                    : _width(width), _height(height), _stride((width + 63) / 64), _words(static_cast<size_t>(_stride) * height, 0)
+                {
+                }
+
+                unsigned int width() const
+                {
+                    return _width;
+                }
+
+                unsigned int height() const
+                {
+                    return _height;
+                }
+
+                bool empty() const
+                {
+                    return _words.empty();
+                }
+
+                // Returns bit at given position, or false if position is outside the mask
+                bool get(unsigned int x, unsigned int y) const
+                {
+                    if (x >= _width || y >= _height)
+                    {
+                        return false;
+                    }
+                    return (_words[static_cast<size_t>(y) * _stride + x / 64] >> (x % 64)) & 1;
+                }
+
+                void set(unsigned int x, unsigned int y)
+                {
+                    setBits(x, y, 1, 1);
+                }
+
+                // Sets count bits of row y starting at x to the lowest bits of value, count is at most 64.
+                // Bits which are already set stay set.
+                void setBits(unsigned int x, unsigned int y, uint64_t value, unsigned int count)
+                {
+                    if (count < 64)
+                    {
+                        value &= (uint64_t(1) << count) - 1;
+                    }
+                    uint64_t* word = &_words[static_cast<size_t>(y) * _stride + x / 64];
+                    unsigned int shift = x % 64;
+                    word[0] |= value << shift;
+                    if (shift != 0 && shift + count > 64)
+                    {
+                        word[1] |= value >> (64 - shift);
+                    }
+                }
+
+                // Returns whether any bit of the rectangle is set, parts of the rectangle outside the mask are ignored
+                bool any(int x, int y, int width, int height) const
+                {
+                    int left = std::max(x, 0);
+                    int top = std::max(y, 0);
+                    int right = std::min(x + width, static_cast<int>(_width));
+                    int bottom = std::min(y + height, static_cast<int>(_height));
+                    if (left >= right || top >= bottom)
+                    {
+                        return false;
+                    }
+
+                    unsigned int firstWord = left / 64;
+                    unsigned int lastWord = (right - 1) / 64;
+                    uint64_t firstBits = ~uint64_t(0) << (left % 64);
+                    uint64_t lastBits = ~uint64_t(0) >> (63 - (right - 1) % 64);
+
+                    for (int row = top; row != bottom; ++row)
+                    {
+                        const uint64_t* words = &_words[static_cast<size_t>(row) * _stride];
+                        for (unsigned int i = firstWord; i <= lastWord; ++i)
+                        {
+                            uint64_t bits = words[i];
+                            if (i == firstWord)
+                            {
+                                bits &= firstBits;
+                            }
+                            if (i == lastWord)
+                            {
+                                bits &= lastBits;
+                            }
+                            if (bits)
+                            {
+                                return true;
+                            }
+                        }
+                    }
+                    return false;
+                }
+
+                // Number of bytes occupied by bits
+                size_t memoryUsage() const
+                {
+                    return _words.size() * sizeof(uint64_t);
+                }
+
+            private:
+                unsigned int _width = 0;
+                unsigned int _height = 0;
+                // words per row
+                unsigned int _stride = 0;
+                std::vector<uint64_t> _words;
+        };
+    }
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace Falltergeist
+{
+    namespace Base
+    {
+        // A keyed cache of owned objects which tracks the memory footprint of each object
+        // and can evict least recently used ones.
+        //
+        // Objects are never evicted while they are pinned, or if they were used during the current epoch:
+        // callers may keep raw pointers to everything they requested since the epoch started.
+        template <typename Key, typename Value>
+        class LruCache
+        {
+            public:
+                // Calculates number of bytes occupied by given object
+                using Footprint = std::function<size_t(const Value&)>;
+
+                LruCache<Key, Value>(Footprint footprint) : _footprint(std::move(footprint))
+                {
+                }
+
+                LruCache<Key, Value>(const LruCache<Key, Value>&) = delete;
+                LruCache<Key, Value>& operator= (const LruCache<Key, Value>&) = delete;
+
+                // Returns cached object and marks it as most recently used, or nullptr if there is no such object
+                Value* get(const Key& key, uint64_t tick)
+                {
+                    auto it = _entries.find(key);
+                    if (it == _entries.end())
+                    {
+                        return nullptr;
+                    }
+                    _touch(it->second, tick);
+                    return it->second.value.get();
+                }
+
+                // Stores given object, replacing the old one with the same key
+                Value* insert(const Key& key, std::unique_ptr<Value> value, uint64_t tick)
+                {
+                    erase(key);
+                    auto valuePtr = value.get();
+                    auto& entry = _entries[key];
+                    entry.value = std::move(value);
+                    _order.push_back(key);
+                    entry.position = std::prev(_order.end());
+                    entry.tick = tick;
+                    entry.epoch = _epoch;
+                    entry.bytes = _footprint(*valuePtr);
+                    _bytes += entry.bytes;
+                    return valuePtr;
+                }
+
+                bool contains(const Key& key) const
+                {
+                    return _entries.count(key) != 0;
+                }
+
+                void erase(const Key& key)
+                {
+                    auto it = _entries.find(key);
+                    if (it == _entries.end())
+                    {
+                        return;
+                    }
+                    _bytes -= it->second.bytes;
+                    _order.erase(it->second.position);
+                    _entries.erase(it);
+                }
+
+                // Pinned objects are never evicted. Pins are counted.
+                void pin(const Key& key)
+                {
+                    auto it = _entries.find(key);
+                    if (it != _entries.end())
+                    {
+                        ++it->second.pins;
+                    }
+                }
+
+                void unpin(const Key& key)
+                {
+                    auto it = _entries.find(key);
+                    if (it != _entries.end() && it->second.pins > 0)
+                    {
+                        --it->second.pins;
+                    }
+                }
+
+                // Starts new epoch. Objects used before it become evictable unless they are pinned.
+                void setEpoch(uint64_t epoch)
+                {
+                    _epoch = epoch;
+                }
+
+                // Tick of the least recently used evictable object or max value if there is none
+                uint64_t oldestTick() const
+                {
+                    auto it = _oldestEvictable();
+                    return it == _order.end() ? std::numeric_limits<uint64_t>::max() : _entries.at(*it).tick;
+                }
+
+                // Evicts the least recently used evictable object. Returns false if there was nothing to evict.
+                bool evictOldest()
+                {
+                    auto it = _oldestEvictable();
+                    if (it == _order.end())
+                    {
+                        return false;
+                    }
+                    erase(Key(*it));
+                    return true;
+                }
+
+                // Total footprint of all cached objects, as of their last use
+                size_t bytes() const
+                {
+                    return _bytes;
+                }
+
+                size_t size() const
+                {
+                    return _entries.size();
+                }
+
+                void clear()
+                {
+                    _entries.clear();
+                    _order.clear();
+                    _bytes = 0;
+                }
+
+            private:
+                struct Entry
+                {
+                    std::unique_ptr<Value> value;
+                    typename std::list<Key>::iterator position;
+                    uint64_t tick = 0;
+                    uint64_t epoch = 0;
+                    size_t bytes = 0;
+                    unsigned int pins = 0;
+                };
+
+                Footprint _footprint;
+                std::unordered_map<Key, Entry> _entries;
+                // keys from least to most recently used
+                std::list<Key> _order;
+                uint64_t _epoch = 0;
+                size_t _bytes = 0;
+
+                void _touch(Entry& entry, uint64_t tick)
+                {
+                    _order.splice(_order.end(), _order, entry.position);
+                    entry.tick = tick;
+                    entry.epoch = _epoch;
+                    // footprint may grow after first use, e.g. when decoded data is created lazily
+                    _bytes -= entry.bytes;
+                    entry.bytes = _footprint(*entry.value);
+                    _bytes += entry.bytes;
+                }
+
+                typename std::list<Key>::const_iterator _oldestEvictable() const
+                {
+                    for (auto it = _order.begin(); it != _order.end(); ++it)
+                    {
+                        auto& entry = _entries.at(*it);
+                        if (entry.epoch == _epoch)
+                        {
+                            // everything after this one was used during current epoch as well
+                            break;
+                        }
+                        if (entry.pins == 0)
+                        {
+                            return it;
+                        }
+                    }
+                    return _order.end();
+                }
+        };
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace Falltergeist
+{
+    namespace Base
+    {
+        // A fixed-size lock-free queue for one producer thread and one consumer thread.
+        // Neither side ever blocks or allocates: write() takes as many values as fit, read() returns as many as there are.
+        template <typename T>
+        class RingBuffer
+        {
+            public:
+                // Capacity must not be zero
+                explicit RingBuffer(size_t capacity) : _values(capacity)
+                {
+                }
+
+                RingBuffer(const RingBuffer&) = delete;
+                RingBuffer& operator= (const RingBuffer&) = delete;
+
+                size_t capacity() const
+                {
+                    return _values.size();
+                }
+
+                // Number of values which may be read. Called from the consumer thread.
+                size_t available() const
+                {
+                    return _written.load(std::memory_order_acquire) - _read.load(std::memory_order_relaxed);
+                }
+
+                // Number of values which may be written. Called from the producer thread.
+                size_t space() const
+                {
+                    return capacity() - (_written.load(std::memory_order_relaxed) - _read.load(std::memory_order_acquire));
+                }
+
+                // Appends up to count values and returns how many were appended. Called from the producer thread.
+                size_t write(const T* values, size_t count)
+                {
+                    size_t written = _written.load(std::memory_order_relaxed);
+                    count = std::min(count, space());
+                    // the part up to the end of storage, then the part from its beginning
+                    size_t start = written % capacity();
+                    size_t head = std::min(count, capacity() - start);
+                    std::copy(values, values + head, _values.begin() + start);
+                    std::copy(values + head, values + count, _values.begin());
+                    _written.store(written + count, std::memory_order_release);
+                    return count;
+                }
+
+                // Takes up to count oldest values and returns how many were taken. Called from the consumer thread.
+                size_t read(T* values, size_t count)
+                {
+                    size_t read = _read.load(std::memory_order_relaxed);
+                    count = std::min(count, available());
+                    size_t start = read % capacity();
+                    size_t head = std::min(count, capacity() - start);
+                    std::copy(_values.begin() + start, _values.begin() + start + head, values);
+                    std::copy(_values.begin(), _values.begin() + (count - head), values + head);
+                    _read.store(read + count, std::memory_order_release);
+                    return count;
+                }
+
+                // Drops all values. Neither thread may use the buffer meanwhile.
+                void clear()
+                {
+                    _read.store(_written.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                }
+
+            private:
+                std::vector<T> _values;
+                // total numbers of values ever written and read, their difference is the number of queued values
+                std::atomic<size_t> _written{0};
+                std::atomic<size_t> _read{0};
+        };
+    }
+}
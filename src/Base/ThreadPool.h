@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Falltergeist
+{
+    namespace Base
+    {
+        // A fixed-size pool of worker threads executing queued tasks in FIFO order.
+        // Tasks must not touch objects that are not safe to be used outside of the main thread.
+        class ThreadPool
+        {
+            public:
+                // Creates a pool with given number of workers. Zero means one worker per hardware thread.
+                explicit ThreadPool(size_t numberOfThreads = 0)
+                {
+                    if (numberOfThreads == 0)
+                    {
+                        numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+                    }
+                    for (size_t i = 0; i != numberOfThreads; ++i)
+                    {
+                        _workers.emplace_back([this]() { _work(); });
+                    }
+                }
+
+                ThreadPool(const ThreadPool&) = delete;
+                ThreadPool& operator= (const ThreadPool&) = delete;
+
+                // Waits for all queued tasks to finish and joins workers
+                ~ThreadPool()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _stopping = true;
+                    }
+                    _condition.notify_all();
+                    for (auto& worker : _workers)
+                    {
+                        worker.join();
+                    }
+                }
+
+                // Queues given callable and returns a future for its result
+                template <typename Func>
+                std::future<typename std::result_of<Func()>::type> enqueue(Func&& func)
+                {
+                    using ResultType = typename std::result_of<Func()>::type;
+
+                    auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<Func>(func));
+                    auto future = task->get_future();
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _tasks.emplace([task]() { (*task)(); });
+                    }
+                    _condition.notify_one();
+                    return future;
+                }
+
+                size_t size() const
+                {
+                    return _workers.size();
+                }
+
+            private:
+                std::vector<std::thread> _workers;
+                std::queue<std::function<void()>> _tasks;
+                std::mutex _mutex;
+                std::condition_variable _condition;
+                bool _stopping = false;
+
+                void _work()
+                {
+                    while (true)
+                    {
+                        std::function<void()> task;
+                        {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            _condition.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+                            if (_tasks.empty())
+                            {
+                                return;
+                            }
+                            task = std::move(_tasks.front());
+                            _tasks.pop();
+                        }
+                        task();
+                    }
+                }
+        };
+    }
+}
@@ -364,6 +364,83 @@ namespace Falltergeist
         return false;
     }
 
+    std::vector<std::string> CrossPlatform::findFiles(const std::string& directory, const std::function<bool(const std::string&)>& descend)
+    {
+        std::vector<std::string> files;
+        std::vector<std::string> pending = {""};
+
+        while (!pending.empty())
+        {
+            std::string relativePath = pending.back();
+            pending.pop_back();
+            std::string prefix = relativePath.empty() ? "" : relativePath + "/";
+
+    #if defined(_WIN32) || defined(WIN32) // Windows
+            WIN32_FIND_DATA ffd;
+            HANDLE hFind = FindFirstFile((directory + "/" + prefix + "*").c_str(), &ffd);
+            if (hFind == INVALID_HANDLE_VALUE)
+            {
+                continue;
+            }
+            do {
+                std::string name(ffd.cFileName);
+                if (name == "." || name == "..")
+                {
+                    continue;
+                }
+                if (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+                {
+                    if (!descend || descend(prefix + name))
+                    {
+                        pending.push_back(prefix + name);
+                    }
+                }
+                else
+                {
+                    files.push_back(prefix + name);
+                }
+            } while (FindNextFile(hFind, &ffd) != 0);
+            FindClose(hFind);
+    #else
+            DIR *pxDir = opendir((directory + "/" + prefix).c_str());
+            if (!pxDir)
+            {
+                continue;
+            }
+            struct dirent *pxItem = 0;
+            while ((pxItem = readdir(pxDir)))
+            {
+                std::string name(pxItem->d_name);
+                if (name == "." || name == "..")
+                {
+                    continue;
+                }
+                struct stat st;
+                if (stat((directory + "/" + prefix + name).c_str(), &st) != 0)
+                {
+                    continue;
+                }
+                if (S_ISDIR(st.st_mode))
+                {
+                    // symbolic links to directories are not followed to avoid cycles
+                    struct stat linkSt;
+                    if (lstat((directory + "/" + prefix + name).c_str(), &linkSt) == 0 && !S_ISLNK(linkSt.st_mode)
+                        && (!descend || descend(prefix + name)))
+                    {
+                        pending.push_back(prefix + name);
+                    }
+                }
+                else if (S_ISREG(st.st_mode))
+                {
+                    files.push_back(prefix + name);
+                }
+            }
+            closedir(pxDir);
+    #endif
+        }
+        return files;
+    }
+
     std::string CrossPlatform::getConfigPath()
     {
     #if defined(__unix__)
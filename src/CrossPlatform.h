@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <list>
 #include <string>
 #include <vector>
@@ -25,6 +26,11 @@ namespace Falltergeist
 
             static bool fileExists(std::string file);
 
+            // Paths of all regular files within given directory and its subdirectories, relative to that directory.
+            // Returns empty list if directory does not exist.
+            // When descend is set, only subdirectories for which it returns true (given relative path) are scanned.
+            static std::vector<std::string> findFiles(const std::string& directory, const std::function<bool(const std::string&)>& descend = nullptr);
+
         protected:
             CrossPlatform() = default;
             ~CrossPlatform() = default;
@@ -4,6 +4,10 @@
 // Link to the plugin: https://github.com/gemrb/gemrb/tree/8e759bc6874a80d4a8d73bf79603624465b3aeb0/gemrb/plugins/ACMReader
 
 #include <cstdlib>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define ACM_SSE2
+#endif
 #include "../Acm/Decoder.h"
 
 namespace Falltergeist
@@ -12,6 +16,89 @@ namespace Falltergeist
     {
         namespace Acm
         {
+            namespace
+            {
+                // Inverse filter of one subband column: an optional pair of rows, then groups of four rows.
+                // db0 and db1 come in as the last two rows of the previous block and leave as the last two rows of this one.
+                // Columns don't depend on each other, so the SIMD variant below runs four of them at once.
+                inline void filterColumn(int *buffer, int sbSize, bool pair, int groups, int &db0, int &db1)
+                {
+                    if (pair)
+                    {
+                        int row0 = buffer[0];
+                        int row1 = buffer[sbSize];
+                        buffer[0] = db0 + 2 * db1 + row0;
+                        buffer[sbSize] = -db1 + 2 * row0 - row1;
+                        buffer += sbSize * 2;
+                        db0 = row0;
+                        db1 = row1;
+                    }
+
+                    for (int j = 0; j < groups; j++)
+                    {
+                        int row0 = buffer[0];
+                        buffer[0] = db0 + 2 * db1 + row0;
+                        buffer += sbSize;
+                        int row1 = buffer[0];
+                        buffer[0] = -db1 + 2 * row0 - row1;
+                        buffer += sbSize;
+                        int row2 = buffer[0];
+                        buffer[0] = row0 + 2 * row1 + row2;
+                        buffer += sbSize;
+                        int row3 = buffer[0];
+                        buffer[0] = -row1 + 2 * row2 - row3;
+                        buffer += sbSize;
+
+                        db0 = row2;
+                        db1 = row3;
+                    }
+                }
+
+#if defined(ACM_SSE2)
+                inline __m128i twice(__m128i value)
+                {
+                    return _mm_add_epi32(value, value);
+                }
+
+                // Same as filterColumn for four neighbouring columns
+                inline void filterColumns(int *buffer, int sbSize, bool pair, int groups, __m128i &db0, __m128i &db1)
+                {
+                    auto load = [](const int *values) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values)); };
+                    auto store = [](int *values, __m128i value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(values), value); };
+
+                    if (pair)
+                    {
+                        __m128i row0 = load(buffer);
+                        __m128i row1 = load(buffer + sbSize);
+                        store(buffer, _mm_add_epi32(_mm_add_epi32(db0, twice(db1)), row0));
+                        store(buffer + sbSize, _mm_sub_epi32(_mm_sub_epi32(twice(row0), db1), row1));
+                        buffer += sbSize * 2;
+                        db0 = row0;
+                        db1 = row1;
+                    }
+
+                    for (int j = 0; j < groups; j++)
+                    {
+                        __m128i row0 = load(buffer);
+                        store(buffer, _mm_add_epi32(_mm_add_epi32(db0, twice(db1)), row0));
+                        buffer += sbSize;
+                        __m128i row1 = load(buffer);
+                        store(buffer, _mm_sub_epi32(_mm_sub_epi32(twice(row0), db1), row1));
+                        buffer += sbSize;
+                        __m128i row2 = load(buffer);
+                        store(buffer, _mm_add_epi32(_mm_add_epi32(row0, twice(row1)), row2));
+                        buffer += sbSize;
+                        __m128i row3 = load(buffer);
+                        store(buffer, _mm_sub_epi32(_mm_sub_epi32(twice(row2), row1), row3));
+                        buffer += sbSize;
+
+                        db0 = row2;
+                        db1 = row3;
+                    }
+                }
+#endif
+            }
+
             int Decoder::init()
             {
                 int memory_size = (_levels == 0) ? 0 : (3 * (_blockSize >> 1) - 2);
@@ -56,155 +143,52 @@ namespace Falltergeist
             void Decoder::_sub4d3fcc(short *memory, int *buffer, int sbSize,
                     int blocks)
             {
-                int row0, row1, row2 = 0, row3 = 0, db0, db1;
-                int i;
-                int sbSize2 = sbSize * 2, sbSize3 = sbSize * 3;
-                if (blocks == 2)
+                bool pair = (blocks >> 1) & 1;
+                int groups = blocks >> 2;
+                int i = 0;
+#if defined(ACM_SSE2)
+                for (; i + 4 <= sbSize; i += 4)
                 {
-                    for (i = 0; i < sbSize; i++)
-                    {
-                        row0 = buffer[0];
-                        row1 = buffer[sbSize];
-                        buffer[0] = buffer[0] + memory[0] + 2 * memory[1];
-                        buffer[sbSize] = 2 * row0 - memory[1] - buffer[sbSize];
-                        memory[0] = (short) row0;
-                        memory[1] = (short) row1;
-
-                        memory += 2;
-                        buffer++;
-                    }
+                    // both 16-bit values of a column share a 32-bit lane
+                    __m128i state = _mm_loadu_si128(reinterpret_cast<const __m128i*>(memory + i * 2));
+                    __m128i db0 = _mm_srai_epi32(_mm_slli_epi32(state, 16), 16);
+                    __m128i db1 = _mm_srai_epi32(state, 16);
+                    filterColumns(buffer + i, sbSize, pair, groups, db0, db1);
+                    state = _mm_or_si128(_mm_and_si128(db0, _mm_set1_epi32(0xFFFF)), _mm_slli_epi32(db1, 16));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(memory + i * 2), state);
+                }
+#endif
+                for (; i < sbSize; i++)
+                {
+                    int db0 = memory[i * 2];
+                    int db1 = memory[i * 2 + 1];
+                    filterColumn(buffer + i, sbSize, pair, groups, db0, db1);
+                    memory[i * 2] = (short) db0;
+                    memory[i * 2 + 1] = (short) db1;
                 }
-                else
-                    if (blocks == 4)
-                    {
-                        for (i = 0; i < sbSize; i++)
-                        {
-                            row0 = buffer[0];
-                            row1 = buffer[sbSize];
-                            row2 = buffer[sbSize2];
-                            row3 = buffer[sbSize3];
-
-                            buffer[0] = memory[0] + 2 * memory[1] + row0;
-                            buffer[sbSize] = -memory[1] + 2 * row0 - row1;
-                            buffer[sbSize2] = row0 + 2 * row1 + row2;
-                            buffer[sbSize3] = -row1 + 2 * row2 - row3;
-
-                            memory[0] = (short) row2;
-                            memory[1] = (short) row3;
-
-                            memory += 2;
-                            buffer++;
-                        }
-                    }
-                    else
-                    {
-                        for (i = 0; i < sbSize; i++)
-                        {
-                            int *buffPtr = buffer;
-                            if ((blocks >> 1) & 1)
-                            {
-                                row0 = buffPtr[0];
-                                row1 = buffPtr[sbSize];
-
-                                buffPtr[0] = memory[0] + 2 * memory[1] + row0;
-                                buffPtr[sbSize] = -memory[1] + 2 * row0 - row1;
-                                buffPtr += sbSize2;
-
-                                db0 = row0;
-                                db1 = row1;
-                            }
-                            else
-                            {
-                                db0 = memory[0];
-                                db1 = memory[1];
-                            }
-
-                            for (int j = 0; j < (blocks >> 2); j++)
-                            {
-                                row0 = buffPtr[0];
-                                buffPtr[0] = db0 + 2 * db1 + row0;
-                                buffPtr += sbSize;
-                                row1 = buffPtr[0];
-                                buffPtr[0] = -db1 + 2 * row0 - row1;
-                                buffPtr += sbSize;
-                                row2 = buffPtr[0];
-                                buffPtr[0] = row0 + 2 * row1 + row2;
-                                buffPtr += sbSize;
-                                row3 = buffPtr[0];
-                                buffPtr[0] = -row1 + 2 * row2 -
-                                        row3;
-                                buffPtr += sbSize;
-
-                                db0 = row2;
-                                db1 = row3;
-                            }
-                            memory[0] = (short) row2;
-                            memory[1] = (short) row3;
-                            memory += 2;
-                            buffer++;
-                        }
-                    }
             }
 
             void Decoder::_sub4d420c(int *memory, int *buffer, int sbSize,
                     int blocks)
             {
-                int row0, row1, row2 = 0, row3 = 0, db0, db1;
-                int i;
-                int sbSize2 = sbSize * 2, sbSize3 = sbSize * 3;
-                if (blocks == 4)
+                int groups = blocks >> 2;
+                int i = 0;
+#if defined(ACM_SSE2)
+                for (; i + 4 <= sbSize; i += 4)
                 {
-                    for (i = 0; i < sbSize; i++)
-                    {
-                        row0 = buffer[0];
-                        row1 = buffer[sbSize];
-                        row2 = buffer[sbSize2];
-                        row3 = buffer[sbSize3];
-
-                        buffer[0] = memory[0] + 2 * memory[1] + row0;
-                        buffer[sbSize] = -memory[1] + 2 * row0 - row1;
-                        buffer[sbSize2] = row0 + 2 * row1 + row2;
-                        buffer[sbSize3] = -row1 + 2 * row2 - row3;
-
-                        memory[0] = row2;
-                        memory[1] = row3;
-
-                        memory += 2;
-                        buffer++;
-                    }
+                    // split pairs of values of four columns into two vectors and join them back afterwards
+                    __m128 low = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(memory + i * 2)));
+                    __m128 high = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(memory + i * 2 + 4)));
+                    __m128i db0 = _mm_castps_si128(_mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0)));
+                    __m128i db1 = _mm_castps_si128(_mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1)));
+                    filterColumns(buffer + i, sbSize, false, groups, db0, db1);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(memory + i * 2), _mm_unpacklo_epi32(db0, db1));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(memory + i * 2 + 4), _mm_unpackhi_epi32(db0, db1));
                 }
-                else
+#endif
+                for (; i < sbSize; i++)
                 {
-                    for (i = 0; i < sbSize; i++)
-                    {
-                        int *buffPtr = buffer;
-                        db0 = memory[0];
-                        db1 = memory[1];
-                        for (int j = 0; j < (blocks >> 2); j++)
-                        {
-                            row0 = buffPtr[0];
-                            buffPtr[0] = db0 + 2 * db1 + row0;
-                            buffPtr += sbSize;
-                            row1 = buffPtr[0];
-                            buffPtr[0] = -db1 + 2 * row0 - row1;
-                            buffPtr += sbSize;
-                            row2 = buffPtr[0];
-                            buffPtr[0] = row0 + 2 * row1 + row2;
-                            buffPtr += sbSize;
-                            row3 = buffPtr[0];
-                            buffPtr[0] = -row1 + 2 * row2 -
-                                    row3;
-                            buffPtr += sbSize;
-
-                            db0 = row2;
-                            db1 = row3;
-                        }
-                        memory[0] = row2;
-                        memory[1] = row3;
-
-                        memory += 2;
-                        buffer++;
-                    }
+                    filterColumn(buffer + i, sbSize, false, groups, memory[i * 2], memory[i * 2 + 1]);
                 }
             }
 
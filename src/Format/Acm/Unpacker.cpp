@@ -71,6 +71,26 @@ namespace Falltergeist
 
             inline void ValueUnpacker::_prepareBits(int bits)
             {
+                if (bits <= _availBits)
+                {
+                    return;
+                }
+                // refill with one 64-bit load while the buffer holds eight more bytes. A byte which doesn't fit entirely
+                // is loaded again by the next refill at the same place, so its bits may be or-ed twice.
+                if (_bufferBitOffset + 8 <= UNPACKER_BUFFER_SIZE)
+                {
+                    const unsigned char* bytes = _bitsBuffer + _bufferBitOffset;
+                    uint64_t word = 0;
+                    for (int i = 0; i != 8; i++)
+                    {
+                        word |= (uint64_t) bytes[i] << (i * 8);
+                    }
+                    int count = (63 - _availBits) >> 3;
+                    _nextBits |= word << _availBits;
+                    _availBits += count * 8;
+                    _bufferBitOffset += count;
+                    return;
+                }
                 while (bits > _availBits)
                 {
                     unsigned char one_byte;
@@ -94,7 +114,7 @@ namespace Falltergeist
                     {
                         one_byte = 0;
                     }
-                    _nextBits |= ((unsigned int) one_byte << _availBits);
+                    _nextBits |= ((uint64_t) one_byte << _availBits);
                     _availBits += 8;
                 }
             }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include "../Dat/Item.h"
 
 #define UNPACKER_BUFFER_SIZE 16384
@@ -51,7 +52,7 @@ namespace Falltergeist
                     int _levels, _subblocks;
                     Dat::Stream *stream;
                     // Bits
-                    unsigned int _nextBits; // new bits
+                    uint64_t _nextBits; // new bits, the ones above _availBits are either zero or the bits which follow in the stream
                     int _availBits; // count of new bits
                     unsigned char _bitsBuffer[UNPACKER_BUFFER_SIZE];
                     size_t _bufferBitOffset;
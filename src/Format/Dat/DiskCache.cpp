@@ -0,0 +1,154 @@
+#if defined(_WIN32) || defined(WIN32)
+    #include <windows.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include "../../Format/Dat/DiskCache.h"
+#include "../../Format/Dat/Entry.h"
+#include "../../Format/Dat/File.h"
+#include "../../Format/Dat/MappedFile.h"
+#include "../../Format/Dat/Stream.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Dat
+        {
+            namespace
+            {
+                const char RECORD_MAGIC[4] = {'F', 'G', 'D', 'C'};
+                const uint32_t RECORD_VERSION = 3;
+
+                // Records are machine-local, so header is stored in native byte order.
+                // The header is followed by the record key and then by the entry data, which is used right from the mapped record.
+                struct RecordHeader
+                {
+                    char magic[4];
+                    uint32_t version;
+                    uint32_t keySize;
+                    uint32_t size;
+                };
+
+                // 64-bit FNV-1a
+                uint64_t hash(const char* data, size_t size)
+                {
+                    uint64_t result = 0xcbf29ce484222325ULL;
+                    for (size_t i = 0; i != size; ++i)
+                    {
+                        result ^= static_cast<uint8_t>(data[i]);
+                        result *= 0x100000001b3ULL;
+                    }
+                    return result;
+                }
+
+                // Moves temporary file over the record, readers see either the old record or the new one
+                bool replace(const std::string& from, const std::string& to)
+                {
+#if defined(_WIN32) || defined(WIN32)
+                    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+                    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+                }
+            }
+
+            DiskCache::DiskCache(const std::string& path) : _path(path)
+            {
+            }
+
+            const std::string& DiskCache::path() const
+            {
+                return _path;
+            }
+
+            std::string DiskCache::_recordKey(Entry& entry) const
+            {
+                std::ostringstream key;
+                key << entry.datFile()->filename() << '|'
+                    << entry.dataOffset() << '|'
+                    << entry.packedSize() << '|'
+                    << entry.unpackedSize() << '|'
+                    << entry.datFile()->modificationTime();
+                return key.str();
+            }
+
+            std::string DiskCache::_recordPath(const std::string& key) const
+            {
+                std::ostringstream path;
+                path << _path << "/" << std::hex << std::setw(16) << std::setfill('0') << hash(key.data(), key.size()) << ".bin";
+                return path.str();
+            }
+
+            std::unique_ptr<Stream> DiskCache::load(Entry& entry) const
+            {
+                auto key = _recordKey(entry);
+                auto record = std::make_shared<MappedFile>(_recordPath(key));
+                if (record->data() == nullptr || record->size() < sizeof(RecordHeader))
+                {
+                    return nullptr;
+                }
+
+                // records are replaced only as a whole, so matching header, key and size is enough to trust the data
+                RecordHeader header;
+                memcpy(&header, record->data(), sizeof(header));
+                if (memcmp(header.magic, RECORD_MAGIC, sizeof(RECORD_MAGIC)) != 0
+                    || header.version != RECORD_VERSION
+                    || header.keySize != key.size()
+                    || header.size != entry.unpackedSize()
+                    || record->size() != sizeof(header) + header.keySize + header.size
+                    || memcmp(record->data() + sizeof(header), key.data(), key.size()) != 0)
+                {
+                    return nullptr;
+                }
+                return std::make_unique<Stream>(std::move(record), sizeof(header) + header.keySize, header.size);
+            }
+
+            void DiskCache::store(Entry& entry, Stream& stream) const
+            {
+                auto key = _recordKey(entry);
+                auto recordPath = _recordPath(key);
+
+                // write to a temporary file first, so concurrent readers never see partially written record
+                std::ostringstream temporaryPath;
+                temporaryPath << recordPath << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+
+                {
+                    std::ofstream file(temporaryPath.str(), std::ios_base::binary | std::ios_base::trunc);
+                    if (!file.is_open())
+                    {
+                        return;
+                    }
+
+                    RecordHeader header;
+                    memcpy(header.magic, RECORD_MAGIC, sizeof(RECORD_MAGIC));
+                    header.version = RECORD_VERSION;
+                    header.keySize = static_cast<uint32_t>(key.size());
+                    header.size = static_cast<uint32_t>(stream.size());
+                    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+                    file.write(key.data(), key.size());
+                    file.write(stream.data(), stream.size());
+
+                    if (!file)
+                    {
+                        file.close();
+                        std::remove(temporaryPath.str().c_str());
+                        return;
+                    }
+                }
+
+                if (!replace(temporaryPath.str(), recordPath))
+                {
+                    std::remove(temporaryPath.str().c_str());
+                }
+            }
+        }
+    }
+}
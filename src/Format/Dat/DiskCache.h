@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Dat
+        {
+            class Entry;
+            class Stream;
+
+            // Persistent on-disk cache of inflated DAT entries, it saves decompression but not parsing.
+            // Each entry is stored in its own file, named after hash of (dat filename, entry offset, packed and unpacked size, dat mtime).
+            // The record keeps that key and the data size, so a colliding name or a truncated record is never used.
+            // Records are mapped into memory when loaded, their data is not copied.
+            class DiskCache
+            {
+                public:
+                    DiskCache(const std::string& path);
+
+                    const std::string& path() const;
+
+                    // Creates stream from the cached record of given entry or returns nullptr if there is no valid record
+                    std::unique_ptr<Stream> load(Entry& entry) const;
+
+                    // Writes unpacked entry data to the cache. Failures are silently ignored.
+                    void store(Entry& entry, Stream& stream) const;
+
+                private:
+                    std::string _path;
+
+                    std::string _recordKey(Entry& entry) const;
+                    std::string _recordPath(const std::string& key) const;
+            };
+        }
+    }
+}
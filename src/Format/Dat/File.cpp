@@ -1,7 +1,19 @@
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#if defined(_WIN32) || defined(WIN32)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#include <cstring>
 #include "../../Exception.h"
 #include "../../Format/Txt/MapsFile.h"
 #include "../Txt/WorldmapFile.h"
 #include "../../Format/Dat/File.h"
+#include "../../Format/Dat/MappedFile.h"
 
 namespace Falltergeist
 {
@@ -14,12 +26,18 @@ namespace Falltergeist
                 _initialize();
             }
 
-            File::File(const std::string& filename)
+            File::File(const std::string& filename, bool memoryMapped)
             {
                 setFilename(filename);
+                _memoryMapped = memoryMapped;
                 _initialize();
             }
 
+            File::~File()
+            {
+                _closeNativeHandle();
+            }
+
             std::string File::filename() const
             {
                 return _filename;
@@ -39,6 +57,12 @@ namespace Falltergeist
                     throw Exception("File::_initialize() - can't open stream: " + filename());
                 }
 
+                struct stat fileStat;
+                if (stat(filename().c_str(), &fileStat) == 0)
+                {
+                    _modificationTime = static_cast<int64_t>(fileStat.st_mtime);
+                }
+
                 unsigned int FileSize;
                 unsigned int filesTreeSize;
                 unsigned int filesTotalNumber;
@@ -65,6 +89,119 @@ namespace Falltergeist
                     *this >> entry;
                     _entries.emplace(entry.filename(), std::move(entry));
                 }
+
+                if (_memoryMapped)
+                {
+                    _mapFile();
+                }
+                if (!_memoryMapped)
+                {
+                    _openNativeHandle();
+                }
+            }
+
+            void File::_openNativeHandle()
+            {
+#if defined(_WIN32) || defined(WIN32)
+                HANDLE file = CreateFileA(filename().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+                if (file == INVALID_HANDLE_VALUE)
+                {
+                    throw Exception("File::_openNativeHandle() - can't open file: " + filename());
+                }
+                _nativeHandle = reinterpret_cast<intptr_t>(file);
+#else
+                int fd = open(filename().c_str(), O_RDONLY);
+                if (fd == -1)
+                {
+                    throw Exception("File::_openNativeHandle() - can't open file: " + filename());
+                }
+                _nativeHandle = fd;
+#endif
+            }
+
+            void File::_closeNativeHandle()
+            {
+                if (_nativeHandle == -1)
+                {
+                    return;
+                }
+#if defined(_WIN32) || defined(WIN32)
+                CloseHandle(reinterpret_cast<HANDLE>(_nativeHandle));
+#else
+                close(static_cast<int>(_nativeHandle));
+#endif
+                _nativeHandle = -1;
+            }
+
+            void File::readBytesAt(char* destination, unsigned int numberOfBytes, unsigned int offset) const
+            {
+                if (_mapping)
+                {
+                    if (static_cast<size_t>(offset) + numberOfBytes > _mapping->size())
+                    {
+                        throw Exception("File::readBytesAt() - read past the end of file: " + filename());
+                    }
+                    memcpy(destination, _mapping->data() + offset, numberOfBytes);
+                    return;
+                }
+
+                size_t bytesRead = 0;
+                while (bytesRead < numberOfBytes)
+                {
+#if defined(_WIN32) || defined(WIN32)
+                    OVERLAPPED overlapped = {};
+                    uint64_t position = static_cast<uint64_t>(offset) + bytesRead;
+                    overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFF);
+                    overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+                    DWORD chunk = 0;
+                    if (!ReadFile(reinterpret_cast<HANDLE>(_nativeHandle), destination + bytesRead, static_cast<DWORD>(numberOfBytes - bytesRead), &chunk, &overlapped) || chunk == 0)
+                    {
+                        throw Exception("File::readBytesAt() - can't read from file: " + filename());
+                    }
+#else
+                    auto chunk = pread(static_cast<int>(_nativeHandle), destination + bytesRead, numberOfBytes - bytesRead, static_cast<off_t>(offset + bytesRead));
+                    if (chunk <= 0)
+                    {
+                        throw Exception("File::readBytesAt() - can't read from file: " + filename());
+                    }
+#endif
+                    bytesRead += static_cast<size_t>(chunk);
+                }
+            }
+
+            void File::_mapFile()
+            {
+                _mapping = std::make_unique<MappedFile>(filename());
+                if (_mapping->data() == nullptr)
+                {
+                    // fall back to plain stream reads
+                    _mapping.reset();
+                    _memoryMapped = false;
+                }
+            }
+
+            int64_t File::modificationTime() const
+            {
+                return _modificationTime;
+            }
+
+            bool File::memoryMapped() const
+            {
+                return _memoryMapped;
+            }
+
+            const char* File::mappedData(const Entry& entry) const
+            {
+                if (!_mapping)
+                {
+                    return nullptr;
+                }
+                auto length = entry.compressed() ? entry.packedSize() : entry.unpackedSize();
+                if (static_cast<size_t>(entry.dataOffset()) + length > _mapping->size())
+                {
+                    throw Exception("File::mappedData() - entry is out of archive bounds: " + entry.filename());
+                }
+                return _mapping->data() + entry.dataOffset();
             }
 
             File* File::setPosition(unsigned int position)
@@ -101,6 +238,11 @@ namespace Falltergeist
                 return this;
             }
 
+            std::unordered_map<std::string, Entry>& File::entries()
+            {
+                return _entries;
+            }
+
             Entry* File::entry(const std::string& filename)
             {
                 auto entryIt = _entries.find(filename);
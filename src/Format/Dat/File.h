@@ -13,11 +13,17 @@ namespace Falltergeist
     {
         namespace Dat
         {
+            class MappedFile;
+
             class File
             {
                 public:
                     File();
-                    File(const std::string& pathToFile);
+                    File(const std::string& pathToFile, bool memoryMapped = false);
+                    ~File();
+
+                    File(const File&) = delete;
+                    File& operator=(const File&) = delete;
 
                     std::string filename() const;
                     File* setFilename(const std::string& filename);
@@ -25,7 +31,22 @@ namespace Falltergeist
                     // an pointer to an entry with given name or nullptr if no such entry exists
                     Entry* entry(const std::string& filename);
 
+                    // all entries of the archive, keyed by normalized file name
+                    std::unordered_map<std::string, Entry>& entries();
+
+                    // last modification time of the archive file, seconds since epoch
+                    int64_t modificationTime() const;
+
+                    // true if the whole archive is mapped into memory
+                    bool memoryMapped() const;
+
+                    // a pointer to raw (possibly packed) entry data inside the mapped archive or nullptr if archive is not mapped
+                    const char* mappedData(const Entry& entry) const;
+
                     File* readBytes(char* destination, unsigned int numberOfBytes);
+
+                    // positional read which does not touch the shared stream position, safe to call from several threads at once
+                    void readBytesAt(char* destination, unsigned int numberOfBytes, unsigned int offset) const;
                     File* skipBytes(unsigned int numberOfBytes);
                     File* setPosition(unsigned int position);
                     unsigned int position();
@@ -43,7 +64,15 @@ namespace Falltergeist
                     std::unordered_map<std::string, Dat::Entry> _entries;
                     std::ifstream _stream;
                     std::string _filename;
+                    int64_t _modificationTime = 0;
+                    bool _memoryMapped = false;
+                    std::unique_ptr<MappedFile> _mapping;
+                    // native file descriptor (or HANDLE on Windows) used for positional reads
+                    intptr_t _nativeHandle = -1;
                     void _initialize();
+                    void _mapFile();
+                    void _openNativeHandle();
+                    void _closeNativeHandle();
             };
         }
     }
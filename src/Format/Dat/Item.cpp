@@ -21,6 +21,17 @@ namespace Falltergeist
             {
                 return _filename;
             }
+
+            Item& Item::setSourceSize(size_t value)
+            {
+                _sourceSize = value;
+                return *this;
+            }
+
+            size_t Item::memoryUsage() const
+            {
+                return _sourceSize;
+            }
         }
     }
 }
@@ -20,8 +20,15 @@ namespace Falltergeist
                     Item& setFilename(const std::string& filename);
                     std::string filename();
 
+                    // size of the data item was loaded from
+                    Item& setSourceSize(size_t value);
+
+                    // approximate number of bytes occupied by the item, including data decoded on demand
+                    virtual size_t memoryUsage() const;
+
                 protected:
                     std::string _filename;
+                    size_t _sourceSize = 0;
             };
         }
     }
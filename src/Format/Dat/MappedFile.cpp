@@ -0,0 +1,88 @@
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#if defined(_WIN32) || defined(WIN32)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+#include "../../Format/Dat/MappedFile.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Dat
+        {
+            MappedFile::MappedFile(const std::string& path)
+            {
+#if defined(_WIN32) || defined(WIN32)
+                HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+                if (file != INVALID_HANDLE_VALUE)
+                {
+                    LARGE_INTEGER fileSize;
+                    HANDLE mapping = NULL;
+                    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+                    {
+                        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+                    }
+                    if (mapping != NULL)
+                    {
+                        _data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                        if (_data != nullptr)
+                        {
+                            _size = static_cast<size_t>(fileSize.QuadPart);
+                        }
+                        // the view keeps the mapping alive after handles are closed
+                        CloseHandle(mapping);
+                    }
+                    CloseHandle(file);
+                }
+#else
+                int fd = open(path.c_str(), O_RDONLY);
+                if (fd != -1)
+                {
+                    struct stat fileStat;
+                    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+                    {
+                        void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+                        if (data != MAP_FAILED)
+                        {
+                            _data = static_cast<const char*>(data);
+                            _size = static_cast<size_t>(fileStat.st_size);
+                        }
+                    }
+                    // the mapping stays valid after descriptor is closed
+                    close(fd);
+                }
+#endif
+            }
+
+            MappedFile::~MappedFile()
+            {
+                if (_data == nullptr)
+                {
+                    return;
+                }
+#if defined(_WIN32) || defined(WIN32)
+                UnmapViewOfFile(_data);
+#else
+                munmap(const_cast<char*>(_data), _size);
+#endif
+            }
+
+            const char* MappedFile::data() const
+            {
+                return _data;
+            }
+
+            size_t MappedFile::size() const
+            {
+                return _size;
+            }
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Dat
+        {
+            // Read-only memory mapping of a whole file
+            class MappedFile
+            {
+                public:
+                    // Maps given file, data() is nullptr if the file can't be opened, is empty or can't be mapped
+                    explicit MappedFile(const std::string& path);
+                    ~MappedFile();
+
+                    MappedFile(const MappedFile&) = delete;
+                    MappedFile& operator=(const MappedFile&) = delete;
+
+                    const char* data() const;
+                    size_t size() const;
+
+                private:
+                    const char* _data = nullptr;
+                    size_t _size = 0;
+            };
+        }
+    }
+}
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include "../../Format/Dat/Entry.h"
 #include "../../Format/Dat/File.h"
+#include "../../Format/Dat/MappedFile.h"
 #include "zlib.h"
 
 namespace Falltergeist
@@ -13,18 +14,26 @@ namespace Falltergeist
         {
             Stream::Stream(Stream&& other) :
                     _buffer(std::move(other._buffer)),
+                    _mapping(std::move(other._mapping)),
+                    _data(other._data),
+                    _size(other._size),
                     _endianness(other._endianness)
             {
-                auto cBuf = _buffer.data();
-                setg(cBuf, cBuf, cBuf + _buffer.size());
+                other._data = nullptr;
+                other._size = 0;
+                setg(_data, _data, _data + _size);
             }
 
             Stream& Stream::operator= (Stream&& other)
             {
                 _buffer = std::move(other._buffer);
+                _mapping = std::move(other._mapping);
+                _data = other._data;
+                _size = other._size;
                 _endianness = other._endianness;
-                auto cBuf = _buffer.data();
-                setg(cBuf, cBuf, cBuf + _buffer.size());
+                other._data = nullptr;
+                other._size = 0;
+                setg(_data, _data, _data + _size);
                 return *this;
             }
 
@@ -35,49 +44,82 @@ namespace Falltergeist
                 stream.seekg(0, std::ios::beg);
 
                 _buffer.resize(size);
-                auto cBuf = _buffer.data();
-                stream.read(cBuf, size);
-                setg(cBuf, cBuf, cBuf + size);
+                _data = _buffer.data();
+                _size = size;
+                stream.read(_data, size);
+                setg(_data, _data, _data + size);
+            }
+
+            Stream::Stream(Base::Buffer<char>&& buffer) : _buffer(std::move(buffer))
+            {
+                _data = _buffer.data();
+                _size = _buffer.size();
+                setg(_data, _data, _data + _size);
+            }
+
+            Stream::Stream(std::shared_ptr<const MappedFile> mapping, size_t offset, size_t size) : _mapping(std::move(mapping))
+            {
+                // the view is only read, like views of mapped archives
+                _data = const_cast<char*>(_mapping->data()) + offset;
+                _size = size;
+                setg(_data, _data, _data + _size);
             }
 
             Stream::Stream(Entry& datFileEntry)
             {
                 auto size = datFileEntry.unpackedSize();
-                _buffer.resize(size);
-                auto cBuf = _buffer.data();
-
                 auto datFile = datFileEntry.datFile();
-                unsigned int oldPos = datFile->position();
-                datFile->setPosition(datFileEntry.dataOffset());
 
+                if (datFile->memoryMapped()) {
+                    // get area is never written to, so it is safe to point it right into read-only mapping
+                    auto mappedData = const_cast<char*>(datFile->mappedData(datFileEntry));
+                    if (datFileEntry.compressed()) {
+                        _buffer.resize(size);
+                        _data = _buffer.data();
+                        _size = size;
+                        _inflate(mappedData, datFileEntry.packedSize());
+                    } else {
+                        _data = mappedData;
+                        _size = size;
+                    }
+                    setg(_data, _data, _data + _size);
+                    return;
+                }
+
+                _buffer.resize(size);
+                _data = _buffer.data();
+                _size = size;
+
+                // positional reads keep this constructor safe to be used from worker threads
                 if (datFileEntry.compressed()) {
                     Base::Buffer<char> packedData(datFileEntry.packedSize());
-                    datFile->readBytes(packedData.data(), datFileEntry.packedSize());
-
-                    // unpacking
-                    z_stream zStream;
-                    zStream.total_in = datFileEntry.packedSize();
-                    zStream.avail_in = datFileEntry.packedSize();
-                    zStream.next_in = reinterpret_cast<unsigned char*>(packedData.data());
-                    zStream.total_out = zStream.avail_out = static_cast<uint32_t>(_buffer.size());
-                    zStream.next_out = reinterpret_cast<unsigned char*>(_buffer.data());
-                    zStream.zalloc = Z_NULL;
-                    zStream.zfree = Z_NULL;
-                    zStream.opaque = Z_NULL;
-                    inflateInit(&zStream);            // zlib function
-                    inflate(&zStream, Z_FINISH);      // zlib function
-                    inflateEnd(&zStream);             // zlib function
+                    datFile->readBytesAt(packedData.data(), datFileEntry.packedSize(), datFileEntry.dataOffset());
+                    _inflate(packedData.data(), datFileEntry.packedSize());
                 } else {
-                    datFile->readBytes(cBuf, size);
+                    datFile->readBytesAt(_data, size, datFileEntry.dataOffset());
                 }
 
-                datFile->setPosition(oldPos);
-                setg(cBuf, cBuf, cBuf + size);
+                setg(_data, _data, _data + _size);
+            }
+
+            void Stream::_inflate(char* packedData, size_t packedSize)
+            {
+                z_stream zStream;
+                zStream.total_in = zStream.avail_in = static_cast<uint32_t>(packedSize);
+                zStream.next_in = reinterpret_cast<unsigned char*>(packedData);
+                zStream.total_out = zStream.avail_out = static_cast<uint32_t>(_size);
+                zStream.next_out = reinterpret_cast<unsigned char*>(_data);
+                zStream.zalloc = Z_NULL;
+                zStream.zfree = Z_NULL;
+                zStream.opaque = Z_NULL;
+                inflateInit(&zStream);            // zlib function
+                inflate(&zStream, Z_FINISH);      // zlib function
+                inflateEnd(&zStream);             // zlib function
             }
 
             size_t Stream::size() const
             {
-                return _buffer.size();
+                return _size;
             }
 
             std::streambuf::int_type Stream::underflow()
@@ -91,8 +133,7 @@ namespace Falltergeist
 
             Stream& Stream::setPosition(size_t pos)
             {
-                auto cBuf = _buffer.data();
-                setg(cBuf, cBuf + pos, cBuf + _buffer.size());
+                setg(_data, _data + pos, _data + _size);
                 return *this;
             }
 
@@ -103,8 +144,7 @@ namespace Falltergeist
 
             Stream& Stream::skipBytes(size_t numberOfBytes)
             {
-                auto cBuf = _buffer.data();
-                setg(cBuf, gptr() + numberOfBytes, cBuf + _buffer.size());
+                setg(_data, gptr() + numberOfBytes, _data + _size);
                 return *this;
             }
 
@@ -167,6 +207,16 @@ namespace Falltergeist
                 _endianness = value;
             }
 
+            const char* Stream::data() const
+            {
+                return _data;
+            }
+
+            size_t Stream::ownedSize() const
+            {
+                return _buffer.size();
+            }
+
             size_t Stream::bytesRemains()
             {
                 return size() - position();
@@ -13,6 +13,7 @@ namespace Falltergeist
         namespace Dat
         {
             class Entry;
+            class MappedFile;
 
             // An abstract data stream for binary resource files loaded from either Dat file or a file system
             class Stream: public std::streambuf
@@ -20,6 +21,9 @@ namespace Falltergeist
                 public:
                     Stream(std::ifstream& stream);
                     Stream(Dat::Entry& datFileEntry);
+                    Stream(Base::Buffer<char>&& buffer);
+                    // A view of size bytes at offset of the mapped file, the stream keeps the mapping alive
+                    Stream(std::shared_ptr<const MappedFile> mapping, size_t offset, size_t size);
 
                     Stream(Stream&& other);
                     Stream(const Stream&) = delete;
@@ -36,6 +40,11 @@ namespace Falltergeist
 
                     size_t bytesRemains();
 
+                    // pointer to the beginning of stream data
+                    const char* data() const;
+                    // number of bytes allocated by the stream, zero when it's a view into memory mapped file
+                    size_t ownedSize() const;
+
                     ENDIANNESS endianness();
                     void setEndianness(ENDIANNESS value);
 
@@ -54,8 +63,16 @@ namespace Falltergeist
                     Stream& operator>>(int8_t &value);
 
                 private:
+                    // owned data; stays empty when stream is a view into memory mapped archive
                     Base::Buffer<char> _buffer;
+                    // mapped file of a view which is not owned by its archive
+                    std::shared_ptr<const MappedFile> _mapping;
+                    char* _data = nullptr;
+                    size_t _size = 0;
                     ENDIANNESS _endianness = ENDIANNESS::BIG;
+
+                    // unpacks zlib-compressed data into preallocated _data
+                    void _inflate(char* packedData, size_t packedSize);
             };
         }
     }
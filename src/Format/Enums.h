@@ -99,6 +99,31 @@ enum class PROCEDURE_FLAG
     INLINE      = 0x40
 };
 
+// Procedures called by the engine, see Format::Int::File::procedure(PROCEDURE)
+enum class PROCEDURE : uint32_t
+{
+    START = 0,
+    SPATIAL,
+    DESCRIPTION,
+    PICKUP,
+    DROP,
+    USE,
+    USE_OBJ_ON,
+    USE_SKILL_ON,
+    TALK,
+    CRITTER,
+    COMBAT,
+    DAMAGE,
+    MAP_ENTER,
+    MAP_EXIT,
+    CREATE,
+    DESTROY,
+    LOOK_AT,
+    TIMED_EVENT,
+    MAP_UPDATE,
+    COUNT
+};
+
 enum class OBJECT_TYPE
 {
     ITEM = 0,
@@ -1,4 +1,10 @@
 ﻿#include <algorithm>
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define FRM_SSE2
+#endif
 #include "../Enums.h"
 #include "../Dat/Stream.h"
 #include "../Frm/File.h"
@@ -10,23 +16,81 @@ namespace Falltergeist
     {
         namespace Frm
         {
-            File::File(Dat::Stream&& stream)
+            namespace
             {
-                stream.setPosition(0);
+                // Colors of one row of palette indexes, colors are looked up in the table of all 256 colors
+                void expandRow(const uint8_t* indexes, unsigned int count, const uint32_t* colors, uint32_t* rgba)
+                {
+                    unsigned int i = 0;
+#if defined(__AVX2__)
+                    // 8 indexes are widened to 32 bits and their colors are gathered at once
+                    const int* table = reinterpret_cast<const int*>(colors);
+                    for (; i + 8 <= count; i += 8)
+                    {
+                        __m256i offsets = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(indexes + i)));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(rgba + i), _mm256_i32gather_epi32(table, offsets, 4));
+                    }
+#endif
+                    // the rest of the row, or the whole row without AVX2
+                    for (; i != count; ++i)
+                    {
+                        rgba[i] = colors[indexes[i]];
+                    }
+                }
+
+                // Marks opaque pixels of one row of palette indexes, index 0 is the only transparent color of palettes
+                void opacityRow(const uint8_t* indexes, unsigned int count, Base::Bitmask& mask, unsigned int x, unsigned int y)
+                {
+                    unsigned int i = 0;
+#if defined(__AVX2__)
+                    const __m256i transparent = _mm256_setzero_si256();
+                    for (; i + 32 <= count; i += 32)
+                    {
+                        __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indexes + i));
+                        uint32_t bits = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(pixels, transparent)));
+                        mask.setBits(x + i, y, bits, 32);
+                    }
+#elif defined(FRM_SSE2)
+                    const __m128i transparent = _mm_setzero_si128();
+                    for (; i + 16 <= count; i += 16)
+                    {
+                        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indexes + i));
+                        uint32_t bits = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(pixels, transparent)));
+                        mask.setBits(x + i, y, bits, 16);
+                    }
+#endif
+                    // the rest of the row, or the whole row without SIMD
+                    while (i != count)
+                    {
+                        unsigned int length = std::min(count - i, 64u);
+                        uint64_t bits = 0;
+                        for (unsigned int j = 0; j != length; ++j)
+                        {
+                            bits |= uint64_t(indexes[i + j] != 0) << j;
+                        }
+                        mask.setBits(x + i, y, bits, length);
+                        i += length;
+                    }
+                }
+            }
 
-                _version = stream.uint32();
-                _framesPerSecond = stream.uint16();
-                _actionFrame = stream.uint16();
-                _framesPerDirection = stream.uint16();
+            File::File(Dat::Stream&& stream) : _stream(std::move(stream))
+            {
+                _stream.setPosition(0);
+
+                _version = _stream.uint32();
+                _framesPerSecond = _stream.uint16();
+                _actionFrame = _stream.uint16();
+                _framesPerDirection = _stream.uint16();
 
                 uint16_t shiftX[6];
                 uint16_t shiftY[6];
                 uint32_t dataOffset[6];
-                for (unsigned int i = 0; i != 6; ++i) shiftX[i] = stream.uint16();
-                for (unsigned int i = 0; i != 6; ++i) shiftY[i] = stream.uint16();
+                for (unsigned int i = 0; i != 6; ++i) shiftX[i] = _stream.uint16();
+                for (unsigned int i = 0; i != 6; ++i) shiftY[i] = _stream.uint16();
                 for (unsigned int i = 0; i != 6; ++i)
                 {
-                    dataOffset[i] = stream.uint32();
+                    dataOffset[i] = _stream.uint32();
                     if (i > 0 && dataOffset[i-1] == dataOffset[i])
                     {
                         continue;
@@ -43,26 +107,31 @@ namespace Falltergeist
                 for (auto& direction : _directions)
                 {
                     // jump to frames data at frames area
-                    stream.setPosition(direction.dataOffset() + 62);
+                    _stream.setPosition(direction.dataOffset() + 62);
 
                     // read all frames
                     for (unsigned i = 0; i != _framesPerDirection; ++i)
                     {
-                        uint16_t width = stream.uint16();
-                        uint16_t height = stream.uint16();
+                        uint16_t width = _stream.uint16();
+                        uint16_t height = _stream.uint16();
 
                         direction.frames().emplace_back(width, height);
                         auto& frame = direction.frames().back();
 
                         // Number of pixels for this frame
                         // We don't need this, because we already have width*height
-                        stream.uint32();
+                        _stream.uint32();
 
-                        frame.setOffsetX(stream.int16());
-                        frame.setOffsetY(stream.int16());
+                        frame.setOffsetX(_stream.int16());
+                        frame.setOffsetY(_stream.int16());
 
-                        // Pixels data
-                        stream.readBytes(frame.data(), frame.width() * frame.height());
+                        // Pixels data stays in the stream until some image is built
+                        size_t size = frame.width() * frame.height();
+                        if (_stream.position() + size <= _stream.size())
+                        {
+                            frame.setData(reinterpret_cast<const uint8_t*>(_stream.data()) + _stream.position());
+                        }
+                        _stream.skipBytes(std::min(size, _stream.bytesRemains()));
                     }
                 }
             }
@@ -110,6 +179,18 @@ namespace Falltergeist
                 return height;
             }
 
+            uint16_t File::width(unsigned int direction) const
+            {
+                if (direction >= _directions.size()) direction = 0;
+                return _directions.at(direction).width();
+            }
+
+            uint16_t File::height(unsigned int direction) const
+            {
+                if (direction >= _directions.size()) direction = 0;
+                return _directions.at(direction).height();
+            }
+
             uint32_t* File::rgba(Pal::File* palFile)
             {
                 // TODO: this looks like a getter, which in fact creates _rgba.
@@ -117,59 +198,102 @@ namespace Falltergeist
                 // This is clearly bad semantics
                 if (!_rgba.empty()) return _rgba.data();
 
-                _rgba.resize(width()*height());
-
                 uint16_t w = width();
+                _rgba.resize(w*height());
 
-                size_t positionY = 1;
-                for (auto& direction : _directions)
+                uint32_t colors[256];
+                for (unsigned int i = 0; i != 256; ++i)
                 {
-                    size_t positionX = 1;
-                    for (auto& frame : direction.frames())
+                    colors[i] = *palFile->color(i);
+                }
+
+                _layout(0, _directions.size(), [this, w, &colors](const Frame& frame, unsigned int x, unsigned int y)
+                {
+                    for (uint16_t row = 0; row != frame.height(); ++row)
                     {
-                        // TODO: more efficient way to generate texture?
-                        for (uint16_t y = 0; y != frame.height(); ++y)
-                        {
-                            for (uint16_t x = 0; x != frame.width(); ++x)
-                            {
-                                _rgba[((y + positionY)*w) + x + positionX] = *palFile->color(frame.index(x, y));
-                            }
-                        }
-                        positionX += frame.width() + 2;
+                        expandRow(frame.data() + row * frame.width(), frame.width(), colors, &_rgba[((y + row)*w) + x]);
                     }
-                    positionY += direction.height();
-                }
+                });
                 return _rgba.data();
             }
 
-            std::vector<bool>& File::mask(Pal::File* palFile)
+            std::vector<uint8_t> File::indexes() const
+            {
+                return _indexes(0, _directions.size(), width(), height());
+            }
+
+            std::vector<uint8_t> File::indexes(unsigned int direction) const
+            {
+                if (direction >= _directions.size()) direction = 0;
+                return _indexes(direction, direction + 1, width(direction), height(direction));
+            }
+
+            const Base::Bitmask& File::mask()
             {
                 if (!_mask.empty()) return _mask;
 
-                uint16_t w = width();
-                uint16_t h = height();
+                _mask = _opacity(0, _directions.size(), width(), height());
+                return _mask;
+            }
 
-                _mask.resize(w*h, true);
+            Base::Bitmask File::mask(unsigned int direction) const
+            {
+                if (direction >= _directions.size()) direction = 0;
+                return _opacity(direction, direction + 1, width(direction), height(direction));
+            }
 
-                unsigned positionY = 1;
-                for (auto& direction : _directions)
+            void File::_layout(size_t first, size_t last, const std::function<void(const Frame&, unsigned int, unsigned int)>& visitor) const
+            {
+                unsigned int positionY = 1;
+                for (size_t i = first; i != last; ++i)
                 {
-                    unsigned positionX = 1;
+                    auto& direction = _directions.at(i);
+                    unsigned int positionX = 1;
                     for (auto& frame : direction.frames())
                     {
-                        // TODO: optimize
-                        for (unsigned y = 0; y != frame.height(); ++y)
+                        // frames cut off by the end of file stay transparent
+                        if (frame.data())
                         {
-                            for (unsigned x = 0; x != frame.width(); ++x)
-                            {
-                                _mask[((y + positionY)*w) + x + positionX] = (palFile->color(frame.index(x, y))->alpha() > 0);
-                            }
+                            visitor(frame, positionX, positionY);
                         }
                         positionX += frame.width() + 2;
                     }
                     positionY += direction.height();
                 }
-                return _mask;
+            }
+
+            std::vector<uint8_t> File::_indexes(size_t first, size_t last, uint16_t width, uint16_t height) const
+            {
+                std::vector<uint8_t> indexes(static_cast<size_t>(width) * height, 0);
+                _layout(first, last, [&indexes, width](const Frame& frame, unsigned int x, unsigned int y)
+                {
+                    // rows of frame are copied as is, palette is applied on GPU
+                    for (uint16_t row = 0; row != frame.height(); ++row)
+                    {
+                        const uint8_t* pixels = frame.data() + row * frame.width();
+                        std::copy(pixels, pixels + frame.width(), indexes.begin() + ((y + row)*width) + x);
+                    }
+                });
+                return indexes;
+            }
+
+            Base::Bitmask File::_opacity(size_t first, size_t last, uint16_t width, uint16_t height) const
+            {
+                Base::Bitmask mask(width, height);
+                _layout(first, last, [&mask](const Frame& frame, unsigned int x, unsigned int y)
+                {
+                    for (uint16_t row = 0; row != frame.height(); ++row)
+                    {
+                        opacityRow(frame.data() + row * frame.width(), frame.width(), mask, x, y + row);
+                    }
+                });
+                return mask;
+            }
+
+            size_t File::memoryUsage() const
+            {
+                // frames only point into the stream
+                return _stream.ownedSize() + _rgba.size() * sizeof(uint32_t) + _mask.memoryUsage();
             }
 
             int16_t File::offsetX(unsigned int direction, unsigned int frame) const
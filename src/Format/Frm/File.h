@@ -1,8 +1,11 @@
 ﻿#pragma once
 
+#include <functional>
 #include <map>
 #include <vector>
+#include "../../Base/Bitmask.h"
 #include "../Dat/Item.h"
+#include "../Dat/Stream.h"
 #include "../Frm/Direction.h"
 #include "../Enums.h"
 
@@ -10,10 +13,6 @@ namespace Falltergeist
 {
     namespace Format
     {
-        namespace Dat
-        {
-            class Stream;
-        }
         namespace Pal
         {
             class File;
@@ -22,6 +21,8 @@ namespace Falltergeist
         {
             class Direction;
 
+            // Frames refer to pixel data of the file instead of copying it,
+            // so pixels are read only when images of directions are built.
             class File : public Dat::Item
             {
                 public:
@@ -40,11 +41,23 @@ namespace Falltergeist
                     int16_t offsetY(unsigned int direction = 0, unsigned int frame = 0) const;
 
                     uint32_t* rgba(Pal::File* palFile);
-                    std::vector<bool>& mask(Pal::File* palFile);
+                    // Palette indexes of all frames in the same layout as rgba(), not cached
+                    std::vector<uint8_t> indexes() const;
+                    // Opaque pixels of all frames in the same layout as rgba()
+                    const Base::Bitmask& mask();
+
+                    // Image of one direction, frames are placed the same way as in a row of rgba()
+                    uint16_t width(unsigned int direction) const;
+                    uint16_t height(unsigned int direction) const;
+                    std::vector<uint8_t> indexes(unsigned int direction) const;
+                    Base::Bitmask mask(unsigned int direction) const;
 
                     const std::vector<Direction>& directions() const;
 
+                    size_t memoryUsage() const override;
+
                 protected:
+                    Dat::Stream _stream;
                     std::vector<uint32_t> _rgba;
                     uint32_t _version = 0;
                     uint16_t _framesPerSecond = 0;
@@ -53,7 +66,12 @@ namespace Falltergeist
                     bool _animatedPalette = false;
 
                     std::vector<Direction> _directions;
-                    std::vector<bool> _mask;
+                    Base::Bitmask _mask;
+
+                    // Calls visitor with every frame of directions [first, last) and position of its top left pixel in the image
+                    void _layout(size_t first, size_t last, const std::function<void(const Frame&, unsigned int, unsigned int)>& visitor) const;
+                    std::vector<uint8_t> _indexes(size_t first, size_t last, uint16_t width, uint16_t height) const;
+                    Base::Bitmask _opacity(size_t first, size_t last, uint16_t width, uint16_t height) const;
             };
         }
     }
@@ -6,7 +6,7 @@ namespace Falltergeist
     {
         namespace Frm
         {
-            Frame::Frame(uint16_t width, uint16_t height) : _indexes(width * height, 0)
+            Frame::Frame(uint16_t width, uint16_t height)
             {
                 _width = width;
                 _height = height;
@@ -44,14 +44,19 @@ namespace Falltergeist
 
             uint8_t Frame::index(uint16_t x, uint16_t y) const
             {
-                if (x >= _width || y >= _height) return 0;
+                if (x >= _width || y >= _height || !_data) return 0;
 
-                return _indexes.at(_width*y + x);
+                return _data[_width*y + x];
             }
 
-            uint8_t* Frame::data()
+            const uint8_t* Frame::data() const
             {
-                return _indexes.data();
+                return _data;
+            }
+
+            void Frame::setData(const uint8_t* data)
+            {
+                _data = data;
             }
         }
     }
@@ -1,7 +1,6 @@
 ﻿#pragma once
 
 #include <cstdint>
-#include <vector>
 
 namespace Falltergeist
 {
@@ -31,14 +30,17 @@ namespace Falltergeist
 
                     uint8_t index(uint16_t x, uint16_t y) const;
 
-                    uint8_t* data();
+                    // Palette indexes row by row. They are not copied, the pointer refers to data of the file,
+                    // nullptr if the file ends before the frame does.
+                    const uint8_t* data() const;
+                    void setData(const uint8_t* data);
 
                 protected:
                     uint16_t _width = 0;
                     uint16_t _height = 0;
                     int16_t _offsetX = 0;
                     int16_t _offsetY = 0;
-                    std::vector<uint8_t> _indexes;
+                    const uint8_t* _data = nullptr;
             };
         }
     }
@@ -1,4 +1,5 @@
-﻿#include "../../Format/Dat/Stream.h"
+﻿#include <algorithm>
+#include "../../Format/Dat/Stream.h"
 #include "../../Format/Int/File.h"
 #include "../../Exception.h"
 
@@ -33,62 +34,194 @@ namespace Falltergeist
                     procedure.setArgumentsCounter(_stream.uint32());
                 }
 
-                // Identifiers table
-                uint32_t tableSize = _stream.uint32();
-                unsigned j = 0;
+                // Identifiers table, names of functions and variables
+                _readConstantPool(_identifiers, _stream.uint32());
+
+                _stream.skipBytes(4); // signature 0xFFFFFFFF
+
+                for (unsigned i = 0; i != procedureNameOffsets.size(); ++i)
+                {
+                    _procedures.at(i).setName(_identifiers.at(procedureNameOffsets.at(i)));
+                }
+
+                _standardProcedures.fill(-1);
+                for (unsigned i = 0; i != _standardProcedures.size(); ++i)
+                {
+                    auto name = procedureName(static_cast<PROCEDURE>(i));
+                    for (unsigned k = 0; k != _procedures.size(); ++k)
+                    {
+                        if (_procedures[k].name() == name)
+                        {
+                            _standardProcedures[i] = static_cast<int32_t>(k);
+                            break;
+                        }
+                    }
+                }
+
+                // STRINGS TABLE
+                uint32_t stringsTable = _stream.uint32();
+
+                if (stringsTable != 0xFFFFFFFF)
+                {
+                    _readConstantPool(_strings, stringsTable);
+                }
+
+                // Startup code in the header and procedure bodies after the tables
+                uint32_t codeOffset = _stream.position();
+                _decodeInstructions(0, 42);
+                _decodeInstructions(codeOffset, _stream.size());
+            }
+
+            void File::_readConstantPool(ConstantPool& pool, uint32_t tableSize)
+            {
+                // offsets are counted from the table size field, which takes 4 bytes
+                pool.indices.assign(tableSize + 4, -1);
+                uint32_t j = 0;
                 while (j < tableSize)
                 {
-                    uint16_t nameLength = _stream.uint16();
+                    uint16_t length = _stream.uint16();
                     j += 2;
-
-                    uint32_t nameOffset = j + 4;
-                    std::string name;
-                    for (unsigned i = 0; i != nameLength; ++i, ++j)
+                    uint32_t offset = j + 4;
+                    std::string value;
+                    for (unsigned i = 0; i != length; ++i, ++j)
                     {
                         uint8_t ch = _stream.uint8();
-                        if (ch != 0) name.push_back(ch);
+                        if (ch != 0) value.push_back(ch);
                     }
+                    if (offset < pool.indices.size())
+                    {
+                        pool.indices[offset] = static_cast<int32_t>(pool.values.size());
+                    }
+                    pool.values.push_back(std::move(value));
+                }
+            }
 
-                    _identifiers.insert(std::make_pair(nameOffset, name)); // names of functions and variables
+            const std::string& File::ConstantPool::at(uint32_t offset) const
+            {
+                if (offset >= indices.size() || indices[offset] < 0)
+                {
+                    throw Exception("Int::File - no constant at offset " + std::to_string(offset));
                 }
+                return values[indices[offset]];
+            }
 
-                _stream.skipBytes(4); // signature 0xFFFFFFFF
+            uint32_t File::ConstantPool::idAt(uint32_t offset) const
+            {
+                if (offset >= indices.size() || indices[offset] < 0 || ids.empty())
+                {
+                    throw Exception("Int::File - no constant id at offset " + std::to_string(offset));
+                }
+                return ids[indices[offset]];
+            }
 
-                for (unsigned i = 0; i != procedureNameOffsets.size(); ++i)
+            void File::_decodeInstructions(uint32_t from, uint32_t to)
+            {
+                uint32_t offset = from;
+                while (offset + 2 <= to)
                 {
-                    _procedures.at(i).setName(_identifiers.at(procedureNameOffsets.at(i)));
+                    auto instruction = decodeInstruction(offset);
+                    uint32_t next = offset + (_hasOperand(instruction.opcode) ? 6 : 2);
+                    if (next > to)
+                    {
+                        break;
+                    }
+                    _instructions.push_back(instruction);
+                    offset = next;
                 }
+            }
 
-                // STRINGS TABLE
-                uint32_t stringsTable = _stream.uint32();
+            Instruction File::decodeInstruction(uint32_t offset)
+            {
+                Instruction instruction;
+                instruction.offset = offset;
+                _stream.setPosition(offset);
+                instruction.opcode = _stream.uint16();
+                instruction.operandKind = OperandKind::NONE;
+                instruction.operand = 0;
+                if (!_hasOperand(instruction.opcode) || offset + 6 > _stream.size())
+                {
+                    return instruction;
+                }
 
-                if (stringsTable != 0xFFFFFFFF)
+                instruction.operand = _stream.uint32();
+                switch (instruction.opcode)
                 {
-                    uint32_t j = 0;
-                    while (j < stringsTable)
+                    case 0xC001:
+                        instruction.operandKind = OperandKind::INTEGER;
+                        break;
+                    case 0xA001:
+                        instruction.operandKind = OperandKind::FLOAT;
+                        break;
+                    default:
                     {
-                        uint16_t length = _stream.uint16();
-                        j += 2;
-                        uint32_t nameOffset = j + 4;
-                        std::string name;
-                        for (unsigned i = 0; i != length; ++i, ++j)
-                        {
-                            uint8_t ch = _stream.uint8();
-                            if (ch != 0) name.push_back(ch);
-                        }
-                        _strings.insert(std::make_pair(nameOffset, name));
+                        // exported variables are referred to by names, which are stored in identifiers table
+                        uint16_t nextOpcode = offset + 8 <= _stream.size() ? _stream.uint16() : 0;
+                        bool exported = nextOpcode == 0x8014 || nextOpcode == 0x8015 || nextOpcode == 0x8016;
+                        instruction.operandKind = exported ? OperandKind::IDENTIFIER : OperandKind::STRING;
+                        break;
+                    }
+                }
+                return instruction;
+            }
+
+            bool File::_hasOperand(uint16_t opcode)
+            {
+                // push opcodes are followed by a 4-byte value
+                return opcode == 0x9001 || opcode == 0xA001 || opcode == 0xC001;
+            }
+
+            const std::vector<Instruction>& File::instructions() const
+            {
+                return _instructions;
+            }
+
+            size_t File::instructionIndex(uint32_t offset) const
+            {
+                auto it = std::lower_bound(_instructions.begin(), _instructions.end(), offset, [](const Instruction& instruction, uint32_t value) {
+                    return instruction.offset < value;
+                });
+                if (it == _instructions.end() || it->offset != offset)
+                {
+                    return _instructions.size();
+                }
+                return static_cast<size_t>(it - _instructions.begin());
+            }
+
+            const std::string& File::identifier(uint32_t offset) const
+            {
+                return _identifiers.at(offset);
+            }
+
+            const std::string& File::string(uint32_t offset) const
+            {
+                return _strings.at(offset);
+            }
+
+            void File::internConstants(const std::function<uint32_t(const std::string&)>& intern)
+            {
+                if (_constantsInterned)
+                {
+                    return;
+                }
+                for (auto pool : {&_identifiers, &_strings})
+                {
+                    pool->ids.reserve(pool->values.size());
+                    for (auto& value : pool->values)
+                    {
+                        pool->ids.push_back(intern(value));
                     }
                 }
+                _constantsInterned = true;
             }
 
-            const std::map<unsigned int, std::string>& File::identifiers() const
+            uint32_t File::identifierId(uint32_t offset) const
             {
-                return _identifiers;
+                return _identifiers.idAt(offset);
             }
 
-            const std::map<unsigned int, std::string>& File::strings() const
+            uint32_t File::stringId(uint32_t offset) const
             {
-                return _strings;
+                return _strings.idAt(offset);
             }
 
             size_t File::position() const
@@ -132,6 +265,39 @@ namespace Falltergeist
                 }
                 return nullptr;
             }
+
+            const Procedure* File::procedure(PROCEDURE slot) const
+            {
+                auto index = _standardProcedures.at(static_cast<size_t>(slot));
+                return index < 0 ? nullptr : &_procedures[index];
+            }
+
+            const char* File::procedureName(PROCEDURE slot)
+            {
+                static const char* names[] = {
+                    "start",
+                    "spatial_p_proc",
+                    "description_p_proc",
+                    "pickup_p_proc",
+                    "drop_p_proc",
+                    "use_p_proc",
+                    "use_obj_on_p_proc",
+                    "use_skill_on_p_proc",
+                    "talk_p_proc",
+                    "critter_p_proc",
+                    "combat_p_proc",
+                    "damage_p_proc",
+                    "map_enter_p_proc",
+                    "map_exit_p_proc",
+                    "create_p_proc",
+                    "destroy_p_proc",
+                    "look_at_p_proc",
+                    "timed_event_p_proc",
+                    "map_update_p_proc"
+                };
+                static_assert(sizeof(names) / sizeof(names[0]) == static_cast<size_t>(PROCEDURE::COUNT), "Names of all standard procedures are required");
+                return names[static_cast<size_t>(slot)];
+            }
         }
     }
 }
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
-#include <map>
+#include <array>
+#include <functional>
 #include <string>
 #include <vector>
 #include "../../Format/Dat/Item.h"
@@ -13,6 +14,28 @@ namespace Falltergeist
     {
         namespace Int
         {
+            // How a push opcode treats its inline value
+            enum class OperandKind : uint8_t
+            {
+                NONE,
+                INTEGER,
+                FLOAT,
+                // offset in strings table
+                STRING,
+                // offset in identifiers table, pushed for the exported variable opcodes which follow
+                IDENTIFIER
+            };
+
+            // Script instruction decoded ahead of execution
+            struct Instruction
+            {
+                uint32_t offset;
+                uint16_t opcode;
+                OperandKind operandKind;
+                // inline value of push opcodes
+                uint32_t operand;
+            };
+
             class File : public Dat::Item
             {
                 public:
@@ -23,8 +46,25 @@ namespace Falltergeist
                     // returns procedure with a given name or nullptr if none found
                     const Procedure* procedure(const std::string& name) const;
 
-                    const std::map<unsigned int, std::string>& identifiers() const;
-                    const std::map<unsigned int, std::string>& strings() const;
+                    // returns standard procedure or nullptr if script doesn't have it
+                    const Procedure* procedure(PROCEDURE slot) const;
+
+                    // name of a standard procedure, e.g. "map_enter_p_proc"
+                    static const char* procedureName(PROCEDURE slot);
+
+                    // names of functions and variables by their offset in identifiers table
+                    const std::string& identifier(uint32_t offset) const;
+
+                    // string constants by their offset in strings table
+                    const std::string& string(uint32_t offset) const;
+
+                    // Gives ids of an external string table to all identifiers and string constants, once per file.
+                    // The script VM keeps its strings in such table, so constants don't have to be looked up each time they are used.
+                    void internConstants(const std::function<uint32_t(const std::string&)>& intern);
+
+                    // ids given by internConstants() by offset in identifiers and strings tables
+                    uint32_t identifierId(uint32_t offset) const;
+                    uint32_t stringId(uint32_t offset) const;
 
                     // current position in script file
                     size_t position() const;
@@ -41,15 +81,43 @@ namespace Falltergeist
                     // read the next value
                     uint32_t readValue();
 
+                    // all instructions of the script code, decoded once on load
+                    const std::vector<Instruction>& instructions() const;
+
+                    // index of instruction at given offset within instructions() or instructions().size() if there is none
+                    size_t instructionIndex(uint32_t offset) const;
+
+                    // decodes instruction at given offset directly from the file, for code which is not in instructions()
+                    Instruction decodeInstruction(uint32_t offset);
+
                 protected:
                     Dat::Stream _stream;
 
+                    // Table of strings which is indexed directly by offset of a string
+                    struct ConstantPool
+                    {
+                        std::vector<std::string> values;
+                        // index within values for each offset, -1 if no string starts there
+                        std::vector<int32_t> indices;
+                        // external ids of values, empty until internConstants()
+                        std::vector<uint32_t> ids;
+
+                        const std::string& at(uint32_t offset) const;
+                        uint32_t idAt(uint32_t offset) const;
+                    };
+
                     std::vector<Procedure> _procedures;
+                    // index within _procedures for each standard procedure, -1 if there is none
+                    std::array<int32_t, static_cast<size_t>(PROCEDURE::COUNT)> _standardProcedures;
+
+                    ConstantPool _identifiers;
+                    ConstantPool _strings;
+                    std::vector<Instruction> _instructions;
+                    bool _constantsInterned = false;
 
-                    std::map<unsigned int, std::string> _functions;
-                    std::vector<unsigned int> _functionsOffsets;
-                    std::map<unsigned int, std::string> _identifiers;
-                    std::map<unsigned int, std::string> _strings;
+                    void _readConstantPool(ConstantPool& pool, uint32_t tableSize);
+                    void _decodeInstructions(uint32_t from, uint32_t to);
+                    static bool _hasOperand(uint16_t opcode);
             };
         }
     }
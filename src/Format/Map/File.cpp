@@ -13,7 +13,7 @@ namespace Falltergeist
             {
             }
 
-            void File::init(ProFileTypeLoaderCallback callback)
+            void File::init(const ProFileTypeLoaderCallback& callback)
             {
                 if (_initialized) {
                     return;
@@ -173,7 +173,7 @@ namespace Falltergeist
                 }
             }
 
-            std::unique_ptr<Object> File::_readObject(Dat::Stream& stream, ProFileTypeLoaderCallback callback)
+            std::unique_ptr<Object> File::_readObject(Dat::Stream& stream, const ProFileTypeLoaderCallback& callback)
             {
                 auto object = std::make_unique<Object>();
                 object->setOID(stream.uint32());
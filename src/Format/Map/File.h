@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include <functional>
 #include <string>
 #include <vector>
 #include "../Dat/Item.h"
@@ -25,7 +26,7 @@ namespace Falltergeist
         {
             class Object;
 
-            typedef Pro::File* (*ProFileTypeLoaderCallback)(uint32_t);
+            typedef std::function<Pro::File*(uint32_t)> ProFileTypeLoaderCallback;
 
             class File : public Dat::Item
             {
@@ -33,7 +34,7 @@ namespace Falltergeist
                     File(Dat::Stream&& stream);
 
                     // TODO: get rid of two-step initialization
-                    void init(ProFileTypeLoaderCallback callback);
+                    void init(const ProFileTypeLoaderCallback& callback);
 
                     const std::vector<Elevation>& elevations() const;
                     const std::vector<Script>& scripts() const;
@@ -78,7 +79,7 @@ namespace Falltergeist
 
                     std::string _name;
 
-                    std::unique_ptr<Object> _readObject(Dat::Stream& stream, ProFileTypeLoaderCallback callback);
+                    std::unique_ptr<Object> _readObject(Dat::Stream& stream, const ProFileTypeLoaderCallback& callback);
             };
         }
     }
@@ -450,10 +450,10 @@ namespace Falltergeist
 
         void CritterObject::talk_p_proc()
         {
-            if (_script && _script->hasFunction("talk_p_proc")) {
+            if (_script && _script->hasFunction(PROCEDURE::TALK)) {
                 _script
                     ->setSourceObject(Game::getInstance()->player().get())
-                    ->call("talk_p_proc")
+                    ->call(PROCEDURE::TALK)
                 ;
             }
         }
@@ -468,8 +468,8 @@ namespace Falltergeist
 
         void CritterObject::critter_p_proc()
         {
-            if (_script && _script->hasFunction("critter_p_proc")) {
-                _script->call("critter_p_proc");
+            if (_script && _script->hasFunction(PROCEDURE::CRITTER)) {
+                _script->call(PROCEDURE::CRITTER);
             }
         }
 
@@ -544,7 +544,7 @@ namespace Falltergeist
 
                     // This hack is needed for prevent game crash when player goes to the
                     // exit tile and location is changed but movement is not finished
-                    for (auto object : *hexagon->objects()) {
+                    for (auto object : hexagon->objects()) {
                         if (dynamic_cast<ExitMiscObject*>(object)) {
                             moveQueue->clear();
                             break;
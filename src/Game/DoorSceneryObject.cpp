@@ -88,7 +88,7 @@ namespace Falltergeist
             queue->animationEndedHandler().clear();
             queue->stop();
             queue->currentAnimation()->setReverse(true);
-            Game::getInstance()->locationState()->initLight();
+            Game::getInstance()->locationState()->updateLight(this);
             Logger::info("") << "Door opened: " << opened() << std::endl;
         }
 
@@ -99,7 +99,7 @@ namespace Falltergeist
             queue->animationEndedHandler().clear();
             queue->stop();
             queue->currentAnimation()->setReverse(false);
-            Game::getInstance()->locationState()->initLight();
+            Game::getInstance()->locationState()->updateLight(this);
             Logger::info("") << "Door opened: " << opened() << std::endl;
         }
     }
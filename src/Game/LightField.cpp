@@ -0,0 +1,147 @@
+#include <algorithm>
+#include "../Game/LightField.h"
+#include "../Game/Object.h"
+#include "../PathFinding/Hexagon.h"
+
+namespace Falltergeist
+{
+    namespace Game
+    {
+        namespace
+        {
+            // light of hexagon which isn't lit by anything
+            const int MIN_LIGHT = 655;
+            const int MAX_LIGHT = 65536;
+        }
+
+        LightField::LightField(HexagonGrid* grid) : _grid(grid), _sums(GRID_WIDTH * GRID_HEIGHT, 0)
+        {
+        }
+
+        void LightField::rebuild()
+        {
+            _emitters.clear();
+            std::fill(_sums.begin(), _sums.end(), 0);
+            for (auto hexagon : _grid->hexagons()) {
+                hexagon->setLight(MIN_LIGHT);
+                _grid->updateLightBlocker(hexagon);
+            }
+            for (auto hexagon : _grid->hexagons()) {
+                for (auto object : hexagon->objects()) {
+                    _updateEmitter(object, hexagon);
+                }
+            }
+            invalidate();
+        }
+
+        void LightField::objectMoved(Object* object, Hexagon* from, Hexagon* to)
+        {
+            _affected.clear();
+            // light sources around are recalculated only if the object has changed how light goes through hexagons
+            if (from && _grid->updateLightBlocker(from)) {
+                _collectAffected(from);
+            }
+            if (to && _grid->updateLightBlocker(to)) {
+                _collectAffected(to);
+            }
+            _updateAffected(object, to);
+        }
+
+        void LightField::objectChanged(Object* object)
+        {
+            _affected.clear();
+            auto hexagon = object->hexagon();
+            if (hexagon && _grid->updateLightBlocker(hexagon)) {
+                _collectAffected(hexagon);
+            }
+            _updateAffected(object, object->hexagon());
+        }
+
+        void LightField::invalidate()
+        {
+            _dirtyBegin = 0;
+            _dirtyEnd = _sums.size();
+        }
+
+        bool LightField::dirty() const
+        {
+            return _dirtyBegin < _dirtyEnd;
+        }
+
+        size_t LightField::dirtyBegin() const
+        {
+            return _dirtyBegin;
+        }
+
+        size_t LightField::dirtyEnd() const
+        {
+            return _dirtyEnd;
+        }
+
+        void LightField::clearDirty()
+        {
+            _dirtyBegin = _dirtyEnd = 0;
+        }
+
+        void LightField::_collectAffected(Hexagon* hexagon)
+        {
+            for (auto& emitter : _emitters) {
+                if (_grid->distance(emitter.second.hexagon, hexagon) <= emitter.first->lightRadius()
+                    && std::find(_affected.begin(), _affected.end(), emitter.first) == _affected.end()
+                ) {
+                    _affected.push_back(emitter.first);
+                }
+            }
+        }
+
+        void LightField::_updateAffected(Object* object, Hexagon* hexagon)
+        {
+            for (auto emitter : _affected) {
+                if (emitter != object) {
+                    _updateEmitter(emitter, emitter->hexagon());
+                }
+            }
+            _updateEmitter(object, hexagon);
+        }
+
+        void LightField::_updateEmitter(Object* object, Hexagon* hexagon)
+        {
+            auto it = _emitters.find(object);
+            if (it != _emitters.end()) {
+                _apply(it->second.lit, -1);
+                it->second.lit.clear();
+            }
+
+            if (!hexagon || object->lightIntensity() == 0 || object->lightRadius() == 0) {
+                if (it != _emitters.end()) {
+                    _emitters.erase(it);
+                }
+                return;
+            }
+
+            if (it == _emitters.end()) {
+                it = _emitters.emplace(object, Emitter()).first;
+            }
+            it->second.hexagon = hexagon;
+            _grid->initLight(hexagon, object, it->second.lit);
+            _apply(it->second.lit, 1);
+        }
+
+        void LightField::_apply(const std::vector<LitHexagon>& lit, int sign)
+        {
+            for (auto& item : lit) {
+                auto number = item.hexagon->number();
+                _sums[number] += sign * item.light;
+                item.hexagon->setLight(static_cast<unsigned int>(std::max(MIN_LIGHT, std::min(MAX_LIGHT, MIN_LIGHT + _sums[number]))));
+
+                if (_dirtyBegin == _dirtyEnd) {
+                    _dirtyBegin = number;
+                    _dirtyEnd = number + 1;
+                } else {
+                    _dirtyBegin = std::min<size_t>(_dirtyBegin, number);
+                    _dirtyEnd = std::max<size_t>(_dirtyEnd, number + 1);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+#include "../PathFinding/HexagonGrid.h"
+
+namespace Falltergeist
+{
+    class Hexagon;
+
+    namespace Game
+    {
+        class Object;
+
+        /**
+         * @brief Light of hexagonal grid
+         *
+         * Remembers which hexagons each light source has lit and by how much.
+         * When an object moves, only light sources around its old and new position are recalculated:
+         * their previous contribution is subtracted and a new one is added.
+         * Numbers of changed hexagons are kept as a dirty range, so the lightmap can upload only that part.
+         */
+        class LightField final
+        {
+            public:
+                explicit LightField(HexagonGrid* grid);
+
+                // Recalculates light of all sources on the grid
+                void rebuild();
+
+                // Must be called after object has moved between hexagons, any of them may be null.
+                // Objects removed from the map are passed with null destination.
+                void objectMoved(Object* object, Hexagon* from, Hexagon* to);
+
+                // Must be called after object has changed its light intensity, radius or ability to let light through
+                void objectChanged(Object* object);
+
+                // Marks all hexagons as changed, e.g. when ambient light level changes
+                void invalidate();
+
+                // Range of numbers of hexagons changed since the last call to clearDirty()
+                bool dirty() const;
+                size_t dirtyBegin() const;
+                size_t dirtyEnd() const;
+                void clearDirty();
+
+            private:
+                struct Emitter
+                {
+                    Hexagon* hexagon = nullptr;
+                    std::vector<LitHexagon> lit;
+                };
+
+                HexagonGrid* _grid;
+                std::unordered_map<Object*, Emitter> _emitters;
+                // sum of all contributions to each hexagon, not clamped
+                std::vector<int> _sums;
+                // emitters to recalculate, kept to avoid allocations
+                std::vector<Object*> _affected;
+                size_t _dirtyBegin = 0;
+                size_t _dirtyEnd = 0;
+
+                void _collectAffected(Hexagon* hexagon);
+                void _updateAffected(Object* object, Hexagon* hexagon);
+                // recalculates light of object placed at given hexagon
+                void _updateEmitter(Object* object, Hexagon* hexagon);
+                void _apply(const std::vector<LitHexagon>& lit, int sign);
+        };
+    }
+}
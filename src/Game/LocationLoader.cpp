@@ -0,0 +1,172 @@
+#include <algorithm>
+#include "../Exception.h"
+#include "../Format/Enums.h"
+#include "../Format/Lst/File.h"
+#include "../Format/Map/File.h"
+#include "../Format/Map/Object.h"
+#include "../Format/Map/Script.h"
+#include "../Game/Location.h"
+#include "../Game/LocationLoader.h"
+#include "../Helpers/CritterAnimationHelper.h"
+#include "../Helpers/GameLocationHelper.h"
+#include "../ResourceManager.h"
+
+namespace Falltergeist
+{
+    namespace Game
+    {
+        LocationLoader::LocationLoader(const std::string& name, unsigned int elevation, std::shared_ptr<ILogger> logger)
+            : logger(std::move(logger)), _name(name), _mapFilename("maps/" + name + ".map"), _elevation(elevation)
+        {
+            _preload({_mapFilename});
+        }
+
+        const std::string& LocationLoader::name() const
+        {
+            return _name;
+        }
+
+        void LocationLoader::setProgressCallback(ProgressCallback callback)
+        {
+            _progressCallback = std::move(callback);
+        }
+
+        std::shared_ptr<Location> LocationLoader::location() const
+        {
+            return _location;
+        }
+
+        bool LocationLoader::think()
+        {
+            if (_stage == Stage::DONE) {
+                return true;
+            }
+
+            if (!_updatePending()) {
+                return false;
+            }
+
+            if (_stage == Stage::MAP) {
+                // the map is in the cache now, so this doesn't read anything
+                auto mapFile = ResourceManager::getInstance()->mapFileType(_mapFilename);
+                if (mapFile) {
+                    _stage = Stage::RESOURCES;
+                    _preload(_resourcesOf(mapFile));
+                    if (!_updatePending()) {
+                        return false;
+                    }
+                }
+            }
+
+            // All files are parsed, only objects creation and texture uploads are left
+            Helpers::GameLocationHelper gameLocationHelper(logger);
+            _location = gameLocationHelper.getByName(_name);
+            _stage = Stage::DONE;
+            return true;
+        }
+
+        std::vector<std::string> LocationLoader::_resourcesOf(Format::Map::File* mapFile) const
+        {
+            auto resourceManager = ResourceManager::getInstance();
+            std::vector<std::string> filenames;
+
+            for (auto& elevation : mapFile->elevations()) {
+                for (auto& mapObject : elevation.objects()) {
+                    _addObjectResources(*mapObject, filenames);
+                }
+            }
+
+            // only tiles of the elevation player enters are turned into textures
+            if (_elevation < mapFile->elevations().size()) {
+                auto& elevation = mapFile->elevations().at(_elevation);
+                auto tiles = resourceManager->lstFileType("art/tiles/tiles.lst")->strings();
+                for (auto numbers : {&elevation.floorTiles(), &elevation.roofTiles()}) {
+                    for (auto number : *numbers) {
+                        if (number > 1 && number < tiles->size()) {
+                            filenames.push_back("art/tiles/" + tiles->at(number));
+                        }
+                    }
+                }
+            }
+
+            if (mapFile->scriptId() > 0) {
+                _addScript(mapFile->scriptId() - 1, filenames);
+            }
+            for (auto& script : mapFile->scripts()) {
+                if (script.type() == Format::Map::Script::Type::SPATIAL) {
+                    _addScript(script.scriptId(), filenames);
+                }
+            }
+
+            std::sort(filenames.begin(), filenames.end());
+            filenames.erase(std::unique(filenames.begin(), filenames.end()), filenames.end());
+            return filenames;
+        }
+
+        void LocationLoader::_addObjectResources(Format::Map::Object& mapObject, std::vector<std::string>& filenames) const
+        {
+            auto FID = mapObject.FID();
+            if (static_cast<FRM_TYPE>(FID >> 24) == FRM_TYPE::CRITTER) {
+                // weapon in hands is not known yet, so only the unarmed standing animation is guessed
+                Helpers::CritterAnimationHelper critterAnimationHelper;
+                auto prefix = critterAnimationHelper.getPrefix(FID);
+                if (!prefix.empty()) {
+                    filenames.push_back("art/critters/" + prefix + "aa.frm");
+                }
+            } else {
+                try {
+                    auto frmName = ResourceManager::getInstance()->FIDtoFrmName(FID);
+                    if (!frmName.empty()) {
+                        filenames.push_back(frmName);
+                    }
+                } catch (const Exception&) {
+                    // object creation will report wrong FID
+                }
+            }
+
+            _addScript(mapObject.scriptId(), filenames);
+            _addScript(mapObject.mapScriptId(), filenames);
+
+            for (auto& child : mapObject.children()) {
+                _addObjectResources(*child, filenames);
+            }
+        }
+
+        void LocationLoader::_addScript(int SID, std::vector<std::string>& filenames) const
+        {
+            if (SID <= 0) {
+                return;
+            }
+            auto scripts = ResourceManager::getInstance()->lstFileType("scripts/scripts.lst")->strings();
+            if (static_cast<unsigned>(SID) < scripts->size()) {
+                filenames.push_back("scripts/" + scripts->at(SID));
+            }
+        }
+
+        void LocationLoader::_preload(const std::vector<std::string>& filenames)
+        {
+            ResourceManager::getInstance()->preload(filenames);
+            _total += filenames.size();
+            _pending.insert(_pending.end(), filenames.begin(), filenames.end());
+        }
+
+        bool LocationLoader::_updatePending()
+        {
+            auto resourceManager = ResourceManager::getInstance();
+            resourceManager->adoptPreloadedItems();
+
+            auto pendingCount = _pending.size();
+            _pending.erase(
+                std::remove_if(_pending.begin(), _pending.end(), [resourceManager](const std::string& filename) {
+                    return !resourceManager->isPreloading(filename);
+                }),
+                _pending.end()
+            );
+
+            if (_progressCallback && (_pending.size() != pendingCount || _pending.empty())) {
+                _progressCallback(_total == 0 ? 1.0f : static_cast<float>(_total - _pending.size()) / _total);
+            }
+            return _pending.empty();
+        }
+    }
+}
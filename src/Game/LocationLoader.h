@@ -0,0 +1,79 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../ILogger.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Map
+        {
+            class File;
+            class Object;
+        }
+    }
+    namespace Game
+    {
+        class Location;
+
+        /**
+         * @brief Loads location in the background
+         *
+         * Map file, prototypes, scripts and sprites are read and parsed on worker threads.
+         * The main thread only creates game objects and uploads textures once everything is in the cache,
+         * so map transitions don't freeze the game.
+         * Helpers::GameLocationHelper::getByName() remains the synchronous way to load locations.
+         */
+        class LocationLoader final
+        {
+            public:
+                // Receives fraction of loaded files, from 0 to 1
+                using ProgressCallback = std::function<void(float)>;
+
+                LocationLoader(const std::string& name, unsigned int elevation, std::shared_ptr<ILogger> logger);
+
+                const std::string& name() const;
+
+                void setProgressCallback(ProgressCallback callback);
+
+                // Advances loading. Must be called from the main thread, e.g. every frame.
+                // Returns true when loading is finished and location() is ready.
+                bool think();
+
+                // Loaded location or nullptr if the map can't be loaded
+                std::shared_ptr<Location> location() const;
+
+            private:
+                enum class Stage
+                {
+                    MAP,
+                    RESOURCES,
+                    DONE
+                };
+
+                std::shared_ptr<ILogger> logger;
+                std::string _name;
+                std::string _mapFilename;
+                unsigned int _elevation;
+                Stage _stage = Stage::MAP;
+                ProgressCallback _progressCallback;
+                // files which are still being parsed on worker threads
+                std::vector<std::string> _pending;
+                size_t _total = 0;
+                std::shared_ptr<Location> _location;
+
+                // Names of all files needed to create objects and tiles of given map
+                std::vector<std::string> _resourcesOf(Format::Map::File* mapFile) const;
+                void _addObjectResources(Format::Map::Object& mapObject, std::vector<std::string>& filenames) const;
+                void _addScript(int SID, std::vector<std::string>& filenames) const;
+
+                void _preload(const std::vector<std::string>& filenames);
+                // Returns true if all preloaded files got to the cache
+                bool _updatePending();
+        };
+    }
+}
@@ -0,0 +1,94 @@
+#include <algorithm>
+#include "../Format/Enums.h"
+#include "../Format/Map/File.h"
+#include "../Format/Map/Object.h"
+#include "../Game/LocationPrefetcher.h"
+#include "../Helpers/CritterAnimationHelper.h"
+#include "../Logger.h"
+#include "../ResourceManager.h"
+
+namespace Falltergeist
+{
+    namespace Game
+    {
+        LocationPrefetcher::LocationPrefetcher(const std::vector<std::string>& names, size_t memoryLimit)
+            : _names(names), _memoryLimit(memoryLimit), _initialMemoryUsage(ResourceManager::getInstance()->memoryUsage())
+        {
+        }
+
+        bool LocationPrefetcher::finished() const
+        {
+            return _finished;
+        }
+
+        void LocationPrefetcher::think()
+        {
+            if (_finished) {
+                return;
+            }
+
+            auto resourceManager = ResourceManager::getInstance();
+            resourceManager->adoptPreloadedItems();
+            _pending.erase(
+                std::remove_if(_pending.begin(), _pending.end(), [resourceManager](const std::string& filename) {
+                    return !resourceManager->isPreloading(filename);
+                }),
+                _pending.end()
+            );
+            if (!_pending.empty()) {
+                return;
+            }
+
+            if (_stage == Stage::MAP) {
+                auto mapFilename = "maps/" + _names.at(_next - 1) + ".map";
+                // don't load broken maps on the main thread, it will happen anyway if player goes there
+                if (resourceManager->isLoaded(mapFilename)) {
+                    _stage = Stage::CRITTERS;
+                    _preload(_critterFilenames(mapFilename));
+                    return;
+                }
+            }
+            _stage = Stage::IDLE;
+
+            auto memoryUsage = resourceManager->memoryUsage();
+            if (_next == _names.size() || memoryUsage > _initialMemoryUsage + _memoryLimit) {
+                Logger::debug("LOCATION") << "Prefetched " << _next << " of " << _names.size() << " maps" << std::endl;
+                _finished = true;
+                return;
+            }
+
+            _stage = Stage::MAP;
+            _preload({"maps/" + _names.at(_next++) + ".map"});
+        }
+
+        void LocationPrefetcher::_preload(const std::vector<std::string>& filenames)
+        {
+            ResourceManager::getInstance()->preload(filenames);
+            _pending.insert(_pending.end(), filenames.begin(), filenames.end());
+        }
+
+        std::vector<std::string> LocationPrefetcher::_critterFilenames(const std::string& mapFilename) const
+        {
+            Helpers::CritterAnimationHelper critterAnimationHelper;
+            std::vector<std::string> filenames;
+
+            auto mapFile = ResourceManager::getInstance()->mapFileType(mapFilename);
+            for (auto& elevation : mapFile->elevations()) {
+                for (auto& mapObject : elevation.objects()) {
+                    auto FID = mapObject->FID();
+                    if (static_cast<FRM_TYPE>(FID >> 24) != FRM_TYPE::CRITTER) {
+                        continue;
+                    }
+                    auto prefix = critterAnimationHelper.getPrefix(FID);
+                    if (!prefix.empty()) {
+                        filenames.push_back("art/critters/" + prefix + "aa.frm");
+                    }
+                }
+            }
+
+            std::sort(filenames.begin(), filenames.end());
+            filenames.erase(std::unique(filenames.begin(), filenames.end()), filenames.end());
+            return filenames;
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Falltergeist
+{
+    namespace Game
+    {
+        /**
+         * @brief Warms up resource cache with maps player may go to next
+         *
+         * Map files, their prototypes and critter sprites are parsed on worker threads one map at a time,
+         * so walking through an exit grid doesn't have to read them.
+         * Prefetching stops once it has added given amount of memory to the cache.
+         */
+        class LocationPrefetcher final
+        {
+            public:
+                // Maps are prefetched in given order
+                LocationPrefetcher(const std::vector<std::string>& names, size_t memoryLimit);
+
+                // Advances prefetching. Must be called from the main thread, e.g. every frame.
+                void think();
+
+                bool finished() const;
+
+            private:
+                enum class Stage
+                {
+                    IDLE,
+                    MAP,
+                    CRITTERS
+                };
+
+                std::vector<std::string> _names;
+                size_t _next = 0;
+                Stage _stage = Stage::IDLE;
+                // files which are still being parsed on worker threads
+                std::vector<std::string> _pending;
+                size_t _memoryLimit;
+                size_t _initialMemoryUsage;
+                bool _finished = false;
+
+                void _preload(const std::vector<std::string>& filenames);
+                std::vector<std::string> _critterFilenames(const std::string& mapFilename) const;
+        };
+    }
+}
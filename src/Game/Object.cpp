@@ -294,10 +294,10 @@ namespace Falltergeist
             Logger::info("SCRIPT") << "description_p_proc() - 0x" << std::hex << PID() << " " << name() << " "
                                    << (script() ? script()->filename() : "") << std::endl;
             bool useDefault = true;
-            if (script() && script()->hasFunction("description_p_proc")) {
+            if (script() && script()->hasFunction(PROCEDURE::DESCRIPTION)) {
                 script()
                         ->setSourceObject(Game::getInstance()->player().get())
-                        ->call("description_p_proc");
+                        ->call(PROCEDURE::DESCRIPTION);
                 if (script()->overrides()) {
                     useDefault = false;
                 }
@@ -313,29 +313,29 @@ namespace Falltergeist
 
         void Object::use_p_proc(CritterObject *usedBy)
         {
-            if (script() && script()->hasFunction("use_p_proc")) {
+            if (script() && script()->hasFunction(PROCEDURE::USE)) {
                 script()
                         ->setSourceObject(usedBy)
-                        ->call("use_p_proc");
+                        ->call(PROCEDURE::USE);
             }
         }
 
         void Object::destroy_p_proc()
         {
-            if (script() && script()->hasFunction("destroy_p_proc")) {
+            if (script() && script()->hasFunction(PROCEDURE::DESTROY)) {
                 script()
                         ->setSourceObject(Game::getInstance()->player().get())
-                        ->call("destroy_p_proc");
+                        ->call(PROCEDURE::DESTROY);
             }
         }
 
         void Object::look_at_p_proc()
         {
             bool useDefault = true;
-            if (script() && script()->hasFunction("look_at_p_proc")) {
+            if (script() && script()->hasFunction(PROCEDURE::LOOK_AT)) {
                 script()
                         ->setSourceObject(Game::getInstance()->player().get())
-                        ->call("look_at_p_proc");
+                        ->call(PROCEDURE::LOOK_AT);
                 if (script()->overrides()) {
                     useDefault = false;
                 }
@@ -351,53 +351,53 @@ namespace Falltergeist
         void Object::map_enter_p_proc()
         {
             if (script()) {
-                script()->call("map_enter_p_proc");
+                script()->call(PROCEDURE::MAP_ENTER);
             }
         }
 
         void Object::map_exit_p_proc()
         {
             if (script()) {
-                script()->call("map_exit_p_proc");
+                script()->call(PROCEDURE::MAP_EXIT);
             }
         }
 
         void Object::map_update_p_proc()
         {
             if (script()) {
-                script()->call("map_update_p_proc");
+                script()->call(PROCEDURE::MAP_UPDATE);
             }
         }
 
         void Object::pickup_p_proc(CritterObject *pickedUpBy)
         {
-            if (script() && script()->hasFunction("pickup_p_proc")) {
+            if (script() && script()->hasFunction(PROCEDURE::PICKUP)) {
                 script()
                         ->setSourceObject(pickedUpBy)
-                        ->call("pickup_p_proc");
+                        ->call(PROCEDURE::PICKUP);
             }
             // @TODO: standard handler
         }
 
         void Object::use_obj_on_p_proc(Object *objectUsed, CritterObject *usedBy)
         {
-            if (script() && script()->hasFunction("use_obj_on_p_proc")) {
+            if (script() && script()->hasFunction(PROCEDURE::USE_OBJ_ON)) {
                 script()
                         ->setSourceObject(usedBy)
                         ->setTargetObject(objectUsed)
-                        ->call("use_obj_on_p_proc");
+                        ->call(PROCEDURE::USE_OBJ_ON);
             }
             // @TODO: standard handlers for drugs, etc.
         }
 
         void Object::use_skill_on_p_proc(SKILL skill, Object *objectUsed, CritterObject *usedBy)
         {
-            if (script() && script()->hasFunction("use_skill_on_p_proc")) {
+            if (script() && script()->hasFunction(PROCEDURE::USE_SKILL_ON)) {
                 script()
                         ->setSourceObject(usedBy)
                         ->setTargetObject(objectUsed)
                         ->setUsedSkill(skill)
-                        ->call("use_skill_on_p_proc");
+                        ->call(PROCEDURE::USE_SKILL_ON);
             }
             // @TODO: standard handlers
         }
@@ -1,15 +1,56 @@
+#include "../Format/Pal/Color.h"
+#include "../Format/Pal/File.h"
 #include "../Graphics/AnimatedPalette.h"
+#include "../Graphics/GLState.h"
+#include "../ResourceManager.h"
 
 namespace Falltergeist
 {
     namespace Graphics
     {
+        namespace
+        {
+            // colors of the original palette which are cycled in place of indexes 229-253
+            const uint8_t slimeColors[4][3] = {
+                {0, 108, 0}, {11, 115, 7}, {27, 123, 15}, {43, 131, 27}
+            };
+            const uint8_t monitorsColors[5][3] = {
+                {107, 107, 111}, {99, 103, 127}, {87, 107, 143}, {0, 147, 163}, {107, 187, 255}
+            };
+            const uint8_t fireSlowColors[5][3] = {
+                {255, 0, 0}, {215, 0, 0}, {147, 43, 11}, {255, 119, 0}, {255, 59, 0}
+            };
+            const uint8_t fireFastColors[5][3] = {
+                {71, 0, 0}, {123, 0, 0}, {179, 0, 0}, {123, 0, 0}, {71, 0, 0}
+            };
+            const uint8_t shoreColors[6][3] = {
+                {83, 63, 43}, {75, 59, 43}, {67, 55, 39}, {63, 51, 39}, {55, 47, 35}, {51, 43, 35}
+            };
+
+            void cycle(std::array<uint8_t, 256 * 4>& palette, unsigned int first, const uint8_t (*colors)[3], unsigned int size, unsigned int counter)
+            {
+                for (unsigned int i = 0; i != size; ++i)
+                {
+                    auto color = colors[(i + counter) % size];
+                    auto texel = &palette[(first + i) * 4];
+                    texel[0] = color[0];
+                    texel[1] = color[1];
+                    texel[2] = color[2];
+                    texel[3] = 255;
+                }
+            }
+        }
+
         AnimatedPalette::AnimatedPalette()
         {
         }
 
         AnimatedPalette::~AnimatedPalette()
         {
+            if (_paletteTexture)
+            {
+                GLState::getInstance()->deleteTextures(1, &_paletteTexture);
+            }
         }
 
         void AnimatedPalette::think(const float &deltaTime)
@@ -17,6 +58,7 @@ namespace Falltergeist
             _monitorsMillisecondsTracked += deltaTime;
             if (_monitorsMillisecondsTracked >= 100.0f) {
                 _monitorsMillisecondsTracked -= 100.0f;
+                _paletteDirty = true;
                 _monitorsCounter++;
                 if (_monitorsCounter >= 5) {
                     _monitorsCounter = 0;
@@ -26,6 +68,7 @@ namespace Falltergeist
             _slimeMillisecondsTracked += deltaTime;
             if (_slimeMillisecondsTracked >= 200.0f) {
                 _slimeMillisecondsTracked -= 200.0f;
+                _paletteDirty = true;
                 _slimeCounter++;
                 if (_slimeCounter >= 4) {
                     _slimeCounter = 0;
@@ -35,6 +78,7 @@ namespace Falltergeist
             _shoreMillisecondsTracked += deltaTime;
             if (_shoreMillisecondsTracked >= 200.0f) {
                 _shoreMillisecondsTracked -= 200.0f;
+                _paletteDirty = true;
                 _shoreCounter++;
                 if (_shoreCounter >= 6) {
                     _shoreCounter = 0;
@@ -44,6 +88,7 @@ namespace Falltergeist
             _fireSlowMillisecondsTracked += deltaTime;
             if (_fireSlowMillisecondsTracked >= 200.0f) {
                 _fireSlowMillisecondsTracked -= 200.0f;
+                _paletteDirty = true;
                 _fireSlowCounter++;
                 if (_fireSlowCounter >= 5) {
                     _fireSlowCounter = 0;
@@ -53,6 +98,7 @@ namespace Falltergeist
             _fireFastMillisecondsTracked += deltaTime;
             if (_fireFastMillisecondsTracked >= 142.0f) {
                 _fireFastMillisecondsTracked -= 142.0f;
+                _paletteDirty = true;
                 _fireFastCounter++;
                 if (_fireFastCounter >= 5) {
                     _fireFastCounter = 0;
@@ -67,6 +113,7 @@ namespace Falltergeist
                 }
 
                 _blinkingRedCounter = _blinkingRed + _blinkingRedCounter;
+                _paletteDirty = true;
             }
         }
 
@@ -82,5 +129,56 @@ namespace Falltergeist
             cnt.push_back(_blinkingRedCounter);
             return cnt;
         }
+
+        void AnimatedPalette::bindPalette(uint8_t unit)
+        {
+            if (_paletteDirty)
+            {
+                _updatePalette();
+            }
+            GLState::getInstance()->bindTexture(unit, _paletteTexture);
+        }
+
+        void AnimatedPalette::_updatePalette()
+        {
+            std::array<uint8_t, 256 * 4> palette;
+            auto pal = ResourceManager::getInstance()->palFileType("color.pal");
+            for (unsigned int i = 0; i != 256; ++i)
+            {
+                // components of the file are 6-bit, conversion scales them
+                unsigned int color = *pal->color(i);
+                palette[i * 4] = static_cast<uint8_t>(color >> 24);
+                palette[i * 4 + 1] = static_cast<uint8_t>(color >> 16);
+                palette[i * 4 + 2] = static_cast<uint8_t>(color >> 8);
+                palette[i * 4 + 3] = static_cast<uint8_t>(color);
+            }
+
+            cycle(palette, 229, slimeColors, 4, _slimeCounter);
+            cycle(palette, 233, monitorsColors, 5, _monitorsCounter);
+            cycle(palette, 238, fireSlowColors, 5, _fireSlowCounter);
+            cycle(palette, 243, fireFastColors, 5, _fireFastCounter);
+            cycle(palette, 248, shoreColors, 6, _shoreCounter);
+
+            // alarm
+            palette[254 * 4] = static_cast<uint8_t>(_blinkingRedCounter * 4);
+            palette[254 * 4 + 1] = 0;
+            palette[254 * 4 + 2] = 0;
+            palette[254 * 4 + 3] = 255;
+
+            if (!_paletteTexture)
+            {
+                GL_CHECK(glGenTextures(1, &_paletteTexture));
+                GLState::getInstance()->bindTexture(0, _paletteTexture);
+                GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 256, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, palette.data()));
+                GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+                GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+            }
+            else
+            {
+                GLState::getInstance()->bindTexture(0, _paletteTexture);
+                GL_CHECK(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 256, 1, GL_RGBA, GL_UNSIGNED_BYTE, palette.data()));
+            }
+            _paletteDirty = false;
+        }
     }
 }
@@ -23,7 +23,15 @@ namespace Falltergeist
                 std::vector<GLuint> counters();
                 void think(const float &deltaTime);
 
+                // Binds 256x1 texture with colors of color.pal, where animated colors are in their current state.
+                // It's uploaded again only after some of the counters changed.
+                void bindPalette(uint8_t unit);
+
             protected:
+                GLuint _paletteTexture = 0;
+                bool _paletteDirty = true;
+
+                void _updatePalette();
 
                 float _slimeMillisecondsTracked = 0;
                 unsigned int _slimeCounter = 0;
@@ -1,8 +1,8 @@
 ﻿#include <SDL_image.h>
 #include "../Format/Frm/File.h"
 #include "../Game/Game.h"
-#include "../Graphics/AnimatedPalette.h"
 #include "../Graphics/Animation.h"
+#include "../Graphics/SpriteBatch.h"
 #include "../ResourceManager.h"
 #include "../State/Location.h"
 
@@ -12,129 +12,58 @@ namespace Falltergeist
     {
         using Game::Game;
 
-        Animation::Animation(const std::string &filename)
+        Animation::Animation(const std::string &filename, unsigned int direction)
         {
-            // create buffers
-            // generate VAO
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
-            {
-                GL_CHECK(glGenVertexArrays(1, &_vao));
-                GL_CHECK(glBindVertexArray(_vao));
-            }
-
-            // generate VBOs for verts and tex
-            GL_CHECK(glGenBuffers(1, &_coordsVBO));
-            GL_CHECK(glGenBuffers(1, &_texCoordsVBO));
-            GL_CHECK(glGenBuffers(1, &_ebo));
-
-            _texture = ResourceManager::getInstance()->texture(filename);
-
             Format::Frm::File* frm = ResourceManager::getInstance()->frmFileType(filename);
+            // texture of the direction is looked up and pinned under the same name as the frames below
+            if (direction >= frm->directions().size()) direction = 0;
 
-            _stride = frm->framesPerDirection();
+            _texture = ResourceManager::getInstance()->texture(filename, direction);
+            _textureName = ResourceManager::textureName(filename, direction);
+            ResourceManager::getInstance()->pinTexture(_textureName);
 
             int offsetX = 1;
-            int offsetY = 1;
-
-            for (auto& direction : frm->directions())
+            for (auto& srcFrame : frm->directions().at(direction).frames())
             {
-                offsetX = 1;
-                for (unsigned int f = 0; f != frm->framesPerDirection(); ++f)
-                {
-                    auto& srcFrame = direction.frames().at(f);
-
-                    _vertices.push_back(glm::vec2(0.0, 0.0));
-                    _vertices.push_back(glm::vec2(0.0, (float)srcFrame.height() + 2.0));
-                    _vertices.push_back(glm::vec2((float)srcFrame.width() + 2.0, 0.0));
-                    _vertices.push_back(glm::vec2((float)srcFrame.width() + 2.0, (float)srcFrame.height() + 2.0));
-
-                    _texCoords.push_back(glm::vec2(
-                        (float)(offsetX - 1.0) / (float)_texture->textureWidth(),
-                        (float)(offsetY - 1.0) / (float)_texture->textureHeight()
-                    ));
-                    _texCoords.push_back(glm::vec2(
-                        (float)(offsetX - 1.0) / (float)_texture->textureWidth(),
-                        (float)(offsetY + srcFrame.height() + 1.0) / (float)_texture->textureHeight()
-                    ));
-                    _texCoords.push_back(glm::vec2(
-                        (float)(offsetX + srcFrame.width() + 1.0) / (float)_texture->textureWidth(),
-                        (float)(offsetY - 1.0) / (float)_texture->textureHeight()
-                    ));
-                    _texCoords.push_back(glm::vec2(
-                        (float)(offsetX + srcFrame.width() + 1.0) / (float)_texture->textureWidth(),
-                        (float)(offsetY + srcFrame.height() + 1.0) / (float)_texture->textureHeight()
-                    ));
-
-                    offsetX += srcFrame.width()+2;
-
-                }
-                offsetY += direction.height();
+                // frames are drawn with their transparent border
+                _framePositions.push_back(Point(offsetX - 1, 0));
+                _frameSizes.push_back(Size(srcFrame.width() + 2, srcFrame.height() + 2));
+                _frameVisible.push_back(_texture->opaque(offsetX, 1, srcFrame.width(), srcFrame.height()));
 
+                offsetX += srcFrame.width()+2;
             }
-
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _coordsVBO));
-            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(glm::vec2), &_vertices[0], GL_STATIC_DRAW));
-
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _texCoordsVBO));
-            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, _texCoords.size() * sizeof(glm::vec2), &_texCoords[0], GL_STATIC_DRAW));
-
-            _shader = ResourceManager::getInstance()->shader("animation");
-
-            _uniformTex = _shader->getUniform("tex");
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL21)
-            {
-                _uniformTexSize = _shader->getUniform("texSize");
-            }
-            _uniformFade = _shader->getUniform("fade");
-            _uniformMVP = _shader->getUniform("MVP");
-            _uniformCnt = _shader->getUniform("cnt");
-            _uniformLight = _shader->getUniform("global_light");
-            _uniformTrans = _shader->getUniform("trans");
-            _uniformOffset = _shader->getUniform("offset");
-            _uniformOutline = _shader->getUniform("outline");
-
-            _uniformTexStart = _shader->getUniform("texStart");
-            _uniformTexHeight = _shader->getUniform("texHeight");
-
-            _attribPos = _shader->getAttrib("Position");
-            _attribTex = _shader->getAttrib("TexCoord");
         }
 
         Animation::~Animation()
         {
-            GL_CHECK(glDeleteBuffers(1, &_coordsVBO));
-            GL_CHECK(glDeleteBuffers(1, &_texCoordsVBO));
-            GL_CHECK(glDeleteBuffers(1, &_ebo));
-
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
-            {
-                GL_CHECK(glDeleteVertexArrays(1, &_vao));
-            }
+            ResourceManager::getInstance()->unpinTexture(_textureName);
         }
 
-        void Animation::render(int x, int y, unsigned int direction, unsigned int frame, bool transparency, bool light, int outline, unsigned int lightValue)
+        void Animation::render(int x, int y, unsigned int frame, bool transparency, bool light, int outline, unsigned int lightValue)
         {
-            int pos = direction*_stride+frame;
-
-            float texStart = _texCoords.at(pos*4).y;
-            float texEnd = _texCoords.at(pos*4+3).y;
-            float texHeight = texEnd-texStart;
-
-            GL_CHECK(_shader->use());
-
-            GL_CHECK(_texture->bind(0));
-
-            GL_CHECK(_shader->setUniform(_uniformTex, 0));
-
-            GL_CHECK(_shader->setUniform(_uniformOffset, glm::vec2((float)x, (float)y)));
-
-            GL_CHECK(_shader->setUniform(_uniformMVP, Game::getInstance()->renderer()->getMVP()));
-
-            GL_CHECK(_shader->setUniform(_uniformFade, Game::getInstance()->renderer()->fadeColor()));
-
-            GL_CHECK(_shader->setUniform(_uniformCnt, Game::getInstance()->animatedPalette()->counters()));
+            if (!_frameVisible.at(frame))
+            {
+                return;
+            }
 
-            int lightLevel = 100;
+            SpriteBatch::Quad quad;
+            auto& size = _frameSizes.at(frame);
+            // texture may be moved inside atlas page, so its origin is taken every time
+            Point position = _texture->origin() + _framePositions.at(frame);
+            float textureWidth = (float)_texture->textureWidth();
+            float textureHeight = (float)_texture->textureHeight();
+
+            quad.topLeft = glm::vec2((float)x, (float)y);
+            quad.bottomRight = glm::vec2((float)(x + size.width()), (float)(y + size.height()));
+            quad.uvTopLeft = glm::vec2((float)position.x() / textureWidth, (float)position.y() / textureHeight);
+            quad.uvBottomRight = glm::vec2(
+                (float)(position.x() + size.width()) / textureWidth,
+                (float)(position.y() + size.height()) / textureHeight
+            );
+            quad.frameStart = quad.uvTopLeft.y;
+            quad.frameHeight = quad.uvBottomRight.y - quad.uvTopLeft.y;
+
+            unsigned int lightLevel = 100;
             if (light)
             {
                 if (auto state = Game::getInstance()->locationState())
@@ -143,51 +72,11 @@ namespace Falltergeist
                     lightLevel = lightValue / ((65536-655)/100);
                 }
             }
-            GL_CHECK(_shader->setUniform(_uniformLight, lightLevel));
-
-            GL_CHECK(_shader->setUniform(_uniformTrans, _trans));
-            GL_CHECK(_shader->setUniform(_uniformOutline, outline));
-
-            GL_CHECK(_shader->setUniform(_uniformTexStart, texStart));
-            GL_CHECK(_shader->setUniform(_uniformTexHeight, texHeight));
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL21)
-            {
-                GL_CHECK(_shader->setUniform(_uniformTexSize, glm::vec2((float)_texture->textureWidth(), (float)_texture->textureHeight() ) ));
-            }
-
-
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
-            {
-                GLint curvao;
-                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &curvao);
-                if ((GLuint)curvao != _vao)
-                {
-                    GL_CHECK(glBindVertexArray(_vao));
-                }
-            }
-
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _coordsVBO));
-            GL_CHECK(glVertexAttribPointer(_attribPos, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
-
-
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _texCoordsVBO));
-            GL_CHECK(glVertexAttribPointer(_attribTex, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
-
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
-
-            GLushort indexes[6] = {(GLushort) (pos * 4), (GLushort) (pos * 4 + 1), (GLushort) (pos * 4 + 2), (GLushort) (pos * 4 + 3), (GLushort) (pos * 4 + 2), (GLushort) (pos * 4 + 1)};
-
-
-            GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, 6*sizeof(GLushort), indexes, GL_STATIC_DRAW));
-
-            GL_CHECK(glEnableVertexAttribArray(_attribPos));
-            GL_CHECK(glEnableVertexAttribArray(_attribTex));
-
-            GL_CHECK(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0 ));
-
-            GL_CHECK(glDisableVertexAttribArray(_attribPos));
+            quad.light = lightLevel;
+            quad.trans = _trans;
+            quad.outline = outline;
 
-            GL_CHECK(glDisableVertexAttribArray(_attribTex));
+            Game::getInstance()->renderer()->spriteBatch()->add(_texture, quad);
         }
 
         bool Animation::opaque(unsigned int x, unsigned int y)
@@ -1,8 +1,8 @@
 #pragma once
 
 #include <iosfwd>
+#include <string>
 #include "../Graphics/Renderer.h"
-#include "../Graphics/Shader.h"
 #include "../Graphics/Texture.h"
 #include "../Graphics/TransFlags.h"
 
@@ -10,43 +10,32 @@ namespace Falltergeist
 {
     namespace Graphics
     {
+        // Frames of one direction of FRM animation, only the image of that direction is loaded
         class Animation
         {
             public:
-                Animation(const std::string& filename);
+                Animation(const std::string& filename, unsigned int direction);
                 ~Animation();
-                void render(int x, int y, unsigned int direction, unsigned int frame, bool transparency = false, bool light = false, int outline = 0,
+
+                Animation(const Animation&) = delete;
+                Animation& operator= (const Animation&) = delete;
+
+                void render(int x, int y, unsigned int frame, bool transparency = false, bool light = false, int outline = 0,
                             unsigned int lightValue=0);
                 bool opaque(unsigned int x, unsigned int y);
                 void trans(Graphics::TransFlags::Trans _trans);
 
             private:
-                GLuint _vao;
-                GLuint _coordsVBO;
-                GLuint _texCoordsVBO;
-                GLuint _ebo;
                 Texture* _texture;
-                int _stride;
+                // name of the texture of the direction
+                std::string _textureName;
                 Graphics::TransFlags::Trans _trans = Graphics::TransFlags::Trans::NONE;
 
-                std::vector<glm::vec2> _vertices;
-                std::vector<glm::vec2> _texCoords;
-
-                GLint _uniformTex;
-                GLint _uniformTexSize;
-                GLint _uniformFade;
-                GLint _uniformMVP;
-                GLint _uniformCnt;
-                GLint _uniformLight;
-                GLint _uniformTrans;
-                GLint _uniformOffset;
-                GLint _uniformOutline;
-                GLint _uniformTexStart;
-                GLint _uniformTexHeight;
-
-                GLint _attribPos;
-                GLint _attribTex;
-                Graphics::Shader*_shader;
+                // frame rectangles in the image
+                std::vector<Point> _framePositions;
+                std::vector<Size> _frameSizes;
+                // frames without opaque pixels are not drawn
+                std::vector<bool> _frameVisible;
         };
     }
 }
@@ -39,6 +39,12 @@ namespace Falltergeist
                     return _texture.get();
                 }
 
+                // approximate number of bytes occupied by the font
+                size_t memoryUsage() const
+                {
+                    return _texture ? _texture->memoryUsage() : 0;
+                }
+
             protected:
                 std::unique_ptr<Graphics::Texture> _texture = nullptr;
                 std::string _filename;
@@ -0,0 +1,162 @@
+#include "../Graphics/GLState.h"
+#include "../Graphics/Renderer.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        GLState::GLState()
+        {
+            reset();
+        }
+
+        // static
+        GLState* GLState::getInstance()
+        {
+            return Base::Singleton<GLState>::get();
+        }
+
+        void GLState::reset()
+        {
+            _program = UNKNOWN;
+            _vertexArray = UNKNOWN;
+            _arrayBuffer = UNKNOWN;
+            _elementArrayBuffer = UNKNOWN;
+            _activeTextureUnit = UNKNOWN;
+            for (auto& texture : _textures)
+            {
+                texture = UNKNOWN;
+            }
+            _blending = UNKNOWN;
+            _blendSource = UNKNOWN;
+            _blendDestination = UNKNOWN;
+        }
+
+        void GLState::useProgram(GLuint program)
+        {
+            if (_program != program)
+            {
+                GL_CHECK(glUseProgram(program));
+                _program = program;
+            }
+        }
+
+        void GLState::bindVertexArray(GLuint vertexArray)
+        {
+            if (_vertexArray != vertexArray)
+            {
+                GL_CHECK(glBindVertexArray(vertexArray));
+                _vertexArray = vertexArray;
+                _elementArrayBuffer = UNKNOWN;
+            }
+        }
+
+        void GLState::bindBuffer(GLenum target, GLuint buffer)
+        {
+            GLuint& bound = target == GL_ELEMENT_ARRAY_BUFFER ? _elementArrayBuffer : _arrayBuffer;
+            if (bound != buffer)
+            {
+                GL_CHECK(glBindBuffer(target, buffer));
+                bound = buffer;
+            }
+        }
+
+        void GLState::bindTexture(unsigned int unit, GLuint texture)
+        {
+            if (unit < TEXTURE_UNITS && _textures[unit] == texture)
+            {
+                return;
+            }
+            if (_activeTextureUnit != unit)
+            {
+                GL_CHECK(glActiveTexture(GL_TEXTURE0 + unit));
+                _activeTextureUnit = unit;
+            }
+            GL_CHECK(glBindTexture(GL_TEXTURE_2D, texture));
+            if (unit < TEXTURE_UNITS)
+            {
+                _textures[unit] = texture;
+            }
+        }
+
+        void GLState::setBlending(bool enabled)
+        {
+            GLuint blending = enabled ? 1 : 0;
+            if (_blending != blending)
+            {
+                if (enabled)
+                {
+                    GL_CHECK(glEnable(GL_BLEND));
+                }
+                else
+                {
+                    GL_CHECK(glDisable(GL_BLEND));
+                }
+                _blending = blending;
+            }
+        }
+
+        void GLState::blendFunc(GLenum source, GLenum destination)
+        {
+            if (_blendSource != source || _blendDestination != destination)
+            {
+                GL_CHECK(glBlendFunc(source, destination));
+                _blendSource = source;
+                _blendDestination = destination;
+            }
+        }
+
+        void GLState::deleteProgram(GLuint program)
+        {
+            GL_CHECK(glDeleteProgram(program));
+            if (_program == program)
+            {
+                _program = UNKNOWN;
+            }
+        }
+
+        void GLState::deleteVertexArrays(GLsizei count, const GLuint* vertexArrays)
+        {
+            GL_CHECK(glDeleteVertexArrays(count, vertexArrays));
+            for (GLsizei i = 0; i != count; ++i)
+            {
+                if (_vertexArray == vertexArrays[i])
+                {
+                    _vertexArray = UNKNOWN;
+                    _elementArrayBuffer = UNKNOWN;
+                }
+            }
+        }
+
+        void GLState::deleteBuffers(GLsizei count, const GLuint* buffers)
+        {
+            GL_CHECK(glDeleteBuffers(count, buffers));
+            for (GLsizei i = 0; i != count; ++i)
+            {
+                if (_arrayBuffer == buffers[i])
+                {
+                    _arrayBuffer = UNKNOWN;
+                }
+                if (_elementArrayBuffer == buffers[i])
+                {
+                    _elementArrayBuffer = UNKNOWN;
+                }
+            }
+        }
+
+        void GLState::deleteTextures(GLsizei count, const GLuint* textures)
+        {
+            GL_CHECK(glDeleteTextures(count, textures));
+            for (GLsizei i = 0; i != count; ++i)
+            {
+                for (auto& texture : _textures)
+                {
+                    if (texture == textures[i])
+                    {
+                        texture = UNKNOWN;
+                    }
+                }
+            }
+        }
+    }
+}
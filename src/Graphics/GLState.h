@@ -0,0 +1,65 @@
+#pragma once
+
+#ifdef __apple_build_version__
+    #include <glew.h>
+#else
+    #include <GL/glew.h>
+#endif
+#include "../Base/Singleton.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        /**
+         * @brief Remembers GL bindings to skip redundant calls without querying the driver
+         *
+         * Programs, vertex arrays, buffers, textures and blending must be changed only through it,
+         * otherwise it gets out of sync. Objects must be deleted through it too, since GL unbinds them
+         * and their names may be given to new objects.
+         */
+        class GLState
+        {
+            public:
+                static GLState* getInstance();
+
+                // Forgets all bindings, e.g. after a new context is created
+                void reset();
+
+                void useProgram(GLuint program);
+                // Element array buffer belongs to vertex array, so it's forgotten when other vertex array is bound
+                void bindVertexArray(GLuint vertexArray);
+                // GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER
+                void bindBuffer(GLenum target, GLuint buffer);
+                void bindTexture(unsigned int unit, GLuint texture);
+                void setBlending(bool enabled);
+                void blendFunc(GLenum source, GLenum destination);
+
+                void deleteProgram(GLuint program);
+                void deleteVertexArrays(GLsizei count, const GLuint* vertexArrays);
+                void deleteBuffers(GLsizei count, const GLuint* buffers);
+                void deleteTextures(GLsizei count, const GLuint* textures);
+
+            private:
+                friend class Base::Singleton<GLState>;
+
+                static const GLuint UNKNOWN = 0xFFFFFFFF;
+                static const unsigned int TEXTURE_UNITS = 8;
+
+                GLuint _program;
+                GLuint _vertexArray;
+                GLuint _arrayBuffer;
+                GLuint _elementArrayBuffer;
+                unsigned int _activeTextureUnit;
+                GLuint _textures[TEXTURE_UNITS];
+                // 0 - disabled, 1 - enabled, UNKNOWN
+                GLuint _blending;
+                GLenum _blendSource;
+                GLenum _blendDestination;
+
+                GLState();
+                GLState(const GLState&) = delete;
+                GLState& operator=(const GLState&) = delete;
+        };
+    }
+}
@@ -1,5 +1,7 @@
 #include "../Game/Game.h"
+#include "../Graphics/GLState.h"
 #include "../Graphics/Lightmap.h"
+#include "../Graphics/SpriteBatch.h"
 #include "../ResourceManager.h"
 #include "../State/Location.h"
 
@@ -14,7 +16,7 @@ namespace Falltergeist
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
                 GL_CHECK(glGenVertexArrays(1, &_vao));
-                GL_CHECK(glBindVertexArray(_vao));
+                GLState::getInstance()->bindVertexArray(_vao);
             }
 
             // generate VBOs for verts and tex
@@ -24,14 +26,14 @@ namespace Falltergeist
 
             if (coords.size()<=0) return;
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _coords));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, _coords);
             //update coords
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, coords.size() * sizeof(glm::vec2), &coords[0], GL_STATIC_DRAW));
 
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _lights));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, _lights);
 
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
+            GLState::getInstance()->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
             // update indexes
             GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexes.size() * sizeof(GLuint), &indexes[0], GL_DYNAMIC_DRAW));
             _indexes = static_cast<unsigned>(indexes.size());
@@ -49,13 +51,13 @@ namespace Falltergeist
 
         Lightmap::~Lightmap()
         {
-            GL_CHECK(glDeleteBuffers(1, &_coords));
-            GL_CHECK(glDeleteBuffers(1, &_lights));
-            GL_CHECK(glDeleteBuffers(1, &_ebo));
+            GLState::getInstance()->deleteBuffers(1, &_coords);
+            GLState::getInstance()->deleteBuffers(1, &_lights);
+            GLState::getInstance()->deleteBuffers(1, &_ebo);
 
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
-                GL_CHECK(glDeleteVertexArrays(1, &_vao));
+                GLState::getInstance()->deleteVertexArrays(1, &_vao);
             }
         }
 
@@ -63,7 +65,10 @@ namespace Falltergeist
         {
             if (_indexes<=0) return;
 
-            GL_CHECK(glBlendFunc(GL_DST_COLOR, GL_SRC_COLOR));
+            // light is multiplied with everything drawn before
+            Game::getInstance()->renderer()->spriteBatch()->flush();
+
+            GLState::getInstance()->blendFunc(GL_DST_COLOR, GL_SRC_COLOR);
 
             GL_CHECK(_shader->use());
 
@@ -76,24 +81,19 @@ namespace Falltergeist
 
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
-                GLint curvao;
-                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &curvao);
-                if ((GLuint)curvao != _vao)
-                {
-                    GL_CHECK(glBindVertexArray(_vao));
-                }
+                GLState::getInstance()->bindVertexArray(_vao);
             }
 
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _coords));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, _coords);
             GL_CHECK(glVertexAttribPointer(_attribPos, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _lights));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, _lights);
 
             GL_CHECK(glVertexAttribPointer(_attribLights, 1, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
+            GLState::getInstance()->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
 
 
             GL_CHECK(glEnableVertexAttribArray(_attribPos));
@@ -106,24 +106,34 @@ namespace Falltergeist
 
             GL_CHECK(glDisableVertexAttribArray(_attribLights));
 
-            GL_CHECK(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+            GLState::getInstance()->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        }
+
+        void Lightmap::update(const std::vector<float>& lights)
+        {
+            update(lights, 0, lights.size());
         }
 
-        void Lightmap::update(std::vector<float> lights)
+        void Lightmap::update(const std::vector<float>& lights, size_t offset, size_t count)
         {
+            if (lights.empty() || count == 0) {
+                return;
+            }
+
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
-                GLint curvao;
-                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &curvao);
-                if ((GLuint)curvao != _vao)
-                {
-                    GL_CHECK(glBindVertexArray(_vao));
-                }
+                GLState::getInstance()->bindVertexArray(_vao);
             }
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _lights));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, _lights);
+            if (lights.size() != _lightsSize) {
+                // (re)allocate the buffer
+                GL_CHECK(glBufferData(GL_ARRAY_BUFFER, lights.size() * sizeof(float), &lights[0], GL_DYNAMIC_DRAW));
+                _lightsSize = lights.size();
+                return;
+            }
             //update lights
-            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, lights.size() * sizeof(float), &lights[0], GL_STATIC_DRAW));
+            GL_CHECK(glBufferSubData(GL_ARRAY_BUFFER, offset * sizeof(float), count * sizeof(float), &lights[offset]));
         }
     }
 }
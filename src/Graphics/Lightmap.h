@@ -14,7 +14,9 @@ namespace Falltergeist
                 Lightmap(std::vector<glm::vec2> coords, std::vector<GLuint> indexes);
                 ~Lightmap();
                 void render(const Point &pos);
-                void update(std::vector<float> lights);
+                void update(const std::vector<float>& lights);
+                // uploads only count values starting from offset
+                void update(const std::vector<float>& lights, size_t offset, size_t count);
 
             private:
                 GLuint _vao;
@@ -29,6 +31,8 @@ namespace Falltergeist
                 GLint _attribPos;
                 GLint _attribLights;
                 unsigned int _indexes;
+                // number of values in lights buffer
+                size_t _lightsSize = 0;
                 Graphics::Shader*_shader;
         };
     }
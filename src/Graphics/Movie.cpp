@@ -1,7 +1,9 @@
 #include "../Game/Game.h"
+#include "../Graphics/GLState.h"
 #include "../Graphics/Movie.h"
 #include "../Graphics/Renderer.h"
 #include "../Graphics/Shader.h"
+#include "../Graphics/SpriteBatch.h"
 #include "../ResourceManager.h"
 
 namespace Falltergeist
@@ -41,6 +43,8 @@ namespace Falltergeist
 
         void Movie::render(int x, int y)
         {
+            Game::getInstance()->renderer()->spriteBatch()->flush();
+
             std::vector<glm::vec2> vertices;
             std::vector<glm::vec2> UV;
 
@@ -81,30 +85,24 @@ namespace Falltergeist
 
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
-                GLint curvao;
-                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &curvao);
-                GLint vao = Game::getInstance()->renderer()->getVAO();
-                if (curvao != vao)
-                {
-                    GL_CHECK(glBindVertexArray(vao));
-                }
+                GLState::getInstance()->bindVertexArray(Game::getInstance()->renderer()->getVAO());
             }
 
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, Game::getInstance()->renderer()->getVVBO()));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, Game::getInstance()->renderer()->getVVBO());
 
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec2), &vertices[0], GL_DYNAMIC_DRAW));
 
             GL_CHECK(glVertexAttribPointer(ResourceManager::getInstance()->shader("sprite")->getAttrib("Position"), 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, Game::getInstance()->renderer()->getTVBO()));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, Game::getInstance()->renderer()->getTVBO());
 
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, UV.size() * sizeof(glm::vec2), &UV[0], GL_DYNAMIC_DRAW));
 
             GL_CHECK(glVertexAttribPointer(ResourceManager::getInstance()->shader("sprite")->getAttrib("TexCoord"), 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Game::getInstance()->renderer()->getEBO()));
+            GLState::getInstance()->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, Game::getInstance()->renderer()->getEBO());
 
             GL_CHECK(glEnableVertexAttribArray(ResourceManager::getInstance()->shader("sprite")->getAttrib("Position")));
 
@@ -12,10 +12,12 @@
 #include "../Event/State.h"
 #include "../Exception.h"
 #include "../Game/Game.h"
+#include "../Graphics/GLState.h"
 #include "../Graphics/Point.h"
 #include "../Graphics/Renderer.h"
 #include "../Graphics/IRendererConfig.h"
 #include "../Graphics/Shader.h"
+#include "../Graphics/SpriteBatch.h"
 #include "../Graphics/Texture.h"
 #include "../Input/Mouse.h"
 #include "../ResourceManager.h"
@@ -28,6 +30,16 @@ namespace Falltergeist
     {
         using Game::Game;
 
+        namespace
+        {
+            void GLAPIENTRY logDebugMessage(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length,
+                                            const GLchar* message, const void* userParam)
+            {
+                auto logger = static_cast<ILogger*>(const_cast<void*>(userParam));
+                logger->error() << "[RENDERER] " << "GL error " << id << ": " << message << std::endl;
+            }
+        }
+
         Renderer::Renderer(std::unique_ptr<IRendererConfig> rendererConfig, std::shared_ptr<ILogger> logger)
         {
             _rendererConfig = std::move(rendererConfig);
@@ -44,13 +56,15 @@ namespace Falltergeist
 
         Renderer::~Renderer()
         {
-            GL_CHECK(glDeleteBuffers(1, &_coord_vbo));
-            GL_CHECK(glDeleteBuffers(1, &_texcoord_vbo));
-            GL_CHECK(glDeleteBuffers(1, &_ebo));
+            _spriteBatch.reset();
+
+            GLState::getInstance()->deleteBuffers(1, &_coord_vbo);
+            GLState::getInstance()->deleteBuffers(1, &_texcoord_vbo);
+            GLState::getInstance()->deleteBuffers(1, &_ebo);
 
             if (_renderpath == RenderPath::OGL32)
             {
-                GL_CHECK(glDeleteVertexArrays(1, &_vao));
+                GLState::getInstance()->deleteVertexArrays(1, &_vao);
             }
         }
 
@@ -97,6 +111,9 @@ namespace Falltergeist
             SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 2);
             SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
             SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
+            #ifndef NDEBUG
+            SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_DEBUG_FLAG);
+            #endif
             _glcontext = SDL_GL_CreateContext(_sdlWindow);
 
             if (!_glcontext) {
@@ -188,6 +205,26 @@ namespace Falltergeist
             logger->info() << "[RENDERER] " << message + "[OK]" << std::endl;
             logger->info() << "[RENDERER] " << "Using GLEW " << glewGetString(GLEW_VERSION) << std::endl;
 
+            // bindings of the previous context, if any, mean nothing now
+            GLState::getInstance()->reset();
+
+            // rows of 8-bit indexed textures may have any length
+            GL_CHECK(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+            GL_CHECK(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+
+            if (GLEW_KHR_debug) {
+                GL_CHECK(glEnable(GL_DEBUG_OUTPUT));
+                #ifndef NDEBUG
+                // report errors from the call which caused them
+                GL_CHECK(glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS));
+                #endif
+                // only errors, performance hints of drivers would flood the log
+                GL_CHECK(glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_FALSE));
+                GL_CHECK(glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_ERROR, GL_DONT_CARE, 0, nullptr, GL_TRUE));
+                GL_CHECK(glDebugMessageCallback(logDebugMessage, this->logger.get()));
+                logger->info() << "[RENDERER] " << "GL errors are reported through KHR_debug" << std::endl;
+            }
+
             logger->info() << "[RENDERER] " << "Extensions: " << std::endl;
 
             if (_renderpath == RenderPath::OGL32) {
@@ -205,7 +242,7 @@ namespace Falltergeist
             ResourceManager::getInstance()->shader("default");
             ResourceManager::getInstance()->shader("sprite");
             ResourceManager::getInstance()->shader("font");
-            ResourceManager::getInstance()->shader("animation");
+            ResourceManager::getInstance()->shader("batch");
             ResourceManager::getInstance()->shader("tilemap");
             ResourceManager::getInstance()->shader("lightmap");
             logger->info() << "[RENDERER] " << "[OK]" << std::endl;
@@ -215,7 +252,7 @@ namespace Falltergeist
             if (_renderpath == RenderPath::OGL32) {
                 // generate VBOs for verts and tex
                 GL_CHECK(glGenVertexArrays(1, &_vao));
-                GL_CHECK(glBindVertexArray(_vao));
+                GLState::getInstance()->bindVertexArray(_vao);
             }
 
             GL_CHECK(glGenBuffers(1, &_coord_vbo));
@@ -223,10 +260,12 @@ namespace Falltergeist
 
             // pre-populate element buffer. 6 elements, because we draw as triangles
             GL_CHECK(glGenBuffers(1, &_ebo));
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
+            GLState::getInstance()->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
             GLushort indexes[6] = { 0, 1, 2, 3, 2, 1 };
             GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, 6*sizeof(GLushort), indexes, GL_STATIC_DRAW));
 
+            _spriteBatch = std::make_unique<SpriteBatch>(_renderpath);
+
             // generate projection matrix
             _MVP = glm::ortho(
                 0.0,
@@ -239,6 +278,7 @@ namespace Falltergeist
 
             // load egg
             _egg = ResourceManager::getInstance()->texture("data/egg.png");
+            ResourceManager::getInstance()->pinTexture("data/egg.png");
         }
 
         void Renderer::think(const float &deltaTime)
@@ -301,13 +341,14 @@ namespace Falltergeist
         void Renderer::beginFrame()
         {
             GL_CHECK(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
-            GL_CHECK(glEnable(GL_BLEND));
-            GL_CHECK(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+            GLState::getInstance()->setBlending(true);
+            GLState::getInstance()->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         }
 
         void Renderer::endFrame()
         {
-            GL_CHECK(glDisable(GL_BLEND));
+            _spriteBatch->flush();
+            GLState::getInstance()->setBlending(false);
             SDL_GL_SwapWindow(_sdlWindow);
         }
 
@@ -444,6 +485,8 @@ namespace Falltergeist
         {
             std::vector<glm::vec2> vertices;
 
+            _spriteBatch->flush();
+
             glm::vec4 fcolor = glm::vec4((float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f, (float)color.a/255.0f);
 
             vertices.push_back(glm::vec2((float)x, (float)y));
@@ -460,22 +503,16 @@ namespace Falltergeist
 
             if (_renderpath==RenderPath::OGL32)
             {
-                GLint curvao;
-                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &curvao);
-                GLint vao = getVAO();
-                if (curvao != vao)
-                {
-                    GL_CHECK(glBindVertexArray(vao));
-                }
+                GLState::getInstance()->bindVertexArray(getVAO());
             }
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, Game::getInstance()->renderer()->getVVBO()));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, Game::getInstance()->renderer()->getVVBO());
 
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec2), &vertices[0], GL_DYNAMIC_DRAW));
 
             GL_CHECK(glVertexAttribPointer(ResourceManager::getInstance()->shader("default")->getAttrib("Position"), 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Game::getInstance()->renderer()->getEBO()));
+            GLState::getInstance()->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, Game::getInstance()->renderer()->getEBO());
 
             GL_CHECK(glEnableVertexAttribArray(ResourceManager::getInstance()->shader("default")->getAttrib("Position")));
 
@@ -506,6 +543,11 @@ namespace Falltergeist
             return _egg;
         }
 
+        SpriteBatch* Renderer::spriteBatch()
+        {
+            return _spriteBatch.get();
+        }
+
         Renderer::RenderPath Renderer::renderPath()
         {
             return _renderpath;
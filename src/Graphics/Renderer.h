@@ -20,16 +20,24 @@ namespace Falltergeist
 {
     namespace Graphics
     {
+        class SpriteBatch;
         class Texture;
 
-        #define GL_CHECK(x) do { \
-            x; \
-            int _err = glGetError(); \
-            if (_err) { \
-                printf("GL Error %d at %d, %s in %s", _err, __LINE__, __func__, __FILE__); \
-                exit(-1); \
-            } \
-        } while (0)
+        // glGetError() waits for the driver, so release builds only log errors reported through KHR_debug
+        #ifdef NDEBUG
+            #define GL_CHECK(x) do { \
+                x; \
+            } while (0)
+        #else
+            #define GL_CHECK(x) do { \
+                x; \
+                int _err = glGetError(); \
+                if (_err) { \
+                    printf("GL Error %d at %d, %s in %s", _err, __LINE__, __func__, __FILE__); \
+                    exit(-1); \
+                } \
+            } while (0)
+        #endif
 
         class Renderer
         {
@@ -83,6 +91,9 @@ namespace Falltergeist
 
                 Texture* egg();
 
+                // sprites and animations are drawn through it
+                SpriteBatch* spriteBatch();
+
                 RenderPath renderPath();
 
             protected:
@@ -113,6 +124,8 @@ namespace Falltergeist
 
                 Texture* _egg;
 
+                std::unique_ptr<SpriteBatch> _spriteBatch;
+
             private:
                 std::unique_ptr<IRendererConfig> _rendererConfig;
                 std::shared_ptr<ILogger> logger;
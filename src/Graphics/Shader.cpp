@@ -2,6 +2,7 @@
 #include "../CrossPlatform.h"
 #include "../Exception.h"
 #include "../Game/Game.h"
+#include "../Graphics/GLState.h"
 #include "../Graphics/Renderer.h"
 #include "../Graphics/Shader.h"
 #include "../Logger.h"
@@ -37,7 +38,7 @@ namespace Falltergeist
 
             if (_progId)
             {
-                glDeleteProgram(_progId);
+                GLState::getInstance()->deleteProgram(_progId);
             }
         }
 
@@ -161,17 +162,12 @@ namespace Falltergeist
 
         void Shader::use()
         {
-            GLint cur;
-            glGetIntegerv(GL_CURRENT_PROGRAM, &cur);
-            if ((GLuint)cur!=_progId)
-            {
-                glUseProgram(_progId);
-            }
+            GLState::getInstance()->useProgram(_progId);
         }
 
         void Shader::unuse()
         {
-            glUseProgram(0);
+            GLState::getInstance()->useProgram(0);
         }
 
         GLuint Shader::id()
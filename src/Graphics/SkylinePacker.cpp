@@ -0,0 +1,125 @@
+#include <algorithm>
+#include "../Graphics/SkylinePacker.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        SkylinePacker::SkylinePacker(unsigned int width, unsigned int height) : _width(width), _height(height)
+        {
+            clear();
+        }
+
+        void SkylinePacker::clear()
+        {
+            _skyline.clear();
+            _skyline.push_back({0, 0, _width});
+            _usedArea = 0;
+        }
+
+        unsigned int SkylinePacker::width() const
+        {
+            return _width;
+        }
+
+        unsigned int SkylinePacker::height() const
+        {
+            return _height;
+        }
+
+        size_t SkylinePacker::usedArea() const
+        {
+            return _usedArea;
+        }
+
+        bool SkylinePacker::_fit(size_t index, unsigned int width, unsigned int height, unsigned int& y) const
+        {
+            if (_skyline[index].x + width > _width)
+            {
+                return false;
+            }
+
+            y = 0;
+            unsigned int left = width;
+            for (size_t i = index; left > 0; ++i)
+            {
+                y = std::max(y, _skyline[i].y);
+                if (y + height > _height)
+                {
+                    return false;
+                }
+                left -= std::min(left, _skyline[i].width);
+            }
+            return true;
+        }
+
+        bool SkylinePacker::insert(unsigned int width, unsigned int height, Point& position)
+        {
+            if (width == 0 || height == 0)
+            {
+                return false;
+            }
+
+            // bottom-left rule: the lowest top edge, then the narrowest segment
+            size_t best = _skyline.size();
+            unsigned int bestTop = _height + 1;
+            unsigned int bestWidth = 0;
+            for (size_t i = 0; i != _skyline.size(); ++i)
+            {
+                unsigned int y;
+                if (!_fit(i, width, height, y))
+                {
+                    continue;
+                }
+                if (y + height < bestTop || (y + height == bestTop && _skyline[i].width < bestWidth))
+                {
+                    best = i;
+                    bestTop = y + height;
+                    bestWidth = _skyline[i].width;
+                }
+            }
+            if (best == _skyline.size())
+            {
+                return false;
+            }
+
+            unsigned int x = _skyline[best].x;
+            position = Point(static_cast<int>(x), static_cast<int>(bestTop - height));
+            _skyline.insert(_skyline.begin() + best, {x, bestTop, width});
+
+            // cut segments covered by the new one
+            for (size_t i = best + 1; i < _skyline.size(); )
+            {
+                auto& segment = _skyline[i];
+                if (segment.x >= x + width)
+                {
+                    break;
+                }
+                unsigned int covered = x + width - segment.x;
+                if (covered >= segment.width)
+                {
+                    _skyline.erase(_skyline.begin() + i);
+                    continue;
+                }
+                segment.x += covered;
+                segment.width -= covered;
+                break;
+            }
+
+            // join neighbors of the same height
+            for (size_t i = 0; i + 1 < _skyline.size(); )
+            {
+                if (_skyline[i].y == _skyline[i + 1].y)
+                {
+                    _skyline[i].width += _skyline[i + 1].width;
+                    _skyline.erase(_skyline.begin() + i + 1);
+                    continue;
+                }
+                ++i;
+            }
+
+            _usedArea += static_cast<size_t>(width) * height;
+            return true;
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "../Graphics/Point.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        /**
+         * @brief Places rectangles inside a larger one
+         *
+         * Keeps the outline of the top edges of placed rectangles, the skyline,
+         * and puts each new rectangle where the skyline stays the lowest.
+         * Space can't be freed by rectangles one by one, only all at once with clear().
+         */
+        class SkylinePacker
+        {
+            public:
+                SkylinePacker(unsigned int width, unsigned int height);
+
+                // Returns false if there is no room for the rectangle
+                bool insert(unsigned int width, unsigned int height, Point& position);
+                void clear();
+
+                unsigned int width() const;
+                unsigned int height() const;
+                // total area of inserted rectangles
+                size_t usedArea() const;
+
+            private:
+                struct Segment
+                {
+                    unsigned int x;
+                    unsigned int y;
+                    unsigned int width;
+                };
+
+                unsigned int _width;
+                unsigned int _height;
+                size_t _usedArea = 0;
+                std::vector<Segment> _skyline;
+
+                // Lowest y at which rectangle starting at given segment fits, false if it doesn't fit at all
+                bool _fit(size_t index, unsigned int width, unsigned int height, unsigned int& y) const;
+        };
+    }
+}
@@ -1,9 +1,6 @@
-#include "../Game/DudeObject.h"
 #include "../Game/Game.h"
-#include "../Graphics/AnimatedPalette.h"
 #include "../Graphics/Sprite.h"
-#include "../LocationCamera.h"
-#include "../PathFinding/Hexagon.h"
+#include "../Graphics/SpriteBatch.h"
 #include "../ResourceManager.h"
 #include "../State/Location.h"
 
@@ -13,34 +10,21 @@ namespace Falltergeist
     {
         using Game::Game;
 
-        Sprite::Sprite(const std::string& fname)
+        Sprite::Sprite(const std::string& fname) : _filename(fname)
         {
             _texture = ResourceManager::getInstance()->texture(fname);
-            _shader = ResourceManager::getInstance()->shader("sprite");
-
-            _uniformTex = _shader->getUniform("tex");
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL21)
-            {
-                _uniformTexSize = _shader->getUniform("texSize");
-            }
-            _uniformEggTex = _shader->getUniform("eggTex");
-            _uniformFade = _shader->getUniform("fade");
-            _uniformMVP = _shader->getUniform("MVP");
-            _uniformCnt = _shader->getUniform("cnt");
-            _uniformLight = _shader->getUniform("global_light");
-            _uniformTrans = _shader->getUniform("trans");
-            _uniformDoEgg = _shader->getUniform("doegg");
-            _uniformEggPos = _shader->getUniform("eggpos");
-            _uniformOutline = _shader->getUniform("outline");
-
-            _attribPos = _shader->getAttrib("Position");
-            _attribTex = _shader->getAttrib("TexCoord");
+            ResourceManager::getInstance()->pinTexture(fname);
         }
 
         Sprite::Sprite(Format::Frm::File *frm) : Sprite(frm->filename())
         {
         }
 
+        Sprite::~Sprite()
+        {
+            ResourceManager::getInstance()->unpinTexture(_filename);
+        }
+
         Size Sprite::size() const
         {
             return _texture->size();
@@ -59,119 +43,16 @@ namespace Falltergeist
         // render, optionally scaled
         void Sprite::renderScaled(int x, int y, unsigned int width, unsigned int height, bool transparency, bool light, int outline, unsigned int lightValue)
         {
-            glm::vec2 vertices[4] = {
-                glm::vec2((float)x, (float)y),
-                glm::vec2((float)x, (float)(y + height)),
-                glm::vec2((float)(x + width), (float)y),
-                glm::vec2((float)(x + width), (float)(y + height))
-            };
-            glm::vec2 UV[4] = {
-                glm::vec2(0.0, 0.0),
-                glm::vec2(0.0, (float)_texture->height() / (float)_texture->textureHeight()),
-                glm::vec2((float)_texture->width() / (float)_texture->textureWidth(), 0.0),
-                glm::vec2((float)_texture->width() / (float)_texture->textureWidth(), (float)_texture->height() / (float)_texture->textureHeight())
-            };
-
-            x--;
-            y--;
-
-            glm::vec2 eggVec;
-            if (transparency)
-            {
-                auto dude = Game::getInstance()->player();
-                if (!dude || !Game::getInstance()->locationState()) {
-                    transparency = false;
-                }
-                else {
-                    auto camera = Game::getInstance()->locationState()->camera();
-                    Point eggPos = dude->hexagon()->position() - camera->topLeft() + dude->eggOffset();
-
-                    SDL_Rect egg_rect = {eggPos.x(), eggPos.y(), 129, 98};
-                    SDL_Rect tex_rect = {x, y, (int) _texture->width(), (int) _texture->height()};
-
-                    if (!SDL_HasIntersection(&egg_rect, &tex_rect)) {
-                        transparency = false;
-                    }
-                    else {
-                        eggVec = glm::vec2((float) (eggPos.x()-x), (float) (eggPos.y()-y));
-                    }
-                }
-            }
-
-            GL_CHECK(_shader->use());
-
-            GL_CHECK(_texture->bind(0));
-            GL_CHECK(Game::getInstance()->renderer()->egg()->bind(1));
-
-            GL_CHECK(_shader->setUniform(_uniformTex, 0));
-            GL_CHECK(_shader->setUniform(_uniformEggTex, 1));
-
-            GL_CHECK(_shader->setUniform(_uniformEggPos, eggVec));
-
-            GL_CHECK(_shader->setUniform(_uniformDoEgg, transparency));
-
-            GL_CHECK(_shader->setUniform(_uniformOutline, outline));
-
-
-            GL_CHECK(_shader->setUniform(_uniformFade, Game::getInstance()->renderer()->fadeColor()));
-
-            GL_CHECK(_shader->setUniform(_uniformMVP, Game::getInstance()->renderer()->getMVP()));
-
-            GL_CHECK(_shader->setUniform(_uniformCnt, Game::getInstance()->animatedPalette()->counters()));
-
-            int lightLevel = 100;
-            if (light)
-            {
-                if (auto state = Game::getInstance()->locationState())
-                {
-                    if (lightValue<=state->lightLevel()) lightValue=state->lightLevel();
-                    lightLevel = lightValue / ((65536-655)/100);
-                }
-            }
-            GL_CHECK(_shader->setUniform(_uniformLight, lightLevel));
-            GL_CHECK(_shader->setUniform(_uniformTrans, _trans));
-
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL21)
-            {
-                GL_CHECK(_shader->setUniform(_uniformTexSize, glm::vec2((float)_texture->textureWidth(), (float)_texture->textureHeight() )));
-            }
-
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
-            {
-                GLint curvao;
-                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &curvao);
-                GLint vao = Game::getInstance()->renderer()->getVAO();
-                if (curvao != vao)
-                {
-                    GL_CHECK(glBindVertexArray(vao));
-                }
-            }
-
-
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, Game::getInstance()->renderer()->getVVBO()));
-
-            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices[0], GL_DYNAMIC_DRAW));
-
-            GL_CHECK(glVertexAttribPointer(_attribPos, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
-
-
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, Game::getInstance()->renderer()->getTVBO()));
-
-            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, sizeof(UV), &UV[0], GL_DYNAMIC_DRAW));
-
-            GL_CHECK(glVertexAttribPointer(_attribTex, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
-
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Game::getInstance()->renderer()->getEBO()));
-
-            GL_CHECK(glEnableVertexAttribArray(_attribPos));
-
-            GL_CHECK(glEnableVertexAttribArray(_attribTex));
-
-            GL_CHECK(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0 ));
-
-            GL_CHECK(glDisableVertexAttribArray(_attribPos));
-
-            GL_CHECK(glDisableVertexAttribArray(_attribTex));
+            SpriteBatch::Quad quad;
+            quad.topLeft = glm::vec2((float)x, (float)y);
+            quad.bottomRight = glm::vec2((float)(x + width), (float)(y + height));
+            _textureRect(0, 0, _texture->width(), _texture->height(), quad);
+            quad.light = _lightLevel(light, lightValue);
+            quad.trans = _trans;
+            quad.outline = outline;
+            quad.egg = _egg(transparency);
+
+            Game::getInstance()->renderer()->spriteBatch()->add(_texture, quad);
         }
 
         void Sprite::render(int x, int y, bool transparency, bool light, int outline, unsigned int lightValue)
@@ -183,59 +64,31 @@ namespace Falltergeist
         void Sprite::renderCropped(int x, int y, int dx, int dy, unsigned int width, unsigned int height, bool transparency,
                                    bool light, unsigned int lightValue)
         {
-            glm::vec2 vertices[4] = {
-                glm::vec2((float)x, (float)y),
-                glm::vec2((float)x, (float)(y + height)),
-                glm::vec2((float)(x + width), (float)y),
-                glm::vec2((float)(x + width), (float)(y + height))
-            };
-            glm::vec2 UV[4] = {
-                glm::vec2((float)dx / (float)_texture->textureWidth(), (float)dy / (float)_texture->textureHeight()),
-                glm::vec2((float)dx / (float)_texture->textureWidth(), (float)(dy + height) / (float)_texture->textureHeight()),
-                glm::vec2((float)(dx + width) / (float)_texture->textureWidth(), (float)dy / (float)_texture->textureHeight()),
-                glm::vec2((float)(dx + width) / (float)_texture->textureWidth(), (float)(dy + height) / (float)_texture->textureHeight())
-            };
-
-            glm::vec2 eggVec;
-            if (transparency)
-            {
-                auto dude = Game::getInstance()->player();
-                if (!dude || !Game::getInstance()->locationState()) {
-                    transparency = false;
-                } else {
-                    auto camera = Game::getInstance()->locationState()->camera();
-                    Point eggPos = dude->hexagon()->position() - camera->topLeft() + dude->eggOffset();
-
-                    SDL_Rect egg_rect = {eggPos.x(), eggPos.y(), 129, 98};
-                    SDL_Rect tex_rect = {x, y, (int) _texture->width(), (int) _texture->height()};
-
-                    if (!SDL_HasIntersection(&egg_rect, &tex_rect))
-                    {
-                        transparency = false;
-                    }
-                    else
-                    {
-                        eggVec = glm::vec2((float) (eggPos.x() - x), (float) (eggPos.y() - y));
-                    }
-                }
-
-            }
-
-            GL_CHECK(_shader->use());
-
-            GL_CHECK(_texture->bind(0));
-            GL_CHECK(Game::getInstance()->renderer()->egg()->bind(1));
-
-            GL_CHECK(_shader->setUniform(_uniformTex, 0));
-            GL_CHECK(_shader->setUniform(_uniformEggTex, 1));
-
-            GL_CHECK(_shader->setUniform(_uniformFade, Game::getInstance()->renderer()->fadeColor()));
-
-            GL_CHECK(_shader->setUniform(_uniformMVP, Game::getInstance()->renderer()->getMVP()));
+            SpriteBatch::Quad quad;
+            quad.topLeft = glm::vec2((float)x, (float)y);
+            quad.bottomRight = glm::vec2((float)(x + width), (float)(y + height));
+            _textureRect(dx, dy, width, height, quad);
+            quad.light = _lightLevel(light, lightValue);
+            quad.trans = _trans;
+            quad.egg = _egg(transparency);
+
+            Game::getInstance()->renderer()->spriteBatch()->add(_texture, quad);
+        }
 
-            GL_CHECK(_shader->setUniform(_uniformCnt, Game::getInstance()->animatedPalette()->counters()));
+        // texture may be a part of atlas page, so coordinates are shifted by its origin
+        void Sprite::_textureRect(int x, int y, unsigned int width, unsigned int height, SpriteBatch::Quad& quad) const
+        {
+            float textureWidth = (float)_texture->textureWidth();
+            float textureHeight = (float)_texture->textureHeight();
+            x += _texture->origin().x();
+            y += _texture->origin().y();
+            quad.uvTopLeft = glm::vec2((float)x / textureWidth, (float)y / textureHeight);
+            quad.uvBottomRight = glm::vec2((float)(x + width) / textureWidth, (float)(y + height) / textureHeight);
+        }
 
-            int lightLevel = 100;
+        unsigned int Sprite::_lightLevel(bool light, unsigned int lightValue) const
+        {
+            unsigned int lightLevel = 100;
             if (light)
             {
                 if (auto state = Game::getInstance()->locationState())
@@ -244,52 +97,13 @@ namespace Falltergeist
                     lightLevel = lightValue / ((65536-655)/100);
                 }
             }
-            GL_CHECK(_shader->setUniform(_uniformLight, lightLevel));
-
-            GL_CHECK(_shader->setUniform(_uniformTrans, _trans));
-
-            GL_CHECK(_shader->setUniform(_uniformEggPos, eggVec));
-
-            GL_CHECK(_shader->setUniform(_uniformDoEgg, transparency));
-
-            GL_CHECK(_shader->setUniform(_uniformOutline, false));
-
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL21) {
-                GL_CHECK(_shader->setUniform(_uniformTexSize, glm::vec2((float)_texture->textureWidth(), (float)_texture->textureHeight() )));
-            }
-
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32) {
-                GLint curvao;
-                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &curvao);
-                GLint vao = Game::getInstance()->renderer()->getVAO();
-                if (curvao != vao) {
-                    GL_CHECK(glBindVertexArray(vao));
-                }
-            }
-
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, Game::getInstance()->renderer()->getVVBO()));
-
-            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices[0], GL_DYNAMIC_DRAW));
-
-            GL_CHECK(glVertexAttribPointer(_attribPos, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
-
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, Game::getInstance()->renderer()->getTVBO()));
-
-            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, sizeof(UV), &UV[0], GL_DYNAMIC_DRAW));
-
-            GL_CHECK(glVertexAttribPointer(_attribTex, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
-
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Game::getInstance()->renderer()->getEBO()));
-
-            GL_CHECK(glEnableVertexAttribArray(_attribPos));
-
-            GL_CHECK(glEnableVertexAttribArray(_attribTex));
-
-            GL_CHECK(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0 ));
-
-            GL_CHECK(glDisableVertexAttribArray(_attribPos));
+            return lightLevel;
+        }
 
-            GL_CHECK(glDisableVertexAttribArray(_attribTex));
+        // sprites are cut by the egg only when there is someone to cut them around
+        bool Sprite::_egg(bool transparency) const
+        {
+            return transparency && Game::getInstance()->player() && Game::getInstance()->locationState();
         }
 
         bool Sprite::opaque(unsigned int x, unsigned int y)
@@ -3,7 +3,7 @@
 #include <string>
 #include "../Format/Frm/File.h"
 #include "../Graphics/Point.h"
-#include "../Graphics/Shader.h"
+#include "../Graphics/SpriteBatch.h"
 #include "../Graphics/Texture.h"
 #include "../Graphics/TransFlags.h"
 
@@ -16,6 +16,11 @@ namespace Falltergeist
             public:
                 Sprite(const std::string& filename);
                 Sprite(Format::Frm::File* frm);
+                ~Sprite();
+
+                Sprite(const Sprite&) = delete;
+                Sprite& operator= (const Sprite&) = delete;
+
                 void renderScaled(int x, int y, unsigned int width, unsigned int height, bool transparency = false,
                                   bool light = false, int outline = 0, unsigned int lightValue=0);
                 void render(int x, int y, bool transparency = false, bool light = false, int outline = 0, unsigned int lightValue=0);
@@ -28,23 +33,13 @@ namespace Falltergeist
                 void trans(Graphics::TransFlags::Trans _trans);
 
             private:
-                GLint _uniformTex;
-                GLint _uniformTexSize;
-                GLint _uniformEggTex;
-                GLint _uniformFade;
-                GLint _uniformMVP;
-                GLint _uniformCnt;
-                GLint _uniformLight;
-                GLint _uniformTrans;
-                GLint _uniformDoEgg;
-                GLint _uniformEggPos;
-                GLint _uniformOutline;
-
-                GLint _attribPos;
-                GLint _attribTex;
                 Texture* _texture;
+                std::string _filename;
                 Graphics::TransFlags::Trans _trans = Graphics::TransFlags::Trans::NONE;
-                Graphics::Shader*_shader;
+
+                void _textureRect(int x, int y, unsigned int width, unsigned int height, SpriteBatch::Quad& quad) const;
+                unsigned int _lightLevel(bool light, unsigned int lightValue) const;
+                bool _egg(bool transparency) const;
         };
     }
 }
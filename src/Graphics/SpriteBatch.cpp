@@ -0,0 +1,219 @@
+#include <cstddef>
+#include "../Game/DudeObject.h"
+#include "../Game/Game.h"
+#include "../Graphics/AnimatedPalette.h"
+#include "../Graphics/GLState.h"
+#include "../Graphics/SpriteBatch.h"
+#include "../Graphics/Texture.h"
+#include "../LocationCamera.h"
+#include "../PathFinding/Hexagon.h"
+#include "../ResourceManager.h"
+#include "../State/Location.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        using Game::Game;
+
+        SpriteBatch::SpriteBatch(Renderer::RenderPath renderPath, unsigned int capacity) : _renderPath(renderPath), _capacity(capacity)
+        {
+            // indexes must fit GLushort
+            if (_capacity > 0x4000)
+            {
+                _capacity = 0x4000;
+            }
+
+            _vertices.reserve(_capacity * 4);
+
+            if (_renderPath == Renderer::RenderPath::OGL32)
+            {
+                GL_CHECK(glGenVertexArrays(1, &_vao));
+                GLState::getInstance()->bindVertexArray(_vao);
+            }
+
+            GL_CHECK(glGenBuffers(1, &_vbo));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, _vbo);
+            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, _capacity * 4 * sizeof(Vertex), nullptr, GL_STREAM_DRAW));
+
+            // quads are always drawn as two triangles, so indexes never change
+            std::vector<GLushort> indexes;
+            indexes.reserve(_capacity * 6);
+            for (unsigned int i = 0; i != _capacity; ++i)
+            {
+                GLushort vertex = static_cast<GLushort>(i * 4);
+                indexes.push_back(vertex);
+                indexes.push_back(vertex + 1);
+                indexes.push_back(vertex + 2);
+                indexes.push_back(vertex + 3);
+                indexes.push_back(vertex + 2);
+                indexes.push_back(vertex + 1);
+            }
+            GL_CHECK(glGenBuffers(1, &_ebo));
+            GLState::getInstance()->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
+            GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexes.size() * sizeof(GLushort), &indexes[0], GL_STATIC_DRAW));
+
+            _shader = ResourceManager::getInstance()->shader("batch");
+
+            _uniformTex = _shader->getUniform("tex");
+            if (_renderPath == Renderer::RenderPath::OGL21)
+            {
+                _uniformTexSize = _shader->getUniform("texSize");
+            }
+            _uniformEggTex = _shader->getUniform("eggTex");
+            _uniformEggPos = _shader->getUniform("eggpos");
+            _uniformFade = _shader->getUniform("fade");
+            _uniformMVP = _shader->getUniform("MVP");
+            _uniformPalette = _shader->getUniform("palette");
+            _uniformIndexed = _shader->getUniform("indexed");
+
+            _attribPos = _shader->getAttrib("Position");
+            _attribTex = _shader->getAttrib("TexCoord");
+            _attribFrame = _shader->getAttrib("Frame");
+            _attribParams = _shader->getAttrib("Params");
+        }
+
+        SpriteBatch::~SpriteBatch()
+        {
+            GLState::getInstance()->deleteBuffers(1, &_vbo);
+            GLState::getInstance()->deleteBuffers(1, &_ebo);
+
+            if (_renderPath == Renderer::RenderPath::OGL32)
+            {
+                GLState::getInstance()->deleteVertexArrays(1, &_vao);
+            }
+        }
+
+        void SpriteBatch::add(Texture* texture, const Quad& quad)
+        {
+            if (_vertices.size() == _capacity * 4)
+            {
+                flush();
+            }
+
+            // textures packed into one atlas page share a run
+            if (_runs.empty() || _runs.back().texture != texture->id())
+            {
+                Run run;
+                run.texture = texture->id();
+                run.textureSize = glm::vec2((float)texture->textureWidth(), (float)texture->textureHeight());
+                run.indexed = texture->indexed();
+                run.first = static_cast<unsigned int>(_vertices.size() / 4);
+                run.count = 0;
+                _runs.push_back(run);
+            }
+            _runs.back().count++;
+
+            Vertex vertex;
+            vertex.frame = glm::vec2(quad.frameStart, quad.frameHeight);
+            vertex.params[0] = static_cast<GLubyte>(quad.light);
+            vertex.params[1] = static_cast<GLubyte>(quad.trans);
+            vertex.params[2] = static_cast<GLubyte>(quad.outline);
+            vertex.params[3] = quad.egg ? 1 : 0;
+
+            // the same order as the quad of Renderer::getEBO()
+            vertex.position = quad.topLeft;
+            vertex.uv = quad.uvTopLeft;
+            _vertices.push_back(vertex);
+
+            vertex.position = glm::vec2(quad.topLeft.x, quad.bottomRight.y);
+            vertex.uv = glm::vec2(quad.uvTopLeft.x, quad.uvBottomRight.y);
+            _vertices.push_back(vertex);
+
+            vertex.position = glm::vec2(quad.bottomRight.x, quad.topLeft.y);
+            vertex.uv = glm::vec2(quad.uvBottomRight.x, quad.uvTopLeft.y);
+            _vertices.push_back(vertex);
+
+            vertex.position = quad.bottomRight;
+            vertex.uv = quad.uvBottomRight;
+            _vertices.push_back(vertex);
+        }
+
+        void SpriteBatch::flush()
+        {
+            if (_runs.empty())
+            {
+                return;
+            }
+
+            auto renderer = Game::getInstance()->renderer();
+            auto quads = static_cast<unsigned int>(_vertices.size() / 4);
+
+            GL_CHECK(_shader->use());
+
+            GL_CHECK(renderer->egg()->bind(1));
+            Game::getInstance()->animatedPalette()->bindPalette(2);
+            GL_CHECK(_shader->setUniform(_uniformTex, 0));
+            GL_CHECK(_shader->setUniform(_uniformEggTex, 1));
+            GL_CHECK(_shader->setUniform(_uniformPalette, 2));
+            GL_CHECK(_shader->setUniform(_uniformEggPos, _eggPosition()));
+            GL_CHECK(_shader->setUniform(_uniformFade, renderer->fadeColor()));
+            GL_CHECK(_shader->setUniform(_uniformMVP, renderer->getMVP()));
+
+            if (_renderPath == Renderer::RenderPath::OGL32)
+            {
+                GLState::getInstance()->bindVertexArray(_vao);
+            }
+
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, _vbo);
+            // when the buffer is full, orphan it instead of waiting for draws that still read it
+            if (_written + quads > _capacity)
+            {
+                GL_CHECK(glBufferData(GL_ARRAY_BUFFER, _capacity * 4 * sizeof(Vertex), nullptr, GL_STREAM_DRAW));
+                _written = 0;
+            }
+            size_t offset = _written * 4 * sizeof(Vertex);
+            GL_CHECK(glBufferSubData(GL_ARRAY_BUFFER, offset, _vertices.size() * sizeof(Vertex), &_vertices[0]));
+
+            GL_CHECK(glVertexAttribPointer(_attribPos, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offset + offsetof(Vertex, position))));
+            GL_CHECK(glVertexAttribPointer(_attribTex, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offset + offsetof(Vertex, uv))));
+            GL_CHECK(glVertexAttribPointer(_attribFrame, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offset + offsetof(Vertex, frame))));
+            GL_CHECK(glVertexAttribPointer(_attribParams, 4, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(Vertex), (void*)(offset + offsetof(Vertex, params))));
+
+            GLState::getInstance()->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
+
+            GL_CHECK(glEnableVertexAttribArray(_attribPos));
+            GL_CHECK(glEnableVertexAttribArray(_attribTex));
+            GL_CHECK(glEnableVertexAttribArray(_attribFrame));
+            GL_CHECK(glEnableVertexAttribArray(_attribParams));
+
+            int indexed = -1;
+            for (auto& run : _runs)
+            {
+                GLState::getInstance()->bindTexture(0, run.texture);
+                if (indexed != (int)run.indexed)
+                {
+                    indexed = run.indexed;
+                    GL_CHECK(_shader->setUniform(_uniformIndexed, indexed));
+                }
+                if (_renderPath == Renderer::RenderPath::OGL21)
+                {
+                    GL_CHECK(_shader->setUniform(_uniformTexSize, run.textureSize));
+                }
+                GL_CHECK(glDrawElements(GL_TRIANGLES, run.count * 6, GL_UNSIGNED_SHORT, (void*)(run.first * 6 * sizeof(GLushort))));
+            }
+
+            GL_CHECK(glDisableVertexAttribArray(_attribPos));
+            GL_CHECK(glDisableVertexAttribArray(_attribTex));
+            GL_CHECK(glDisableVertexAttribArray(_attribFrame));
+            GL_CHECK(glDisableVertexAttribArray(_attribParams));
+
+            _written += quads;
+            _vertices.clear();
+            _runs.clear();
+        }
+
+        // top left corner of the egg around the player on screen
+        glm::vec2 SpriteBatch::_eggPosition() const
+        {
+            auto dude = Game::getInstance()->player();
+            auto state = Game::getInstance()->locationState();
+            if (!dude || !state || !dude->hexagon())
+            {
+                return glm::vec2();
+            }
+            Point eggPos = dude->hexagon()->position() - state->camera()->topLeft() + dude->eggOffset();
+            return glm::vec2((float)eggPos.x(), (float)eggPos.y());
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "../Graphics/Renderer.h"
+#include "../Graphics/Shader.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        class Texture;
+
+        /**
+         * @brief Collects textured quads of sprites and animations and draws them with few draw calls
+         *
+         * Quads keep their own light, trans flags and outline as vertex attributes, so they don't need uniforms.
+         * They are drawn in the order they were added, consecutive quads of one texture share a draw call.
+         * Vertices are streamed into one persistent buffer which is orphaned only when it's full.
+         * Anything drawn not through the batch has to flush() it first.
+         */
+        class SpriteBatch
+        {
+            public:
+                struct Quad
+                {
+                    // screen rectangle
+                    glm::vec2 topLeft;
+                    glm::vec2 bottomRight;
+                    // texture rectangle
+                    glm::vec2 uvTopLeft;
+                    glm::vec2 uvBottomRight;
+                    // 0..100
+                    unsigned int light = 100;
+                    unsigned int trans = 0;
+                    int outline = 0;
+                    bool egg = false;
+                    // vertical span of animation frame in the texture, used by animated outline
+                    float frameStart = 0;
+                    float frameHeight = 0;
+                };
+
+                SpriteBatch(Renderer::RenderPath renderPath, unsigned int capacity = 4096);
+                ~SpriteBatch();
+
+                SpriteBatch(const SpriteBatch&) = delete;
+                SpriteBatch& operator= (const SpriteBatch&) = delete;
+
+                void add(Texture* texture, const Quad& quad);
+                void flush();
+
+            private:
+                struct Vertex
+                {
+                    glm::vec2 position;
+                    glm::vec2 uv;
+                    glm::vec2 frame;
+                    // light, trans, outline, egg
+                    GLubyte params[4];
+                };
+
+                // textures may be destroyed before the batch is flushed, so runs keep only what they need of them
+                struct Run
+                {
+                    GLuint texture;
+                    glm::vec2 textureSize;
+                    bool indexed;
+                    unsigned int first;
+                    unsigned int count;
+                };
+
+                Renderer::RenderPath _renderPath;
+                unsigned int _capacity;
+                // quads already written to the buffer since it was orphaned
+                unsigned int _written = 0;
+                std::vector<Vertex> _vertices;
+                std::vector<Run> _runs;
+
+                GLuint _vao = 0;
+                GLuint _vbo = 0;
+                GLuint _ebo = 0;
+
+                Shader* _shader = nullptr;
+                GLint _uniformTex;
+                GLint _uniformTexSize;
+                GLint _uniformEggTex;
+                GLint _uniformEggPos;
+                GLint _uniformFade;
+                GLint _uniformMVP;
+                GLint _uniformPalette;
+                GLint _uniformIndexed;
+
+                GLint _attribPos;
+                GLint _attribTex;
+                GLint _attribFrame;
+                GLint _attribParams;
+
+                glm::vec2 _eggPosition() const;
+        };
+    }
+}
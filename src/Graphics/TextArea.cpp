@@ -3,6 +3,8 @@
 #include "../CrossPlatform.h"
 #include "../Event/Mouse.h"
 #include "../Game/Game.h"
+#include "../Graphics/GLState.h"
+#include "../Graphics/SpriteBatch.h"
 #include "../Graphics/TextArea.h"
 #include "../ResourceManager.h"
 
@@ -17,14 +19,14 @@ namespace Falltergeist
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
                 GL_CHECK(glGenVertexArrays(1, &_vao));
-                GL_CHECK(glBindVertexArray(_vao));
+                GLState::getInstance()->bindVertexArray(_vao);
             }
 
             // generate VBOs for verts and tex
             GL_CHECK(glGenBuffers(1, &_coords));
             GL_CHECK(glGenBuffers(1, &_texCoords));
             GL_CHECK(glGenBuffers(1, &_ebo));
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
+            GLState::getInstance()->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
         //    GL_CHECK(glBindVertexArray(0));
 
             _shader = ResourceManager::getInstance()->shader("font");
@@ -46,12 +48,12 @@ namespace Falltergeist
 
         TextArea::~TextArea()
         {
-            GL_CHECK(glDeleteBuffers(1, &_coords));
-            GL_CHECK(glDeleteBuffers(1, &_texCoords));
-            GL_CHECK(glDeleteBuffers(1, &_ebo));
+            GLState::getInstance()->deleteBuffers(1, &_coords);
+            GLState::getInstance()->deleteBuffers(1, &_texCoords);
+            GLState::getInstance()->deleteBuffers(1, &_ebo);
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
-                GL_CHECK(glDeleteVertexArrays(1, &_vao));
+                GLState::getInstance()->deleteVertexArrays(1, &_vao);
             }
         }
 
@@ -63,6 +65,9 @@ namespace Falltergeist
                 return;
             }
 
+            // text has its own shader, so sprites queued before it are drawn first
+            Game::getInstance()->renderer()->spriteBatch()->flush();
+
             GL_CHECK(_shader->use());
 
             GL_CHECK(font->texture()->bind(0));
@@ -81,22 +86,17 @@ namespace Falltergeist
 
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
-                GLint curvao;
-                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &curvao);
-                if ((GLuint)curvao != _vao)
-                {
-                    GL_CHECK(glBindVertexArray(_vao));
-                }
+                GLState::getInstance()->bindVertexArray(_vao);
             }
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _coords));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, _coords);
             GL_CHECK(glVertexAttribPointer(_attribPos, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _texCoords));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, _texCoords);
             GL_CHECK(glVertexAttribPointer(_attribTex, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
+            GLState::getInstance()->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
 
             GL_CHECK(glEnableVertexAttribArray(_attribPos));
             GL_CHECK(glEnableVertexAttribArray(_attribTex));
@@ -118,26 +118,21 @@ namespace Falltergeist
 
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
-                GLint curvao;
-                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &curvao);
-                if ((GLuint)curvao != _vao)
-                {
-                    GL_CHECK(glBindVertexArray(_vao));
-                }
+                GLState::getInstance()->bindVertexArray(_vao);
             }
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _coords));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, _coords);
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec2), &vertices[0], GL_DYNAMIC_DRAW));
 
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _texCoords));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, _texCoords);
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, UV.size() * sizeof(glm::vec2), &UV[0], GL_DYNAMIC_DRAW));
 
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
+            GLState::getInstance()->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
             GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexes.size() * sizeof(GLushort), &indexes[0], GL_DYNAMIC_DRAW));
 
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, 0));
+            GLState::getInstance()->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, 0);
         }
     }
 }
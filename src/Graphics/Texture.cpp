@@ -1,6 +1,10 @@
-﻿#include "../Exception.h"
+﻿#include <utility>
+#include "../Exception.h"
 #include "../Game/Game.h"
+#include "../Graphics/GLState.h"
+#include "../Graphics/Renderer.h"
 #include "../Graphics/Texture.h"
+#include "../Graphics/TextureAtlas.h"
 
 namespace Falltergeist
 {
@@ -33,11 +37,22 @@ namespace Falltergeist
             loadFromSurface(surface);
         }
 
+        Texture::Texture(TextureAtlas* atlas, unsigned int width, unsigned int height) : _atlas(atlas), _textureID(0), _size(width, height)
+        {
+            _width = width;
+            _height = height;
+            _indexed = true;
+        }
+
         Texture::~Texture()
         {
-            if (_textureID > 0)
+            if (_atlas)
             {
-                glDeleteTextures(1, &_textureID);
+                _atlas->_release(this);
+            }
+            else if (_textureID > 0)
+            {
+                GLState::getInstance()->deleteTextures(1, &_textureID);
                 _textureID = 0;
             }
         }
@@ -52,6 +67,21 @@ namespace Falltergeist
             return _height;
         }
 
+        size_t Texture::memoryUsage() const
+        {
+            size_t bytesPerPixel = _indexed ? 1 : 4;
+            if (_atlas)
+            {
+                return static_cast<size_t>(_width) * _height * bytesPerPixel + _mask.memoryUsage();
+            }
+            return static_cast<size_t>(_textureWidth) * _textureHeight * bytesPerPixel + _mask.memoryUsage();
+        }
+
+        bool Texture::indexed() const
+        {
+            return _indexed;
+        }
+
         unsigned int Texture::textureWidth() const
         {
             return _textureWidth;
@@ -62,6 +92,16 @@ namespace Falltergeist
             return _textureHeight;
         }
 
+        const Point& Texture::origin() const
+        {
+            return _origin;
+        }
+
+        GLuint Texture::id() const
+        {
+            return _textureID;
+        }
+
         Size Texture::size() const
         {
             return _size;
@@ -101,7 +141,7 @@ namespace Falltergeist
             SDL_SetSurfaceBlendMode( surface, SDL_BLENDMODE_NONE );
             SDL_BlitSurface(surface, &area, resizedSurface, &area);
 
-            glBindTexture(GL_TEXTURE_2D, _textureID);
+            GLState::getInstance()->bindTexture(0, _textureID);
 
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, resizedSurface->w, resizedSurface->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, resizedSurface->pixels);
 
@@ -143,6 +183,44 @@ namespace Falltergeist
             SDL_FreeSurface(tempSurf);
         }
 
+        void Texture::loadFromIndexes(const uint8_t* data)
+        {
+            unsigned int newWidth = NearestPowerOf2(_width);
+            unsigned int newHeight = NearestPowerOf2(_height);
+
+            GLint internalFormat;
+            GLenum format;
+            _indexFormat(internalFormat, format);
+
+            GLState::getInstance()->bindTexture(0, _textureID);
+
+            // index 0 is transparent, so the padding up to power of two stays invisible
+            std::vector<uint8_t> transparent(static_cast<size_t>(newWidth) * newHeight, 0);
+            glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, newWidth, newHeight, 0, format, GL_UNSIGNED_BYTE, transparent.data());
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _width, _height, format, GL_UNSIGNED_BYTE, data);
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+            _textureWidth = newWidth;
+            _textureHeight = newHeight;
+            _indexed = true;
+        }
+
+        void Texture::_indexFormat(GLint& internalFormat, GLenum& format)
+        {
+            if (Game::Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
+            {
+                internalFormat = GL_R8;
+                format = GL_RED;
+            }
+            else
+            {
+                internalFormat = GL_LUMINANCE8;
+                format = GL_LUMINANCE;
+            }
+        }
+
         void Texture::bind(uint8_t unit)
         {
         /*    if (unit > GL_MAX_TEXTURE_UNITS)
@@ -151,22 +229,9 @@ namespace Falltergeist
                 return;
             }
         */
-            GLint curunit;
-            GLint curtexture;
-
             if (_textureID > 0)
             {
-                glGetIntegerv(GL_ACTIVE_TEXTURE, &curunit);
-                glGetIntegerv(GL_TEXTURE_BINDING_2D, &curtexture);
-
-                if (curunit != GL_TEXTURE0+unit)
-                {
-                    glActiveTexture(GL_TEXTURE0+unit);
-                }
-                if (curunit != GL_TEXTURE0+unit || (GLuint)curtexture != _textureID)
-                {
-                    glBindTexture(GL_TEXTURE_2D, _textureID);
-                }
+                GLState::getInstance()->bindTexture(unit, _textureID);
             }
         }
 
@@ -180,23 +245,27 @@ namespace Falltergeist
         */
             if (_textureID > 0)
             {
-                glActiveTexture(GL_TEXTURE0+unit);
-                glBindTexture(GL_TEXTURE_2D, 0);
+                GLState::getInstance()->bindTexture(unit, 0);
             }
         }
 
         bool Texture::opaque(unsigned int x, unsigned int y)
         {
-            if (x >= width() || y >= height() || y*width() + x >= _mask.size()) {
+            if (x >= width() || y >= height()) {
                 return false;
             }
 
-            return _mask.at(y * width() + x);
+            return _mask.get(x, y);
+        }
+
+        bool Texture::opaque(int x, int y, int width, int height) const
+        {
+            return _mask.any(x, y, width, height);
         }
 
-        void Texture::setMask(std::vector<bool> mask)
+        void Texture::setMask(Base::Bitmask mask)
         {
-            _mask = mask;
+            _mask = std::move(mask);
         }
     }
 }
@@ -9,6 +9,7 @@
 #endif
 #include <SDL.h>
 #include <SDL_opengl.h>
+#include "../Base/Bitmask.h"
 #include "../Graphics/Point.h"
 #include "../Graphics/Size.h"
 
@@ -16,6 +17,8 @@ namespace Falltergeist
 {
     namespace Graphics
     {
+        class TextureAtlas;
+
         class Texture
         {
             public:
@@ -26,22 +29,44 @@ namespace Falltergeist
                 unsigned int width() const;
                 unsigned int height() const;
 
+                // size of the GL texture, which is the whole page for textures packed into atlas
                 unsigned int textureWidth() const;
                 unsigned int textureHeight() const;
+                // top left corner of the image in the GL texture
+                const Point& origin() const;
+                GLuint id() const;
 
                 void loadFromSurface(SDL_Surface* surface);
                 void loadFromRGB(unsigned int* data);
                 void loadFromRGBA(unsigned int* data);
+                // 8-bit palette indexes, colors are looked up in the palette texture when drawing
+                void loadFromIndexes(const uint8_t* data);
+                bool indexed() const;
 
                 void bind(uint8_t unit=0);
                 void unbind(uint8_t unit=0);
 
                 bool opaque(unsigned int x, unsigned int y);
-                void setMask(std::vector<bool> mask);
+                // Whether any pixel of the rectangle is opaque, parts outside the image are ignored
+                bool opaque(int x, int y, int width, int height) const;
+                void setMask(Base::Bitmask mask);
 
                 Size size() const;
 
+                // approximate number of bytes occupied by texture in video memory along with its mask
+                size_t memoryUsage() const;
+
             protected:
+                friend class TextureAtlas;
+
+                // Image on a page of atlas, pixels are uploaded by the atlas
+                Texture(TextureAtlas* atlas, unsigned int width, unsigned int height);
+
+                // single channel formats for palette indexes, GL 2.1 has no GL_RED textures
+                static void _indexFormat(GLint& internalFormat, GLenum& format);
+
+                TextureAtlas* _atlas = nullptr;
+                Point _origin;
                 GLuint _textureID;
                 unsigned int _width = 0;
                 unsigned int _height = 0;
@@ -49,7 +74,8 @@ namespace Falltergeist
 
                 unsigned int _textureWidth = 0;
                 unsigned int _textureHeight = 0;
-                std::vector<bool> _mask;
+                bool _indexed = false;
+                Base::Bitmask _mask;
         };
     }
 }
@@ -0,0 +1,253 @@
+#include <algorithm>
+#include "../Game/Game.h"
+#include "../Graphics/GLState.h"
+#include "../Graphics/Renderer.h"
+#include "../Graphics/SpriteBatch.h"
+#include "../Graphics/TextureAtlas.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        using Game::Game;
+
+        TextureAtlas::TextureAtlas(unsigned int pageSize) : _pageSize(pageSize)
+        {
+        }
+
+        TextureAtlas::~TextureAtlas()
+        {
+            for (auto& page : _pages)
+            {
+                GLState::getInstance()->deleteTextures(1, &page->id);
+            }
+        }
+
+        size_t TextureAtlas::pageCount() const
+        {
+            return _pages.size();
+        }
+
+        unsigned int TextureAtlas::pageSize() const
+        {
+            return _pageSize;
+        }
+
+        std::unique_ptr<Texture> TextureAtlas::add(unsigned int width, unsigned int height, const uint8_t* indexes)
+        {
+            if (width + 2 * PADDING > _pageSize || height + 2 * PADDING > _pageSize)
+            {
+                return nullptr;
+            }
+
+            std::unique_ptr<Texture> texture(new Texture(this, width, height));
+
+            Page* target = nullptr;
+            for (auto& page : _pages)
+            {
+                if (_place(page.get(), texture.get()))
+                {
+                    target = page.get();
+                    break;
+                }
+            }
+
+            // pages are full, but the one which lost most of its textures may have enough room after repacking
+            if (!target)
+            {
+                Page* wasteful = nullptr;
+                size_t mostWasted = 0;
+                for (auto& page : _pages)
+                {
+                    size_t wasted = page->packer.usedArea() - page->liveArea;
+                    if (wasted > mostWasted)
+                    {
+                        wasteful = page.get();
+                        mostWasted = wasted;
+                    }
+                }
+                if (wasteful && mostWasted >= _paddedArea(texture.get()))
+                {
+                    _repack(wasteful);
+                    if (_place(wasteful, texture.get()))
+                    {
+                        target = wasteful;
+                    }
+                }
+            }
+
+            if (!target)
+            {
+                target = _newPage();
+                _place(target, texture.get());
+            }
+
+            _upload(target, texture->_origin, width, height, indexes);
+            return texture;
+        }
+
+        TextureAtlas::Page* TextureAtlas::_newPage()
+        {
+            auto page = std::make_unique<Page>(_pageSize);
+
+            GLint internalFormat;
+            GLenum format;
+            Texture::_indexFormat(internalFormat, format);
+
+            GL_CHECK(glGenTextures(1, &page->id));
+            GLState::getInstance()->bindTexture(0, page->id);
+            GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, _pageSize, _pageSize, 0, format, GL_UNSIGNED_BYTE, page->pixels.data()));
+            GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+            GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+
+            _pages.push_back(std::move(page));
+            return _pages.back().get();
+        }
+
+        size_t TextureAtlas::_paddedArea(const Texture* texture) const
+        {
+            return static_cast<size_t>(texture->_width + 2 * PADDING) * (texture->_height + 2 * PADDING);
+        }
+
+        bool TextureAtlas::_place(Page* page, Texture* texture)
+        {
+            Point position;
+            if (!page->packer.insert(texture->_width + 2 * PADDING, texture->_height + 2 * PADDING, position))
+            {
+                return false;
+            }
+
+            texture->_origin = position + Point(PADDING, PADDING);
+            texture->_textureID = page->id;
+            texture->_textureWidth = _pageSize;
+            texture->_textureHeight = _pageSize;
+
+            page->textures.push_back(texture);
+            page->liveArea += _paddedArea(texture);
+            return true;
+        }
+
+        void TextureAtlas::_upload(Page* page, const Point& position, unsigned int width, unsigned int height, const uint8_t* indexes)
+        {
+            for (unsigned int y = 0; y != height; ++y)
+            {
+                std::copy(indexes + y * width, indexes + (y + 1) * width, page->pixels.begin() + (position.y() + y) * _pageSize + position.x());
+            }
+
+            GLint internalFormat;
+            GLenum format;
+            Texture::_indexFormat(internalFormat, format);
+
+            GLState::getInstance()->bindTexture(0, page->id);
+            GL_CHECK(glTexSubImage2D(GL_TEXTURE_2D, 0, position.x(), position.y(), width, height, format, GL_UNSIGNED_BYTE, indexes));
+        }
+
+        void TextureAtlas::_uploadPage(Page* page)
+        {
+            GLint internalFormat;
+            GLenum format;
+            Texture::_indexFormat(internalFormat, format);
+
+            GLState::getInstance()->bindTexture(0, page->id);
+            GL_CHECK(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _pageSize, _pageSize, format, GL_UNSIGNED_BYTE, page->pixels.data()));
+        }
+
+        void TextureAtlas::_repack(Page* page)
+        {
+            // queued sprites still refer to old places of textures
+            Game::getInstance()->renderer()->spriteBatch()->flush();
+
+            std::vector<uint8_t> pixels(page->pixels.size(), 0);
+            pixels.swap(page->pixels);
+
+            std::vector<Texture*> textures;
+            textures.swap(page->textures);
+            std::sort(textures.begin(), textures.end(), [](const Texture* a, const Texture* b) {
+                return a->_height > b->_height;
+            });
+            page->packer.clear();
+            page->liveArea = 0;
+
+            std::vector<std::pair<Texture*, Point>> homeless;
+            for (auto texture : textures)
+            {
+                Point old = texture->_origin;
+                if (!_place(page, texture))
+                {
+                    homeless.emplace_back(texture, old);
+                    continue;
+                }
+                for (unsigned int y = 0; y != texture->_height; ++y)
+                {
+                    auto from = pixels.begin() + (old.y() + y) * _pageSize + old.x();
+                    std::copy(from, from + texture->_width, page->pixels.begin() + (texture->_origin.y() + y) * _pageSize + texture->_origin.x());
+                }
+            }
+            _uploadPage(page);
+
+            std::vector<uint8_t> image;
+            for (auto& item : homeless)
+            {
+                auto texture = item.first;
+                auto& old = item.second;
+                image.clear();
+                for (unsigned int y = 0; y != texture->_height; ++y)
+                {
+                    auto from = pixels.begin() + (old.y() + y) * _pageSize + old.x();
+                    image.insert(image.end(), from, from + texture->_width);
+                }
+
+                Page* target = nullptr;
+                for (auto& other : _pages)
+                {
+                    if (other.get() != page && _place(other.get(), texture))
+                    {
+                        target = other.get();
+                        break;
+                    }
+                }
+                if (!target)
+                {
+                    target = _newPage();
+                    _place(target, texture);
+                }
+                _upload(target, texture->_origin, texture->_width, texture->_height, image.data());
+            }
+        }
+
+        void TextureAtlas::_release(Texture* texture)
+        {
+            auto page = std::find_if(_pages.begin(), _pages.end(), [texture](const std::unique_ptr<Page>& page) {
+                return page->id == texture->_textureID;
+            });
+            if (page == _pages.end())
+            {
+                return;
+            }
+
+            auto& textures = (*page)->textures;
+            textures.erase(std::remove(textures.begin(), textures.end(), texture), textures.end());
+            (*page)->liveArea -= _paddedArea(texture);
+
+            if (!textures.empty())
+            {
+                return;
+            }
+            // queued sprites may still be drawn from the page
+            Game::getInstance()->renderer()->spriteBatch()->flush();
+            // one empty page is kept for the next images, others give their memory back
+            if (_pages.size() > 1)
+            {
+                GLState::getInstance()->deleteTextures(1, &(*page)->id);
+                _pages.erase(page);
+            }
+            else
+            {
+                // padding of next images has to be transparent again
+                (*page)->packer.clear();
+                std::fill((*page)->pixels.begin(), (*page)->pixels.end(), 0);
+                _uploadPage(page->get());
+            }
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../Graphics/SkylinePacker.h"
+#include "../Graphics/Texture.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        /**
+         * @brief Packs many small images into few large GL textures
+         *
+         * Images become Texture objects which refer to a rectangle of a page instead of owning a GL texture,
+         * so sprites of different images can be drawn without binding another texture.
+         * Pages hold 8-bit palette indexes, colors come from the palette texture of AnimatedPalette.
+         * Space of destroyed textures is taken back when their page is repacked or becomes empty.
+         */
+        class TextureAtlas
+        {
+            public:
+                explicit TextureAtlas(unsigned int pageSize);
+                ~TextureAtlas();
+
+                TextureAtlas(const TextureAtlas&) = delete;
+                TextureAtlas& operator= (const TextureAtlas&) = delete;
+
+                // Copies image of palette indexes to one of pages.
+                // Returns nullptr if the image is too large for a page.
+                std::unique_ptr<Texture> add(unsigned int width, unsigned int height, const uint8_t* indexes);
+
+                size_t pageCount() const;
+                unsigned int pageSize() const;
+
+            private:
+                friend class Texture;
+
+                struct Page
+                {
+                    GLuint id;
+                    SkylinePacker packer;
+                    // copy of the page texture, so it's repacked without reading the texture back
+                    std::vector<uint8_t> pixels;
+                    std::vector<Texture*> textures;
+                    // area of textures which are still alive
+                    size_t liveArea = 0;
+
+                    Page(unsigned int size) : packer(size, size), pixels(static_cast<size_t>(size) * size, 0)
+                    {
+                    }
+                };
+
+                // transparent border around each image, so outlines don't pick up pixels of neighbors
+                static const unsigned int PADDING = 1;
+
+                unsigned int _pageSize;
+                std::vector<std::unique_ptr<Page>> _pages;
+
+                Page* _newPage();
+                bool _place(Page* page, Texture* texture);
+                // Packs living textures of the page anew. Textures which don't fit it anymore go to other pages.
+                void _repack(Page* page);
+                // Copies image to the page and its texture
+                void _upload(Page* page, const Point& position, unsigned int width, unsigned int height, const uint8_t* indexes);
+                // Sends the whole copy of the page to its texture
+                void _uploadPage(Page* page);
+                size_t _paddedArea(const Texture* texture) const;
+                void _release(Texture* texture);
+        };
+    }
+}
@@ -1,8 +1,10 @@
 #include <memory>
 #include "../Game/Game.h"
 #include "../Graphics/AnimatedPalette.h"
+#include "../Graphics/GLState.h"
 #include "../Graphics/Shader.h"
 #include "../Graphics/Sprite.h"
+#include "../Graphics/SpriteBatch.h"
 #include "../Graphics/Tilemap.h"
 #include "../ResourceManager.h"
 #include "../State/Location.h"
@@ -18,26 +20,23 @@ namespace Falltergeist
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
                 GL_CHECK(glGenVertexArrays(1, &_vao));
-                GL_CHECK(glBindVertexArray(_vao));
+                GLState::getInstance()->bindVertexArray(_vao);
             }
 
             // generate VBOs for verts and tex
             GL_CHECK(glGenBuffers(1, &_coords));
             GL_CHECK(glGenBuffers(1, &_texCoords));
-            GL_CHECK(glGenBuffers(1, &_ebo));
 
             if (coords.size()<=0 || textureCoords.size() <=0) return;
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _coords));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, _coords);
             //update coords
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, coords.size() * sizeof(glm::vec2), &coords[0], GL_STATIC_DRAW));
 
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _texCoords));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, _texCoords);
             //update texcoords
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, textureCoords.size() * sizeof(glm::vec2), &textureCoords[0], GL_STATIC_DRAW));
-
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
             //GL_CHECK(glBindVertexArray(0));
 
             _shader = ResourceManager::getInstance()->shader("tilemap");
@@ -56,19 +55,24 @@ namespace Falltergeist
 
         Tilemap::~Tilemap()
         {
-            GL_CHECK(glDeleteBuffers(1, &_coords));
-            GL_CHECK(glDeleteBuffers(1, &_texCoords));
-            GL_CHECK(glDeleteBuffers(1, &_ebo));
+            GLState::getInstance()->deleteBuffers(1, &_coords);
+            GLState::getInstance()->deleteBuffers(1, &_texCoords);
+            if (!_ebos.empty())
+            {
+                GLState::getInstance()->deleteBuffers(static_cast<GLsizei>(_ebos.size()), _ebos.data());
+            }
 
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
-                GL_CHECK(glDeleteVertexArrays(1, &_vao));
+                GLState::getInstance()->deleteVertexArrays(1, &_vao);
             }
         }
 
-        void Tilemap::render(const Point &pos, std::vector<GLuint> indexes, uint32_t atlas)
+        void Tilemap::render(const Point &pos, uint32_t atlas, size_t first, size_t count)
         {
-            if (indexes.size()<=0) return;
+            if (count == 0 || atlas >= _ebos.size()) return;
+
+            Game::getInstance()->renderer()->spriteBatch()->flush();
 
             GL_CHECK(_shader->use());
 
@@ -104,34 +108,23 @@ namespace Falltergeist
             }
             GL_CHECK(_shader->setUniform(_uniformLight, lightLevel));
 
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
-            {
-                GLint curvao;
-                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &curvao);
-                if ((GLuint)curvao != _vao)
-                {
-                    GL_CHECK(glBindVertexArray(_vao));
-                }
-            }
+            _bindVertexArray();
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _coords));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, _coords);
             GL_CHECK(glVertexAttribPointer(_attribPos, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _texCoords));
+            GLState::getInstance()->bindBuffer(GL_ARRAY_BUFFER, _texCoords);
 
             GL_CHECK(glVertexAttribPointer(_attribTex, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
-
-            // update indexes
-            GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexes.size() * sizeof(GLuint), &indexes[0], GL_DYNAMIC_DRAW));
+            GLState::getInstance()->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebos.at(atlas));
 
             GL_CHECK(glEnableVertexAttribArray(_attribPos));
 
             GL_CHECK(glEnableVertexAttribArray(_attribTex));
 
-            GL_CHECK(glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexes.size()), GL_UNSIGNED_INT, 0 ));
+            GL_CHECK(glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(count), GL_UNSIGNED_INT, (void*)(first * sizeof(GLuint)) ));
 
             GL_CHECK(glDisableVertexAttribArray(_attribPos));
 
@@ -143,5 +136,37 @@ namespace Falltergeist
             _textures.push_back(std::make_unique<Texture>(surface->w, surface->h));
             _textures.back().get()->loadFromSurface(surface);
         }
+
+        void Tilemap::setIndexes(uint32_t atlas, const std::vector<GLuint>& indexes)
+        {
+            while (_ebos.size() <= atlas)
+            {
+                GLuint ebo;
+                GL_CHECK(glGenBuffers(1, &ebo));
+                _ebos.push_back(ebo);
+            }
+
+            // element buffer binding is a part of VAO state, so it mustn't go to VAO of someone else
+            _bindVertexArray();
+            GLState::getInstance()->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebos.at(atlas));
+            GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexes.size() * sizeof(GLuint), indexes.data(), GL_STATIC_DRAW));
+        }
+
+        void Tilemap::updateIndexes(uint32_t atlas, size_t first, const GLuint* indexes, size_t count)
+        {
+            if (count == 0) return;
+
+            _bindVertexArray();
+            GLState::getInstance()->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebos.at(atlas));
+            GL_CHECK(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, first * sizeof(GLuint), count * sizeof(GLuint), indexes));
+        }
+
+        void Tilemap::_bindVertexArray()
+        {
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
+            {
+                GLState::getInstance()->bindVertexArray(_vao);
+            }
+        }
     }
 }
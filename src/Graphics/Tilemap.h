@@ -14,14 +14,19 @@ namespace Falltergeist
             public:
                 Tilemap(std::vector<glm::vec2> coords, std::vector<glm::vec2> textureCoords);
                 ~Tilemap();
-                void render(const Point &pos, std::vector<GLuint> indexes, uint32_t atlas);
+                // Draws count indexes of given atlas starting from first one
+                void render(const Point &pos, uint32_t atlas, size_t first, size_t count);
                 void addTexture(SDL_Surface* surface);
+                // Index buffers stay in GPU memory, only changed parts of them are uploaded again
+                void setIndexes(uint32_t atlas, const std::vector<GLuint>& indexes);
+                void updateIndexes(uint32_t atlas, size_t first, const GLuint* indexes, size_t count);
 
             private:
                 GLuint _vao;
                 GLuint _coords;
                 GLuint _texCoords;
-                GLuint _ebo;
+                // index buffer of each atlas
+                std::vector<GLuint> _ebos;
                 std::vector<std::unique_ptr<Texture>> _textures;
 
                 GLint _uniformTex;
@@ -34,6 +39,8 @@ namespace Falltergeist
                 GLint _attribPos;
                 GLint _attribTex;
                 Graphics::Shader*_shader;
+
+                void _bindVertexArray();
         };
     }
 }
@@ -1,49 +1,68 @@
 #include <cmath>
-#include "../Game/DoorSceneryObject.h"
 #include "../PathFinding/Hexagon.h"
+#include "../PathFinding/HexagonGrid.h"
 
 namespace Falltergeist
 {
-    Hexagon::Hexagon(unsigned int number)
+    Hexagon::Hexagon(HexagonGrid* grid, unsigned int number) : _grid(grid), _number(number)
     {
-        // Init hex's grid position
-        setNumber(number);
     }
 
-    std::array<Hexagon*, HEX_SIDES>& Hexagon::neighbors()
+    std::array<Hexagon*, HEX_SIDES> Hexagon::neighbors() const
     {
-        return _neighbors;
+        std::array<Hexagon*, HEX_SIDES> result = {};
+        auto& numbers = _grid->_neighbors[_number];
+        for (unsigned int i = 0; i != HEX_SIDES; ++i) {
+            if (numbers[i] >= 0) {
+                result[i] = _grid->at(numbers[i]);
+            }
+        }
+        return result;
+    }
+
+    HexagonObjects Hexagon::objects() const
+    {
+        return HexagonObjects(&_grid->_objectNodes, _grid->_firstObjects[_number]);
+    }
+
+    void Hexagon::addObject(Game::Object* object)
+    {
+        _grid->_addObject(_number, object);
     }
 
-    std::list<Game::Object*>* Hexagon::objects()
+    bool Hexagon::removeObject(Game::Object* object)
     {
-        return &_objects;
+        return _grid->_removeObject(_number, object);
     }
 
     const Point& Hexagon::position() const
     {
-        return _position;
+        return _grid->_positions[_number];
     }
 
-    void Hexagon::setPosition(const Point& pos)
+    int Hexagon::cubeX() const
     {
-        _position = pos;
+        return _grid->_cubeX[_number];
     }
 
-    bool Hexagon::canWalkThru()
+    int Hexagon::cubeY() const
     {
-        // Search hex for any blocking objects...
-        for (const auto object : _objects) {
-            if (!object->canWalkThru()) {
-                return false;
-            }
-        }
-        return true;
+        return -_grid->_cubeX[_number] - _grid->_cubeZ[_number];
+    }
+
+    int Hexagon::cubeZ() const
+    {
+        return _grid->_cubeZ[_number];
+    }
+
+    bool Hexagon::canWalkThru() const
+    {
+        return _grid->_canWalkThru(_number);
     }
 
     Game::Orientation Hexagon::orientationTo(Hexagon *hexagon)
     {
-        Point delta = hexagon->position() - _position;
+        Point delta = hexagon->position() - position();
         int dx = delta.x();
         int dy = delta.y();
 
@@ -69,32 +88,14 @@ namespace Falltergeist
         return Game::Orientation(result); // TODO: this is wrong. orientation!=direction
     }
 
-    unsigned int Hexagon::addLight(unsigned int light)
-    {
-        _light += light;
-        if (_light > 65536) {
-            _light = 65536;
-        }
-        return _light;
-    }
-
-    unsigned int Hexagon::subLight(unsigned int light)
-    {
-        _light -= light;
-        if ((int)_light < 655) {
-            _light = 655;
-        }
-        return _light;
-    }
-
-    unsigned int Hexagon::light()
+    unsigned int Hexagon::light() const
     {
-        return _light;
+        return _grid->_light[_number];
     }
 
     unsigned int Hexagon::setLight(unsigned int light)
     {
-        _light = light;
-        return _light;
+        _grid->_light[_number] = light;
+        return light;
     }
 }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <array>
-#include <list>
+#include <cstdint>
+#include <iterator>
+#include <vector>
 #include "../Game/Object.h"
 #include "../Graphics/Point.h"
 
@@ -16,93 +18,112 @@ namespace Falltergeist
         class Object;
     }
 
+    class HexagonGrid;
+
     using Graphics::Point;
 
-    class Hexagon
+    // Link of intrusive per-hexagon object list, all of them are stored in one array of the grid
+    struct HexagonObjectNode
     {
-        public:
-            Hexagon() = default;
-            explicit Hexagon(unsigned int number);
-
-            const Point& position() const;
-            void setPosition(const Point& pos);
-
-            inline unsigned int number()
-            {
-                return _number;
-            }
-
-            inline void setNumber(unsigned int value)
-            {
-                _number = value;
-            }
+        Game::Object* object;
+        int32_t next;
+    };
 
-            inline unsigned int heuristic()
+    // Objects at a hexagon, in the order they were placed there
+    class HexagonObjects
+    {
+        public:
+            class iterator : public std::iterator<std::forward_iterator_tag, Game::Object*>
             {
-                return _heuristic;
-            }
-
-            inline void setHeuristic(unsigned int value)
+                public:
+                    iterator(const std::vector<HexagonObjectNode>* nodes, int32_t node) : _nodes(nodes), _node(node)
+                    {
+                    }
+
+                    Game::Object* operator *() const
+                    {
+                        return (*_nodes)[_node].object;
+                    }
+
+                    iterator& operator ++()
+                    {
+                        _node = (*_nodes)[_node].next;
+                        return *this;
+                    }
+
+                    iterator operator ++(int)
+                    {
+                        iterator result(*this);
+                        ++*this;
+                        return result;
+                    }
+
+                    bool operator ==(const iterator& rhs) const
+                    {
+                        return _node == rhs._node;
+                    }
+
+                    bool operator !=(const iterator& rhs) const
+                    {
+                        return _node != rhs._node;
+                    }
+
+                private:
+                    const std::vector<HexagonObjectNode>* _nodes;
+                    int32_t _node;
+            };
+
+            HexagonObjects(const std::vector<HexagonObjectNode>* nodes, int32_t first) : _nodes(nodes), _first(first)
             {
-                _heuristic = value;
             }
 
-            inline int cubeX()
-            {
-                return _cubeX;
-            }
+            iterator begin() const { return iterator(_nodes, _first); }
+            iterator end() const   { return iterator(_nodes, -1); }
+            bool empty() const     { return _first < 0; }
 
-            inline void setCubeX(unsigned int value)
-            {
-                _cubeX = value;
-            }
+        private:
+            const std::vector<HexagonObjectNode>* _nodes;
+            int32_t _first;
+    };
 
-            inline int cubeY()
-            {
-                return _cubeY;
-            }
+    /**
+     * @brief Handle to a hexagon of HexagonGrid
+     *
+     * Holds only the grid and hexagon number, all the data lives in flat arrays of the grid.
+     */
+    class Hexagon
+    {
+        public:
+            Hexagon(HexagonGrid* grid, unsigned int number);
 
-            inline void setCubeY(unsigned int value)
-            {
-                _cubeY = value;
-            }
+            const Point& position() const;
 
-            inline int cubeZ()
+            inline unsigned int number() const
             {
-                return _cubeZ;
+                return _number;
             }
 
-            inline void setCubeZ(unsigned int value)
-            {
-                _cubeZ = value;
-            }
+            int cubeX() const;
+            int cubeY() const;
+            int cubeZ() const;
 
-            unsigned int addLight(unsigned int light);
-            unsigned int subLight(unsigned int light);
             unsigned int setLight(unsigned int light);
-            unsigned int light();
+            unsigned int light() const;
 
-            bool canWalkThru();
+            bool canWalkThru() const;
 
-            std::array<Hexagon*, HEX_SIDES>& neighbors();
+            // Missing neighbors at the map's borders are null
+            std::array<Hexagon*, HEX_SIDES> neighbors() const;
 
-            std::list<Game::Object*>* objects();
+            HexagonObjects objects() const;
+            void addObject(Game::Object* object);
+            // Returns false if object isn't at this hexagon
+            bool removeObject(Game::Object* object);
 
             Game::Orientation orientationTo(Hexagon *hexagon);
 
         protected:
-            std::array<Hexagon*, HEX_SIDES> _neighbors = {};
-            std::list<Game::Object*> _objects;
-            unsigned int _number = 0; // position in hexagonal grid
-
-            Point _position;
-
-            int _cubeX = 0;
-            int _cubeY = 0;
-            int _cubeZ = 0;
-
-            unsigned int _heuristic = 0;
-
-            unsigned int _light = 655;
+            HexagonGrid* _grid;
+            unsigned int _number; // position in hexagonal grid
     };
 }
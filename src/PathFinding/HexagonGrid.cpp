@@ -1,25 +1,93 @@
+#include <algorithm>
 #include <array>
+#include <bitset>
 #include <cstdlib>
 #include <functional>
-#include <queue>
 #include <memory>
+#include "../Game/DoorSceneryObject.h"
 #include "../Game/WallObject.h"
 #include "../PathFinding/Hexagon.h"
 #include "../PathFinding/HexagonGrid.h"
 
 namespace Falltergeist
 {
-    struct HeuristicComparison : public std::binary_function<Hexagon*, Hexagon*, bool>
+    namespace
     {
-        bool operator()(Hexagon* lh, Hexagon* rh) const
+        // paths longer than this are not searched
+        const unsigned int MAX_PATH_COST = 100;
+
+        // size of walkability change log
+        const size_t MAX_WALK_CHANGES = 4096;
+
+        // A* state reused by all searches of a thread
+        struct PathWorkspace
         {
-            return lh->heuristic() > rh->heuristic();
-        }
-    };
+            // a hexagon has cost and parent of the current search only if its stamp equals generation
+            std::vector<uint32_t> stamps;
+            std::vector<uint16_t> costs;
+            std::vector<int32_t> parents;
+            // binary min-heap of estimated cost << 32 | (0xFFFF - cost) << 16 | hexagon number,
+            // so ties are broken in favor of hexagons farther from start
+            std::vector<uint64_t> open;
+            uint32_t generation = 0;
+
+            PathWorkspace()
+                : stamps(GRID_WIDTH * GRID_HEIGHT, 0), costs(GRID_WIDTH * GRID_HEIGHT, 0), parents(GRID_WIDTH * GRID_HEIGHT, -1)
+            {
+                open.reserve(GRID_WIDTH * GRID_HEIGHT);
+            }
+
+            void begin()
+            {
+                open.clear();
+                if (++generation == 0)
+                {
+                    std::fill(stamps.begin(), stamps.end(), 0);
+                    generation = 1;
+                }
+            }
+
+            bool visited(unsigned int number) const
+            {
+                return stamps[number] == generation;
+            }
+
+            void visit(unsigned int number, unsigned int cost, int32_t parent, unsigned int estimate)
+            {
+                stamps[number] = generation;
+                costs[number] = static_cast<uint16_t>(cost);
+                parents[number] = parent;
+                open.push_back(static_cast<uint64_t>(estimate) << 32 | static_cast<uint64_t>(0xFFFF - cost) << 16 | number);
+                std::push_heap(open.begin(), open.end(), std::greater<uint64_t>());
+            }
+
+            // returns hexagon number and its cost at the moment it was pushed
+            unsigned int pop(unsigned int& cost)
+            {
+                std::pop_heap(open.begin(), open.end(), std::greater<uint64_t>());
+                auto node = open.back();
+                open.pop_back();
+                cost = 0xFFFF - static_cast<unsigned int>((node >> 16) & 0xFFFF);
+                return static_cast<unsigned int>(node & 0xFFFF);
+            }
+        };
+
+        thread_local PathWorkspace pathWorkspace;
+    }
 
     // TODO: Refactor this ctor to make it more understandable.
-    HexagonGrid::HexagonGrid()
+    HexagonGrid::HexagonGrid() : _lightBlockers(GRID_WIDTH * GRID_HEIGHT, LightBlocker::NONE)
     {
+        const unsigned int gridSize = GRID_HEIGHT * GRID_WIDTH;
+        _hexagons.reserve(gridSize);
+        _positions.reserve(gridSize);
+        _cubeX.reserve(gridSize);
+        _cubeZ.reserve(gridSize);
+        _neighbors.resize(gridSize);
+        _light.assign(gridSize, 655);
+        _walkFlags.assign(gridSize, 0);
+        _firstObjects.assign(gridSize, -1);
+
         // Creating 200x200 hexagonal map
         unsigned int index = 0;
         const unsigned int xMod = HEX_WIDTH / 2;  // x offset
@@ -29,8 +97,7 @@ namespace Falltergeist
         {
             for (unsigned int hx = 0; hx != GRID_WIDTH; ++hx, ++index) // columns
             {
-                _hexagons.emplace_back(std::make_unique<Hexagon>(index));
-                auto& hexagon = _hexagons.back();
+                _hexagons.emplace_back(this, index);
                 // Calculate hex's actual position
                 const bool oddCol = hx & 1;
                 const int  oddMod = hy + 1;
@@ -42,23 +109,20 @@ namespace Falltergeist
                             + (yMod * hx)
                             + HEX_HEIGHT
                             - (yMod * oddCol);
-                hexagon->setCubeX(hy - (hx + oddCol) / 2);
-                hexagon->setCubeZ(hx);
-                hexagon->setCubeY(-hexagon->cubeX() - hexagon->cubeZ());
+                _cubeX.push_back(static_cast<int16_t>(hy - (hx + oddCol) / 2));
+                _cubeZ.push_back(static_cast<int16_t>(hx));
 
-                hexagon->setPosition({x, y});
+                _positions.emplace_back(x, y);
             }
         }
 
         // Creating links between hexagons
-        for (index = 0; index != GRID_WIDTH * GRID_HEIGHT; ++index)
+        for (index = 0; index != gridSize; ++index)
         {
            /* North: index - 200 *
             * East:  index - 1   *
             * South: index + 200 *
             * West:  index + 1   */
-            auto hexagon = _hexagons.at(index).get();
-
             const bool oddCol = index & 1;
             const unsigned hy = index / GRID_HEIGHT; // hexagonal y
             const unsigned hx = index % GRID_WIDTH;  // hexagonal x
@@ -77,21 +141,14 @@ namespace Falltergeist
             const unsigned indexBotRight  = botMod + rightMod; // index 5
             const unsigned indexTopRight  = topMod + rightMod; // index 6
 
-            const unsigned gridSize = GRID_HEIGHT * GRID_WIDTH;
-            std::array<Hexagon*, HEX_SIDES>& neighbor = hexagon->neighbors();
+            const std::array<unsigned, HEX_SIDES> neighbors = {
+                indexBot, indexBotLeft, indexTopLeft, indexTop, indexBotRight, indexTopRight
+            };
             // Don't get a neighbour if at the map's borders
-            if (indexBot < gridSize)
-                neighbor[0] = _hexagons.at(indexBot).get();
-            if (indexBotLeft < gridSize)
-                neighbor[1] = _hexagons.at(indexBotLeft).get();
-            if (indexTopLeft < gridSize)
-                neighbor[2] = _hexagons.at(indexTopLeft).get();
-            if (indexTop < gridSize)
-                neighbor[3] = _hexagons.at(indexTop).get();
-            if (indexBotRight < gridSize)
-                neighbor[4] = _hexagons.at(indexBotRight).get();
-            if (indexTopRight < gridSize)
-                neighbor[5] = _hexagons.at(indexTopRight).get();
+            for (unsigned int i = 0; i != HEX_SIDES; ++i)
+            {
+                _neighbors[index][i] = neighbors[i] < gridSize ? static_cast<int32_t>(neighbors[i]) : -1;
+            }
         }
     }
 
@@ -99,98 +156,196 @@ namespace Falltergeist
 
     Hexagon* HexagonGrid::at(size_t index)
     {
-        return _hexagons.at(index).get();
+        return &_hexagons.at(index);
     }
 
     Hexagon* HexagonGrid::hexagonAt(const Point& pos)
     {
-        for (auto& hexagon : _hexagons)
+        for (size_t i = 0; i != _positions.size(); ++i)
         {
-            auto hexPos = hexagon->position();
+            auto& hexPos = _positions[i];
             if (pos.x() >= hexPos.x() - HEX_WIDTH &&
                 pos.x() <  hexPos.x() + HEX_WIDTH &&
                 pos.y() >= hexPos.y() - 8 &&
                 pos.y() <  hexPos.y() + 4)
             {
-                return hexagon.get();
+                return &_hexagons[i];
             }
         }
         return nullptr;
     }
 
-    Base::vector_ptr_decorator<Hexagon> HexagonGrid::hexagons()
+    HexagonGrid::HexagonRange HexagonGrid::hexagons()
     {
-        return Base::vector_ptr_decorator<Hexagon>(_hexagons);
+        return HexagonRange(_hexagons.data(), _hexagons.data() + _hexagons.size());
     }
 
     std::vector<Hexagon*> HexagonGrid::findPath(Hexagon* from, Hexagon* to)
     {
-        Hexagon* current = nullptr;
         std::vector<Hexagon*> result;
-        std::priority_queue<Hexagon*, std::vector<Hexagon*>, HeuristicComparison> unvisited;
-        unsigned int cameFrom[GRID_HEIGHT * GRID_WIDTH]  = {};
-        unsigned int costSoFar[GRID_HEIGHT * GRID_WIDTH] = {};
+        findPath(from, to, result);
+        return result;
+    }
 
-        // if we can't go to the location
-        // @todo remove when path will have length restriction
-        if (!to->canWalkThru()) return result;
+    PathResult HexagonGrid::findPath(Hexagon* from, Hexagon* to, std::vector<Hexagon*>& path, unsigned int maxNodes)
+    {
+        path.clear();
+        unsigned int start = from->number();
+        unsigned int last = start;
+        auto result = _searchPath(start, to->number(), [this](unsigned int number) {
+            return _canWalkThru(number);
+        }, maxNodes, last);
+
+        if (result != PathResult::NOT_FOUND)
+        {
+            auto& parents = pathWorkspace.parents;
+            for (auto number = last; number != start; number = parents[number])
+            {
+                path.push_back(&_hexagons[number]);
+            }
+        }
+        return result;
+    }
 
-        unvisited.push(from);
+    PathResult HexagonGrid::findPath(unsigned int from, unsigned int to, const std::vector<uint8_t>& walkable, unsigned int maxNodes, std::vector<unsigned int>& path) const
+    {
+        path.clear();
+        unsigned int last = from;
+        auto result = _searchPath(from, to, [&walkable](unsigned int number) {
+            return walkable[number] != 0;
+        }, maxNodes, last);
 
-        cameFrom[from->number()]  = 0;
-        costSoFar[from->number()] = 0;
+        if (result != PathResult::NOT_FOUND)
+        {
+            auto& parents = pathWorkspace.parents;
+            for (auto number = last; number != from; number = parents[number])
+            {
+                path.push_back(number);
+            }
+        }
+        return result;
+    }
+
+    const std::array<int32_t, HEX_SIDES>& HexagonGrid::neighborNumbers(unsigned int number) const
+    {
+        return _neighbors[number];
+    }
 
+    unsigned int HexagonGrid::distance(unsigned int from, unsigned int to) const
+    {
+        return _distance(from, to);
+    }
+
+    bool HexagonGrid::mayWalkThru(unsigned int number) const
+    {
+        return (_walkFlags[number] & WALK_BLOCKED) == 0;
+    }
 
-        while (!unvisited.empty())
+    unsigned int HexagonGrid::walkRevision() const
+    {
+        return _walkChangesBase + static_cast<unsigned int>(_walkChanges.size());
+    }
+
+    bool HexagonGrid::walkChanges(unsigned int revision, std::vector<unsigned int>& numbers) const
+    {
+        if (revision < _walkChangesBase)
         {
-            current = unvisited.top(); unvisited.pop();
-            if (current == to) break;
-            // search limit
-            if (costSoFar[current->number()] >= 100) break;
+            return false;
+        }
+        numbers.insert(numbers.end(), _walkChanges.begin() + (revision - _walkChangesBase), _walkChanges.end());
+        return true;
+    }
 
-            std::array<Hexagon*, HEX_SIDES>& neighbor = current->neighbors();
-            // look to each adjacent hex...
-            for (int i = 0; i < HEX_SIDES; i++)
+    void HexagonGrid::walkableSnapshot(std::vector<uint8_t>& walkable) const
+    {
+        walkable.resize(_walkFlags.size());
+        for (unsigned int number = 0; number != _walkFlags.size(); ++number)
+        {
+            walkable[number] = _canWalkThru(number) ? 1 : 0;
+        }
+    }
+
+    template <typename Walkable>
+    PathResult HexagonGrid::_searchPath(unsigned int start, unsigned int goal, const Walkable& walkable, unsigned int maxNodes, unsigned int& last) const
+    {
+        // if we can't go to the location
+        if (start == goal || !walkable(goal))
+        {
+            return PathResult::NOT_FOUND;
+        }
+
+        auto& workspace = pathWorkspace;
+        workspace.begin();
+        workspace.visit(start, 0, -1, _distance(start, goal));
+
+        unsigned int closest = start;
+        unsigned int closestDistance = _distance(start, goal);
+        unsigned int expanded = 0;
+
+        while (!workspace.open.empty())
+        {
+            unsigned int cost;
+            auto current = workspace.pop(cost);
+            // the hexagon was pushed again with lower cost
+            if (cost != workspace.costs[current])
+            {
+                continue;
+            }
+            if (current == goal)
+            {
+                last = goal;
+                return PathResult::FOUND;
+            }
+            if (maxNodes != 0 && expanded == maxNodes)
             {
-                // Does the hex exist?
-                if (neighbor[i] == nullptr) continue;
-                // Is that hex blocked?
-                if (!neighbor[i]->canWalkThru()) continue;
+                break;
+            }
+            ++expanded;
 
-                // This hex is a viable path. But is it the shortest?
-                auto &neighborCost   = costSoFar[neighbor[i]->number()];
-                unsigned int newCost = costSoFar[current->number()] + 1;
+            auto currentDistance = _distance(current, goal);
+            if (currentDistance < closestDistance)
+            {
+                closest = current;
+                closestDistance = currentDistance;
+            }
+            // hexagons are taken in order of estimate, so no path cheaper than the limit is left
+            if (cost >= MAX_PATH_COST)
+            {
+                break;
+            }
 
-                if (neighborCost == 0 || newCost < neighborCost)
+            for (auto neighbor : _neighbors[current])
+            {
+                if (neighbor < 0 || !walkable(neighbor))
                 {
-                    // add hexagon to unvisited queue only once and don't change heuristic
-                    if (neighborCost == 0)
-                    {
-                        neighbor[i]->setHeuristic(distance(neighbor[i], to) + newCost);
-                        unvisited.push(neighbor[i]);
-                    }
-                    neighborCost = newCost;
-                    cameFrom[neighbor[i]->number()] = current->number();
+                    continue;
+                }
+                auto newCost = cost + 1;
+                if (!workspace.visited(neighbor) || newCost < workspace.costs[neighbor])
+                {
+                    workspace.visit(neighbor, newCost, current, newCost + _distance(neighbor, goal));
                 }
             }
         }
 
-        // found nothing
-        if (current != to) return result;
-
-
-        while (current->number() != from->number())
+        if (maxNodes == 0 || expanded != maxNodes || closest == start)
         {
-            result.push_back(current);
-            current = _hexagons.at(cameFrom[current->number()]).get();
+            return PathResult::NOT_FOUND;
         }
-
-        return result;
+        last = closest;
+        return PathResult::PARTIAL;
     }
 
     unsigned int HexagonGrid::distance(Hexagon* from, Hexagon* to)
     {
-        return (std::abs(from->cubeX() - to->cubeX()) + std::abs(from->cubeY() - to->cubeY()) + std::abs(from->cubeZ() - to->cubeZ())) / 2;
+        return _distance(from->number(), to->number());
+    }
+
+    unsigned int HexagonGrid::_distance(unsigned int from, unsigned int to) const
+    {
+        int dx = _cubeX[from] - _cubeX[to];
+        int dz = _cubeZ[from] - _cubeZ[to];
+        return (std::abs(dx) + std::abs(dx + dz) + std::abs(dz)) / 2;
     }
 
     Hexagon* HexagonGrid::hexInDirection(Hexagon* from, unsigned short rotation, unsigned int distance)
@@ -272,381 +427,392 @@ namespace Falltergeist
         return result;
     }
 
-    void HexagonGrid::initLight(Hexagon *hex, bool add)
+    namespace
     {
-        auto objectsAtHex = hex->objects();
-        for (auto it = objectsAtHex->begin(); it != objectsAtHex->end(); ++it)
+        // Light doesn't reach further than this many hexagons from its source
+        const unsigned int MAX_LIGHT_RADIUS = 8;
+
+        // Hexagons of all rings around a light source, there are 6 * radius hexagons in each ring
+        const unsigned int LIGHT_CELLS = 3 * MAX_LIGHT_RADIUS * (MAX_LIGHT_RADIUS + 1);
+
+        const unsigned int MAX_OCCLUSION_RULES = 16;
+
+        // Ring around light source starts from direction 0 and goes counterclockwise.
+        // Each direction of a ring is a cone of radius hexagons.
+        constexpr unsigned int ringStart(unsigned int radius)
+        {
+            return 3 * radius * (radius - 1);
+        }
+
+        // Hexagon of a ring relative to the one being lit
+        struct LightCell
+        {
+            // index within cone, index equal to radius refers to the first hexagon of the next cone
+            unsigned char index;
+            unsigned char radius;
+            // added to direction of the hexagon being lit
+            unsigned char turn;
+        };
+
+        // Hexagon with given cone index and radius is in shadow if both cells are blocked
+        struct OcclusionRule
+        {
+            unsigned char radius;
+            unsigned char index;
+            LightCell first;
+            LightCell second;
+        };
+
+        // Shadows cast by blocked hexagons on the hexagons behind them, same for all six directions
+        constexpr OcclusionRule OCCLUSION_RULES[] = {
+                {2, 0, {0, 1, 0}, {0, 1, 0}},
+                {2, 1, {0, 1, 0}, {1, 1, 0}},
+                {3, 0, {0, 2, 0}, {0, 2, 0}},
+                {3, 1, {0, 2, 0}, {1, 2, 0}},
+                {3, 2, {1, 2, 0}, {2, 2, 0}},
+                {4, 0, {0, 3, 0}, {0, 3, 0}},
+                {4, 1, {0, 3, 0}, {1, 3, 0}},
+                {4, 2, {1, 2, 0}, {1, 2, 0}}, {4, 2, {1, 3, 0}, {2, 3, 0}},
+                {4, 3, {1, 2, 0}, {2, 2, 0}}, {4, 3, {2, 3, 0}, {3, 3, 0}},
+                {5, 0, {0, 4, 0}, {0, 4, 0}},
+                {5, 1, {0, 4, 0}, {1, 4, 0}},
+                {5, 2, {1, 2, 0}, {1, 3, 0}}, {5, 2, {1, 2, 0}, {1, 4, 0}}, {5, 2, {1, 3, 0}, {2, 3, 0}}, {5, 2, {1, 3, 0}, {1, 4, 0}},
+                {5, 2, {1, 3, 0}, {2, 4, 0}}, {5, 2, {1, 4, 0}, {2, 4, 0}},
+                {5, 3, {0, 2, 1}, {1, 2, 0}}, {5, 3, {1, 2, 0}, {2, 3, 0}}, {5, 3, {1, 2, 0}, {3, 4, 0}}, {5, 3, {1, 3, 0}, {2, 3, 0}},
+                {5, 3, {2, 3, 0}, {2, 4, 0}}, {5, 3, {2, 3, 0}, {3, 4, 0}}, {5, 3, {2, 4, 0}, {3, 4, 0}},
+                {5, 4, {1, 2, 0}, {2, 2, 0}}, {5, 4, {2, 3, 0}, {3, 3, 0}}, {5, 4, {3, 4, 0}, {4, 4, 0}},
+                {6, 0, {0, 5, 0}, {0, 5, 0}},
+                {6, 1, {0, 5, 0}, {1, 5, 0}},
+                {6, 2, {0, 1, 0}, {2, 5, 0}}, {6, 2, {1, 3, 0}, {1, 3, 0}}, {6, 2, {1, 4, 0}, {2, 4, 0}}, {6, 2, {1, 4, 0}, {2, 5, 0}},
+                {6, 2, {1, 5, 0}, {2, 5, 0}},
+                {6, 3, {1, 2, 0}, {1, 2, 0}}, {6, 3, {1, 3, 0}, {2, 3, 0}}, {6, 3, {2, 4, 0}, {2, 4, 0}}, {6, 3, {2, 5, 0}, {3, 5, 0}},
+                {6, 4, {0, 1, 1}, {3, 5, 0}}, {6, 4, {1, 2, 0}, {1, 2, 0}}, {6, 4, {2, 3, 0}, {2, 3, 0}}, {6, 4, {2, 4, 0}, {3, 4, 0}},
+                {6, 4, {3, 4, 0}, {3, 5, 0}}, {6, 4, {3, 5, 0}, {4, 5, 0}},
+                {6, 5, {1, 2, 0}, {2, 2, 0}}, {6, 5, {2, 3, 0}, {3, 3, 0}}, {6, 5, {3, 4, 0}, {4, 4, 0}}, {6, 5, {4, 5, 0}, {5, 5, 0}},
+                {7, 0, {0, 6, 0}, {0, 6, 0}},
+                {7, 1, {0, 6, 0}, {1, 6, 0}},
+                {7, 2, {1, 3, 0}, {1, 3, 0}}, {7, 2, {1, 4, 0}, {1, 4, 0}}, {7, 2, {1, 5, 0}, {2, 5, 0}}, {7, 2, {1, 5, 0}, {0, 6, 0}},
+                {7, 2, {1, 6, 0}, {2, 6, 0}},
+                {7, 3, {0, 1, 0}, {2, 4, 0}}, {7, 3, {1, 2, 0}, {1, 2, 0}}, {7, 3, {1, 3, 0}, {2, 3, 0}}, {7, 3, {1, 3, 0}, {2, 4, 0}},
+                {7, 3, {1, 3, 0}, {3, 6, 0}}, {7, 3, {2, 3, 0}, {2, 5, 0}}, {7, 3, {1, 4, 0}, {2, 4, 0}}, {7, 3, {2, 4, 0}, {2, 5, 0}},
+                {7, 3, {2, 4, 0}, {2, 6, 0}}, {7, 3, {2, 5, 0}, {3, 5, 0}}, {7, 3, {2, 5, 0}, {3, 6, 0}}, {7, 3, {2, 6, 0}, {3, 6, 0}},
+                {7, 4, {0, 1, 1}, {2, 4, 0}}, {7, 4, {1, 2, 0}, {1, 2, 0}}, {7, 4, {1, 3, 0}, {2, 3, 0}}, {7, 4, {1, 3, 0}, {3, 5, 0}},
+                {7, 4, {2, 3, 0}, {2, 4, 0}}, {7, 4, {2, 3, 0}, {3, 6, 0}}, {7, 4, {2, 4, 0}, {3, 4, 0}}, {7, 4, {2, 4, 0}, {3, 5, 0}},
+                {7, 4, {2, 4, 0}, {4, 6, 0}}, {7, 4, {2, 5, 0}, {3, 5, 0}}, {7, 4, {3, 5, 0}, {3, 6, 0}}, {7, 4, {3, 6, 0}, {4, 6, 0}},
+                {7, 5, {0, 2, 1}, {1, 2, 0}}, {7, 5, {1, 2, 0}, {4, 5, 0}}, {7, 5, {2, 3, 0}, {2, 3, 0}}, {7, 5, {3, 4, 0}, {3, 4, 0}},
+                {7, 5, {3, 5, 0}, {4, 5, 0}}, {7, 5, {4, 5, 0}, {4, 6, 0}}, {7, 5, {4, 6, 0}, {5, 6, 0}},
+                {7, 6, {1, 2, 0}, {2, 2, 0}}, {7, 6, {2, 3, 0}, {3, 3, 0}}, {7, 6, {3, 4, 0}, {4, 4, 0}}, {7, 6, {4, 5, 0}, {5, 5, 0}},
+                {7, 6, {5, 6, 0}, {6, 6, 0}},
+                {8, 0, {0, 7, 0}, {0, 7, 0}},
+                {8, 1, {0, 7, 0}, {1, 7, 0}},
+                {8, 2, {1, 2, 0}, {0, 3, 0}}, {8, 2, {1, 2, 0}, {1, 5, 0}}, {8, 2, {1, 2, 0}, {1, 6, 0}}, {8, 2, {0, 3, 0}, {1, 3, 0}},
+                {8, 2, {1, 3, 0}, {1, 5, 0}}, {8, 2, {1, 3, 0}, {1, 6, 0}}, {8, 2, {1, 4, 0}, {1, 4, 0}}, {8, 2, {2, 4, 0}, {1, 5, 0}},
+                {8, 2, {1, 5, 0}, {2, 5, 0}}, {8, 2, {1, 5, 0}, {2, 6, 0}}, {8, 2, {1, 5, 0}, {2, 7, 0}},
+                {8, 3, {0, 1, 0}, {3, 7, 0}}, {8, 3, {0, 2, 0}, {1, 2, 0}}, {8, 3, {1, 2, 0}, {1, 3, 0}}, {8, 3, {1, 2, 0}, {1, 4, 0}},
+                {8, 3, {1, 2, 0}, {2, 6, 0}}, {8, 3, {1, 3, 0}, {2, 3, 0}}, {8, 3, {1, 3, 0}, {2, 4, 0}}, {8, 3, {1, 3, 0}, {3, 6, 0}},
+                {8, 3, {1, 3, 0}, {3, 7, 0}}, {8, 3, {1, 4, 0}, {2, 4, 0}}, {8, 3, {1, 4, 0}, {3, 7, 0}}, {8, 3, {2, 4, 0}, {2, 6, 0}},
+                {8, 3, {2, 5, 0}, {2, 5, 0}}, {8, 3, {2, 6, 0}, {3, 6, 0}}, {8, 3, {2, 6, 0}, {3, 7, 0}}, {8, 3, {2, 7, 0}, {3, 7, 0}},
+                {8, 4, {1, 2, 0}, {1, 2, 0}}, {8, 4, {1, 3, 0}, {2, 3, 0}}, {8, 4, {2, 4, 0}, {2, 4, 0}}, {8, 4, {2, 5, 0}, {3, 5, 0}},
+                {8, 4, {3, 6, 0}, {3, 6, 0}}, {8, 4, {3, 7, 0}, {4, 7, 0}},
+                {8, 5, {0, 1, 0}, {4, 7, 0}}, {8, 5, {0, 2, 1}, {1, 2, 0}}, {8, 5, {1, 2, 0}, {2, 3, 0}}, {8, 5, {1, 2, 0}, {3, 4, 0}},
+                {8, 5, {1, 2, 0}, {4, 6, 0}}, {8, 5, {1, 3, 0}, {2, 3, 0}}, {8, 5, {2, 3, 0}, {2, 4, 0}}, {8, 5, {2, 3, 0}, {3, 6, 0}},
+                {8, 5, {2, 3, 0}, {4, 7, 0}}, {8, 5, {2, 4, 0}, {3, 4, 0}}, {8, 5, {2, 4, 0}, {4, 6, 0}}, {8, 5, {3, 4, 0}, {4, 7, 0}},
+                {8, 5, {3, 5, 0}, {3, 5, 0}}, {8, 5, {3, 6, 0}, {4, 6, 0}}, {8, 5, {4, 6, 0}, {4, 7, 0}}, {8, 5, {4, 7, 0}, {5, 7, 0}},
+                {8, 6, {1, 2, 0}, {0, 3, 1}}, {8, 6, {1, 2, 0}, {4, 5, 0}}, {8, 6, {1, 2, 0}, {5, 6, 0}}, {8, 6, {0, 3, 1}, {2, 3, 0}},
+                {8, 6, {2, 3, 0}, {4, 5, 0}}, {8, 6, {2, 3, 0}, {5, 6, 0}}, {8, 6, {2, 4, 0}, {4, 5, 0}}, {8, 6, {3, 4, 0}, {3, 4, 0}},
+                {8, 6, {3, 5, 0}, {4, 5, 0}}, {8, 6, {4, 5, 0}, {4, 6, 0}}, {8, 6, {4, 5, 0}, {5, 7, 0}},
+                {8, 7, {1, 2, 0}, {2, 2, 0}}, {8, 7, {2, 3, 0}, {3, 3, 0}}, {8, 7, {3, 4, 0}, {4, 4, 0}}, {8, 7, {4, 5, 0}, {5, 5, 0}},
+                {8, 7, {5, 6, 0}, {6, 6, 0}}, {8, 7, {6, 7, 0}, {7, 7, 0}}
+        };
+
+        struct LightTables
+        {
+            // cube coordinates of cells relative to the light source
+            signed char x[LIGHT_CELLS];
+            signed char z[LIGHT_CELLS];
+            // bit per LightBlocker which doesn't prevent the cell from being lit itself
+            unsigned char litBlockers[LIGHT_CELLS];
+            // numbers of pairs of cells which put the cell in shadow
+            unsigned char ruleCount[LIGHT_CELLS];
+            unsigned char rules[LIGHT_CELLS][MAX_OCCLUSION_RULES][2];
+        };
+
+        constexpr unsigned int cellNumber(const LightCell& cell, unsigned int direction)
         {
-            auto object = *it;
-            if (object->lightIntensity()>0 && object->lightRadius()>0)
+            return ringStart(cell.radius) + cell.index + cell.radius * ((direction + cell.turn) % HEX_SIDES);
+        }
+
+        // Whether hexagon with given light blocker stays dark when lit from given direction
+        constexpr bool isDarkBlocker(LightBlocker blocker, unsigned int radius, unsigned int direction, unsigned int index)
+        {
+            switch (blocker)
             {
-                // 36 hexes per direction
-                std::array<bool, 36*6> blocked;
-                blocked.fill(false);
+                case LightBlocker::WALL_EW:
+                    return direction != 4 && direction != 5 && (direction > 0 || index > 0)
+                        && (direction != 3 || index <= 1 || (radius == 3 && index == 2));
+                case LightBlocker::WALL_NC:
+                    return direction != 0 && direction != 5;
+                case LightBlocker::WALL_SC:
+                    return direction > 0 && direction != 1 && direction != 4 && direction != 5
+                        && (direction != 3 || index <= 1 || (radius == 3 && index == 2));
+                case LightBlocker::WALL:
+                    return direction != 0 && direction != 1 && (direction != 5 || index == 0);
+                case LightBlocker::OBJECT:
+                    return direction >= 1 && direction <= 3;
+                default:
+                    return false;
+            }
+        }
 
-                auto prevTwo = [&blocked](int idx, int radius, int dir) -> bool
-                {
-                    idx = idx-(radius-1)*6-dir;
-                    return blocked[idx-1] && blocked[idx];
-                };
+        constexpr LightTables makeLightTables()
+        {
+            LightTables tables{};
 
-                auto isBlocked = [&blocked](int coneIdx, int radius, int dir) -> bool
+            // cube coordinate steps in each direction, the same as in HexagonGrid::hexInDirection()
+            const signed char stepX[HEX_SIDES] = {0, 1, 1, 0, -1, -1};
+            const signed char stepZ[HEX_SIDES] = {-1, -1, 0, 1, 1, 0};
+
+            for (unsigned int radius = 1; radius <= MAX_LIGHT_RADIUS; ++radius)
+            {
+                // the same walk as HexagonGrid::ring()
+                int x = 0;
+                int z = -static_cast<int>(radius);
+                unsigned int cell = ringStart(radius);
+                for (unsigned int side = 0; side != HEX_SIDES; ++side)
                 {
-                    dir = dir % 6;
-                    int base = 0;
-                    int r = radius;
-                    while (r>0)
+                    unsigned int step = (side + 2) % HEX_SIDES;
+                    for (unsigned int i = 0; i != radius; ++i, ++cell)
                     {
-                        base+=(r-1)*6;
-                        r--;
+                        tables.x[cell] = static_cast<signed char>(x);
+                        tables.z[cell] = static_cast<signed char>(z);
+                        x += stepX[step];
+                        z += stepZ[step];
+
+                        unsigned int direction = (cell - ringStart(radius)) / radius;
+                        unsigned int index = (cell - ringStart(radius)) % radius;
+                        for (unsigned int blocker = 1; blocker <= static_cast<unsigned int>(LightBlocker::WALL); ++blocker)
+                        {
+                            if (!isDarkBlocker(static_cast<LightBlocker>(blocker), radius, direction, index))
+                            {
+                                tables.litBlockers[cell] |= 1 << blocker;
+                            }
+                        }
                     }
+                }
+            }
 
-                    return blocked[base+coneIdx+radius*dir];
-                };
-
-                auto index = [](int coneIdx, int radius, int dir) -> int
+            for (const auto& rule : OCCLUSION_RULES)
+            {
+                for (unsigned int direction = 0; direction != HEX_SIDES; ++direction)
                 {
-                    dir = dir % 6;
-                    int base = 0;
-                    int r = radius;
-                    while (r>0)
+                    unsigned int cell = ringStart(rule.radius) + rule.index + rule.radius * direction;
+                    if (tables.ruleCount[cell] == MAX_OCCLUSION_RULES)
                     {
-                        base+=(r-1)*6;
-                        r--;
+                        throw "MAX_OCCLUSION_RULES is too small";
                     }
+                    auto& pair = tables.rules[cell][tables.ruleCount[cell]++];
+                    pair[0] = static_cast<unsigned char>(cellNumber(rule.first, direction));
+                    pair[1] = static_cast<unsigned char>(cellNumber(rule.second, direction));
+                }
+            }
+            return tables;
+        }
+
+        constexpr LightTables LIGHT_TABLES = makeLightTables();
+    }
 
+    void HexagonGrid::initLight(Hexagon *hex, Game::Object* object, std::vector<LitHexagon>& lit)
+    {
+        if (object->lightIntensity() == 0 || object->lightRadius() == 0)
+        {
+            return;
+        }
 
-                    return base+coneIdx+radius*dir;
-                };
+        int light = object->lightIntensity();
+        lit.push_back({hex, light});
+        int perRadius = (light - 655) / (object->lightRadius()+1);
 
-                int light = object->lightIntensity();
-                if (add)
+        // cells which are blocked themselves or are in shadow
+        std::bitset<LIGHT_CELLS> blocked;
+        auto maxRadius = std::min(object->lightRadius(), MAX_LIGHT_RADIUS);
+        for (unsigned int radius = 1; radius <= maxRadius; radius++)
+        {
+            light -= perRadius;
+            for (unsigned int cell = ringStart(radius); cell != ringStart(radius + 1); ++cell)
+            {
+                int p = hex->cubeZ() + LIGHT_TABLES.z[cell];
+                if (p < 0 || p >= GRID_WIDTH) // outside of the map
                 {
-                    hex->addLight(light);
+                    continue;
                 }
-                else
+                int q = hex->cubeX() + LIGHT_TABLES.x[cell] + (p + (p&1))/2;
+                if (q < 0 || q >= GRID_HEIGHT)
                 {
-                    hex->subLight(light);
+                    continue;
                 }
-                int perRadius = (light - 655) / (object->lightRadius()+1);
 
-                int blockerIndex = 0;
+                bool block = false;
+                auto& rules = LIGHT_TABLES.rules[cell];
+                for (unsigned int i = 0; i != LIGHT_TABLES.ruleCount[cell] && !block; ++i)
+                {
+                    block = blocked[rules[i][0]] && blocked[rules[i][1]];
+                }
 
-                for (unsigned int radius = 1; radius<= object->lightRadius();radius++)
+                if (!block)
                 {
-                    light-=perRadius;
-                    int ringIndex=0;
-                    for (auto ringhex : ring(hex,radius))
+                    unsigned int number = q * GRID_WIDTH + p;
+                    if (!_lightBlocked[number]
+                        || (LIGHT_TABLES.litBlockers[cell] & (1 << static_cast<unsigned int>(_lightBlockers[number]))))
                     {
-                        if (!ringhex) //invalid hex
-                        {
-                            ringIndex++;
-                            blockerIndex++;
-                            continue;
-                        }
-                        int dir = ringIndex / radius;
+                        lit.push_back({&_hexagons[number], light});
+                    }
+                    block = _lightBlocked[number];
+                }
 
-                        int coneIdx = ringIndex % radius;
+                blocked[cell] = block;
+            }
+        }
+    }
 
-                        bool block = false;
-                        switch (radius)
-                        {
-                            case 1:
-                                block = false;
-                                break;
-                            case 2:
-                                switch (coneIdx)
-                                {
-                                    case 0:
-                                        block = isBlocked(0, radius-1, dir);
-                                        break;
-                                    case 1:
-                                        block = prevTwo(blockerIndex,radius,dir);
-                                        break;
-                                }
-                                break;
-                            case 3:
-                                switch (coneIdx)
-                                {
-                                    case 0:
-                                        block = isBlocked(0, radius-1, dir);
-                                        break;
-                                    case 1:
-                                        block = prevTwo(blockerIndex,radius,dir);
-                                        break;
-                                    case 2:
-                                        block = prevTwo(blockerIndex,radius,dir);
-                                        break;
-                                }
-                                break;
-                            case 4:
-                                switch (coneIdx)
-                                {
-                                    case 0:
-                                        block = isBlocked(0, radius-1, dir);
-                                        break;
-                                    case 1:
-                                        block = prevTwo(blockerIndex,radius,dir);
-                                        break;
-                                    case 2:
-                                        block = prevTwo(blockerIndex,radius,dir)
-                                                || isBlocked(1, 2, dir);
-                                        break;
-                                    case 3:
-                                        block = prevTwo(blockerIndex,radius,dir)
-                                                || prevTwo(index(2,3,dir),radius-1,dir) ;
-                                        break;
-                                }
-                                break;
-                            case 5:
-                                switch (coneIdx)
-                                {
-                                    case 0:
-                                        block = isBlocked(0, radius-1, dir);
-                                        break;
-                                    case 1:
-                                        block = prevTwo(blockerIndex,radius,dir);
-                                        break;
-                                    case 2:
-
-                                        block = (isBlocked(1, 3, dir) && (isBlocked(2,3,dir) || isBlocked(1, 4, dir)))
-                                                || (isBlocked(2,4,dir) && (isBlocked(1, 4, dir) || isBlocked(1, 3, dir)))
-                                                || ((isBlocked(1, 4, dir) || isBlocked(1, 3, dir)) & isBlocked(1,2,dir));
-                                        break;
-                                    case 3:
-                                        block = ((isBlocked(3, 4, dir) || isBlocked(2, 3, dir)) && isBlocked(2, 4, dir))
-                                                || (isBlocked(2, 3, dir) && (isBlocked(3, 4, dir) || isBlocked(1, 3, dir)))
-                                                || ((isBlocked(3, 4, dir) || isBlocked(2, 3, dir) || isBlocked(0, 2, dir + 1)) && isBlocked(1, 2, dir));
-                                        break;
-                                    case 4:
-                                        block = prevTwo(blockerIndex,radius,dir)
-                                                || prevTwo(index(3,4,dir),radius-1,dir)
-                                                || prevTwo(index(2,3,dir),radius-2,dir);
-                                        break;
-                                }
-                                break;
-                            case 6:
-                                switch (coneIdx)
-                                {
-                                    case 0:
-                                        block = isBlocked(0, radius-1, dir);
-                                        break;
-                                    case 1:
-                                        block = prevTwo(blockerIndex,radius,dir);
-                                        break;
-                                    case 2:
-                                        block = ((isBlocked(1,5, dir) || isBlocked(1,4,dir) || isBlocked(1,3,dir) || isBlocked(0,1,dir)) && isBlocked(2,5,dir))
-                                                || isBlocked(1,3,dir)
-                                                || (isBlocked(2,4,dir) && isBlocked(1,4,dir));
-                                        break;
-                                    case 3:
-                                        block =  prevTwo(blockerIndex, radius, dir)
-                                                || prevTwo(index(2,4,dir), radius-2, dir)
-                                                || isBlocked(1,2,dir)
-                                                || isBlocked(2,4,dir);
-                                        break;
-                                    case 4:
-                                        block = (prevTwo(index(3,5,dir), radius-1, dir)
-                                                || isBlocked(1,2,dir))
-                                                || isBlocked(2,3,dir)
-                                                || prevTwo(index(2,3,dir), radius-3, dir)
-                                                || ((isBlocked(4,5,dir) || isBlocked(3,4,dir) || isBlocked(2,3,dir) || isBlocked(0,1, dir+1))
-                                                    && isBlocked(3,5,dir));
-                                        break;
-                                    case 5:
-                                        block = prevTwo(blockerIndex,radius,dir)
-                                                || prevTwo(index(4,5,dir),radius-1,dir)
-                                                || prevTwo(index(3,4,dir),radius-2,dir)
-                                                || prevTwo(index(2,3,dir),radius-3,dir);
-                                        break;
-                                }
-                                break;
-                            case 7:
-                                switch (coneIdx)
-                                {
-                                    case 0:
-                                        block = isBlocked(0, radius-1, dir);
-                                        break;
-                                    case 1:
-                                        block = prevTwo(blockerIndex,radius,dir);
-                                        break;
-                                    case 2:
-                                        block = prevTwo(blockerIndex,radius,dir)
-                                                         || isBlocked(1,4,dir)
-                                                         || isBlocked(1,3,dir)
-                                                         || ((isBlocked(0, radius-1, dir) || isBlocked(2,5,dir)) && isBlocked(1,5,dir));
-
-                                        break;
-                                    case 3:
-                                        block = prevTwo(blockerIndex,radius,dir)
-                                                || (isBlocked(2,5,dir) && (isBlocked(3,6,dir) || isBlocked(3,5,dir) || isBlocked(2,3,dir)))
-                                                || isBlocked(1,2,dir)
-                                                || (isBlocked(1,3,dir) && (isBlocked(3,6,dir) || isBlocked(2,4,dir) || isBlocked(2,3,dir)))
-                                                || ((isBlocked(2,6,dir) || isBlocked(2,5,dir) || isBlocked(1,4,dir) || isBlocked(1,3,dir) || isBlocked(0,1,dir)) && isBlocked(2,4,dir));
-
-                                        break;
-                                    case 4:
-                                        block = prevTwo(blockerIndex, radius, dir)
-                                                || (isBlocked(3,5,dir) && (isBlocked(3,6,dir) || isBlocked(2,5,dir) || isBlocked(1,3,dir)))
-                                                || (isBlocked(2,4,dir) && (isBlocked(4,6,dir) || isBlocked(3,5,dir) || isBlocked(3,4,dir) || isBlocked(0,1,dir+1)))
-                                                || isBlocked(1,2,dir)
-                                                || (isBlocked(2,3,dir) && (isBlocked(3,6,dir) || isBlocked(2,4,dir) || isBlocked(1,3,dir)));
-
-                                        break;
-                                    case 5:
-                                        block = prevTwo(blockerIndex,radius, dir)
-                                                || (isBlocked(4,5,dir) && (isBlocked(4,6,dir) || isBlocked(3,5,dir) || isBlocked(1,2,dir)))
-                                                || isBlocked(2,3,dir)
-                                                || (isBlocked(0,2,dir+1) && isBlocked(1,2,dir))
-                                                || isBlocked(3,4,dir);
-
-                                        break;
-                                    case 6:
-                                        block = prevTwo(blockerIndex,radius,dir)
-                                                || prevTwo(index(5,6,dir),radius-1,dir)
-                                                || prevTwo(index(4,5,dir),radius-2,dir)
-                                                || prevTwo(index(3,4,dir),radius-3,dir)
-                                                || prevTwo(index(2,3,dir),radius-4,dir);
-                                        break;
-                                }
-                                break;
-                            case 8:
-                                switch (coneIdx)
-                                {
-                                    case 0:
-                                        block = isBlocked(0, radius-1, dir);
-                                        break;
-                                    case 1:
-                                        block = prevTwo(blockerIndex,radius,dir);
-                                        break;
-                                    case 2:
-                                        block = ((isBlocked(2,7,dir) || isBlocked(2,6,dir) || isBlocked(2,5,dir) || isBlocked(2,4,dir)) && isBlocked(1,5,dir))
-                                                || ((isBlocked(1,6,dir) || isBlocked(1,5,dir) || isBlocked(0,3,dir)) && isBlocked(1,2,dir))
-                                                || (isBlocked(1,3,dir) && (isBlocked(1,6,dir) || isBlocked(1,5,dir) || isBlocked(0,3,dir)))
-                                                || isBlocked(1,4,dir);
-                                        break;
-                                    case 3:
-                                        block = (isBlocked(3,7,dir) && (isBlocked(2,7,dir) || isBlocked(0,1,dir)))
-                                                || (isBlocked(2,6,dir) && (isBlocked(3,7,dir) || isBlocked(3,6,dir) || isBlocked(2,4,dir) || isBlocked(1,2,dir)))
-                                                || isBlocked(2,5,dir)
-                                                || (isBlocked(1,4,dir) && (isBlocked(3,7,dir) || isBlocked(2,4,dir) || isBlocked(1,2,dir) || isBlocked(2,5,dir)))
-                                                || (isBlocked(0,2,dir) && isBlocked(1,2,dir))
-                                                || ((isBlocked(3,7,dir) || isBlocked(3,6,dir) || isBlocked(2,4,dir) || isBlocked(2,3,dir) || isBlocked(1,2,dir)) && isBlocked(1,3,dir));
-
-                                        break;
-                                    case 4:
-                                        block = prevTwo(blockerIndex,radius,dir)
-                                                || prevTwo(index(3,6,dir),radius-2,dir)
-                                                || prevTwo(index(2,4,dir),radius-4,dir)
-                                                || isBlocked(3,6,dir)
-                                                || isBlocked(2,4,dir)
-                                                || isBlocked(1,2,dir);
-                                        break;
-                                    case 5:
-                                        block = (isBlocked(4,7,dir) && (isBlocked(5,7,dir) || isBlocked(0,1,dir)))
-                                                || (isBlocked(4,6,dir) && (isBlocked(4,7,dir) || isBlocked(3,6,dir) || isBlocked(2,4,dir) || isBlocked(1,2,dir)))
-                                                || isBlocked(3,5,dir)
-                                                || (isBlocked(0,2,dir+1) && isBlocked(1,2,dir))
-                                                || ((isBlocked(4,7,dir) || isBlocked(3,6,dir) || isBlocked(2,4,dir) || isBlocked(1,3,dir) || isBlocked(1,2,dir)) && isBlocked(2,3,dir))
-                                                || (isBlocked(3,4,dir) && (isBlocked(2,4,dir) || isBlocked(1,2,dir) || isBlocked(4,7,dir)));
-                                        break;
-                                    case 6:
-                                        block = ((isBlocked(5,7,dir) || isBlocked(4,6,dir) || isBlocked(3,5,dir) || isBlocked(2,4,dir)) && isBlocked(4,5,dir))
-                                                || isBlocked(3,4,dir)
-                                                || (isBlocked(2,3,dir) && (isBlocked(5,6,dir) || isBlocked(4,5,dir) || isBlocked(0,3,dir+1)))
-                                                || ((isBlocked(5,6,dir) || isBlocked(4,5,dir) || isBlocked(0,3,dir+1)) && isBlocked(1,2,dir));
-
-                                        break;
-                                    case 7:
-                                        block = prevTwo(blockerIndex,radius,dir)
-                                                || prevTwo(index(6,7,dir),radius-1,dir)
-                                                || prevTwo(index(5,6,dir),radius-2,dir)
-                                                || prevTwo(index(4,5,dir),radius-3,dir)
-                                                || prevTwo(index(3,4,dir),radius-4,dir)
-                                                || prevTwo(index(2,3,dir),radius-5,dir);
-                                        break;
-                                }
-                                break;
-                            default:
-                                break;
+    bool HexagonGrid::updateLightBlocker(Hexagon* hexagon)
+    {
+        auto blocker = LightBlocker::NONE;
+        for (auto object : hexagon->objects())
+        {
+            // dead objects block nothing
+            //if (object->dead()) continue;
+            // flat objects block nothing
+            if (object->flat()) continue;
+            if (object->type()==Game::Object::Type::DUDE) continue;
+            if (object->canLightThru()) continue;
+
+            blocker = LightBlocker::OBJECT;
+            // if wall -> check light orientation
+            if (auto wall = dynamic_cast<Game::WallObject*>(object))
+            {
+                if (wall->lightOrientation() == Game::Orientation::EW || wall->lightOrientation() == Game::Orientation::EC)
+                {
+                    blocker = LightBlocker::WALL_EW;
+                }
+                else if (wall->lightOrientation() == Game::Orientation::NC)
+                {
+                    blocker = LightBlocker::WALL_NC;
+                }
+                else if (wall->lightOrientation() == Game::Orientation::SC)
+                {
+                    blocker = LightBlocker::WALL_SC;
+                }
+                else
+                {
+                    blocker = LightBlocker::WALL;
+                }
+            }
+            break;
+        }
 
-                        }
+        auto number = hexagon->number();
+        if (_lightBlockers[number] == blocker)
+        {
+            return false;
+        }
+        _lightBlockers[number] = blocker;
+        _lightBlocked[number] = blocker != LightBlocker::NONE;
+        return true;
+    }
 
-                        if (!block)
-                        {
-                            // find objs/walls
-                            bool lightHex = true;
-                            for (auto it2 = ringhex->objects()->begin(); it2 != ringhex->objects()->end(); ++it2)
-                            {
-                                auto curObject = *it2;
-                                // dead objects block nothing
-                                //if (curObject->dead()) continue;
-                                // flat objects block nothing
-                                if (curObject->flat()) continue;
-                                if (curObject->type()==Game::Object::Type::DUDE) continue;
-
-                                if (!curObject->canLightThru())
-                                {
-                                    // if wall -> check light orientation
-                                    if (auto wall = dynamic_cast<Game::WallObject*>(curObject))
-                                    {
-                                        if (wall->lightOrientation() == Game::Orientation::EW || wall->lightOrientation() == Game::Orientation::EC)
-                                        {
-                                            if ( (dir != 4) && (dir != 5) && (dir>0 || coneIdx > 0) && (dir != 3 || ((coneIdx>=0 && coneIdx<=1) || (radius==3 && coneIdx==2) )))
-                                            {
-                                                lightHex = false;
-                                            }
-                                        }
-                                        else if (wall->lightOrientation() == Game::Orientation::NC)
-                                        {
-                                            if( dir != 0 && dir != 5)
-                                            {
-                                                lightHex = false;
-                                            }
-                                        }
-                                        else if (wall->lightOrientation() == Game::Orientation::SC)
-                                        {
-                                            if( (dir>0) && dir != 1 && dir != 4 && dir != 5 && (dir != 3 || ((coneIdx>=0 && coneIdx<=1) || (radius==3 && coneIdx==2) )))
-                                            {
-                                                lightHex = false;
-                                            }
-                                        }
-                                        else if (dir != 0 && dir != 1 && ( dir != 5 || coneIdx==0 ))
-                                        {
-                                            lightHex = false;
-                                        }
-                                    }
-                                    else
-                                    {
-                                        if (dir>=1 && dir <=3 )
-                                        {
-                                            lightHex=false;
-                                        }
-                                    }
-
-                                    block = true;
-
-                                    break;
-                                }
+    LightBlocker HexagonGrid::lightBlocker(Hexagon* hexagon) const
+    {
+        return _lightBlockers[hexagon->number()];
+    }
 
-                            }
-                            if (lightHex)
-                            {
-                                if (add) {
-                                    ringhex->addLight(light);
-                                }
-                                else {
-                                    ringhex->subLight(light);
-                                }
-                            }
-                        }
+    void HexagonGrid::_addObject(unsigned int number, Game::Object* object)
+    {
+        int32_t node;
+        if (_freeObjectNode >= 0)
+        {
+            node = _freeObjectNode;
+            _freeObjectNode = _objectNodes[node].next;
+            _objectNodes[node] = {object, -1};
+        }
+        else
+        {
+            node = static_cast<int32_t>(_objectNodes.size());
+            _objectNodes.push_back({object, -1});
+        }
 
-                        blocked[blockerIndex] = block;
-                        ringIndex++;
-                        blockerIndex++;
-                    }
+        // objects are kept in order they were added, there are only a few of them at a hexagon
+        auto* link = &_firstObjects[number];
+        while (*link >= 0)
+        {
+            link = &_objectNodes[*link].next;
+        }
+        *link = node;
+        _updateWalkFlags(number);
+    }
+
+    bool HexagonGrid::_removeObject(unsigned int number, Game::Object* object)
+    {
+        for (auto* link = &_firstObjects[number]; *link >= 0; link = &_objectNodes[*link].next)
+        {
+            auto node = *link;
+            if (_objectNodes[node].object == object)
+            {
+                *link = _objectNodes[node].next;
+                _objectNodes[node] = {nullptr, _freeObjectNode};
+                _freeObjectNode = node;
+                _updateWalkFlags(number);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void HexagonGrid::_updateWalkFlags(unsigned int number)
+    {
+        uint8_t flags = 0;
+        for (auto node = _firstObjects[number]; node >= 0; node = _objectNodes[node].next)
+        {
+            auto object = _objectNodes[node].object;
+            if (dynamic_cast<Game::DoorSceneryObject*>(object))
+            {
+                flags |= WALK_DYNAMIC;
+            }
+            else if (!object->canWalkThru())
+            {
+                flags |= WALK_BLOCKED;
+            }
+        }
+        if ((_walkFlags[number] & WALK_BLOCKED) != (flags & WALK_BLOCKED))
+        {
+            // only recent changes are remembered
+            if (_walkChanges.size() == MAX_WALK_CHANGES)
+            {
+                _walkChanges.erase(_walkChanges.begin(), _walkChanges.begin() + MAX_WALK_CHANGES / 2);
+                _walkChangesBase += MAX_WALK_CHANGES / 2;
+            }
+            _walkChanges.push_back(number);
+        }
+        _walkFlags[number] = flags;
+    }
+
+    bool HexagonGrid::_canWalkThru(unsigned int number) const
+    {
+        auto flags = _walkFlags[number];
+        if (flags & WALK_BLOCKED)
+        {
+            return false;
+        }
+        if (flags & WALK_DYNAMIC)
+        {
+            // Search hex for any blocking objects...
+            for (auto node = _firstObjects[number]; node >= 0; node = _objectNodes[node].next)
+            {
+                if (!_objectNodes[node].object->canWalkThru())
+                {
+                    return false;
                 }
             }
         }
+        return true;
     }
 }
@@ -1,35 +1,175 @@
 #pragma once
 
 #include <array>
+#include <bitset>
+#include <cstdint>
+#include <iterator>
 #include <vector>
-#include "../Base/Iterators.h"
 #include "../Graphics/Point.h"
+#include "../PathFinding/Hexagon.h"
 
 #define GRID_WIDTH 200
 #define GRID_HEIGHT 200
 
 namespace Falltergeist
 {
-    class Hexagon;
+    namespace Game
+    {
+        class Object;
+    }
 
-    class HexagonGrid
+    // The first object at a hexagon which doesn't let light through, walls let light to some sides of them
+    enum class LightBlocker : uint8_t
+    {
+        NONE = 0,
+        OBJECT,
+        WALL_EW, // EW and EC walls
+        WALL_NC,
+        WALL_SC,
+        WALL
+    };
+
+    // Amount of light added to a hexagon by a light source
+    struct LitHexagon
+    {
+        Hexagon* hexagon;
+        int light;
+    };
+
+    enum class PathResult
     {
-        using HexagonVector = std::vector<std::unique_ptr<Hexagon>>;
+        NOT_FOUND,
+        PARTIAL, // node budget ran out, path leads to the reached hexagon closest to destination
+        FOUND
+    };
 
+    class HexagonGrid
+    {
         public:
+            // Iterates over all hexagons of the grid in order of their numbers
+            class HexagonRange
+            {
+                public:
+                    class iterator : public std::iterator<std::forward_iterator_tag, Hexagon*>
+                    {
+                        public:
+                            explicit iterator(Hexagon* hexagon) : _hexagon(hexagon)
+                            {
+                            }
+
+                            Hexagon* operator *() const
+                            {
+                                return _hexagon;
+                            }
+
+                            iterator& operator ++()
+                            {
+                                ++_hexagon;
+                                return *this;
+                            }
+
+                            bool operator ==(const iterator& rhs) const
+                            {
+                                return _hexagon == rhs._hexagon;
+                            }
+
+                            bool operator !=(const iterator& rhs) const
+                            {
+                                return _hexagon != rhs._hexagon;
+                            }
+
+                        private:
+                            Hexagon* _hexagon;
+                    };
+
+                    HexagonRange(Hexagon* first, Hexagon* last) : _first(first), _last(last)
+                    {
+                    }
+
+                    iterator begin() const { return iterator(_first); }
+                    iterator end() const   { return iterator(_last); }
+
+                private:
+                    Hexagon* _first;
+                    Hexagon* _last;
+            };
+
             HexagonGrid();
             ~HexagonGrid();
-            Base::vector_ptr_decorator<Hexagon> hexagons();
+            // hexagons point to the grid, so it can't be copied
+            HexagonGrid(const HexagonGrid&) = delete;
+            HexagonGrid& operator=(const HexagonGrid&) = delete;
+
+            HexagonRange hexagons();
 
             unsigned int distance(Hexagon* from, Hexagon* to);
             Hexagon* hexagonAt(const Graphics::Point& pos);
             Hexagon* at(size_t index);
             std::vector<Hexagon*> findPath(Hexagon* from, Hexagon* to);
+            // Writes path to given buffer, starting from destination and ending with the first step.
+            // Search state lives in a workspace of the calling thread, so nothing is allocated once it and the buffer have grown.
+            // maxNodes limits number of expanded hexagons, 0 means no limit.
+            PathResult findPath(Hexagon* from, Hexagon* to, std::vector<Hexagon*>& path, unsigned int maxNodes = 0);
+            // The same search over hexagon numbers against a snapshot taken by walkableSnapshot(), may be called from any thread
+            PathResult findPath(unsigned int from, unsigned int to, const std::vector<uint8_t>& walkable, unsigned int maxNodes, std::vector<unsigned int>& path) const;
+            // Fills walkable with 1 for hexagons which can be walked through and 0 for blocked ones
+            void walkableSnapshot(std::vector<uint8_t>& walkable) const;
+
+            // Grid layout by hexagon numbers, -1 at the map's borders
+            const std::array<int32_t, HEX_SIDES>& neighborNumbers(unsigned int number) const;
+            unsigned int distance(unsigned int from, unsigned int to) const;
+            // False only if hexagon has objects which always block the way, doors are assumed to be open
+            bool mayWalkThru(unsigned int number) const;
+            // Revision of mayWalkThru() values, increased each time one of them changes
+            unsigned int walkRevision() const;
+            // Appends numbers of hexagons changed since given revision, returns false if they are not remembered anymore
+            bool walkChanges(unsigned int revision, std::vector<unsigned int>& numbers) const;
             Hexagon* hexInDirection(Hexagon* from, unsigned short rotation, unsigned int distance);
             std::vector<Hexagon*> ring(Hexagon* from, unsigned int radius);
-            void initLight(Hexagon* hex, bool add = true);
+            // Collects hexagons lit by given light source placed at hex, including hex itself
+            void initLight(Hexagon* hex, Game::Object* object, std::vector<LitHexagon>& lit);
+
+            // Must be called when objects at hexagon change, returns true if light blocker has changed
+            bool updateLightBlocker(Hexagon* hexagon);
+            LightBlocker lightBlocker(Hexagon* hexagon) const;
 
         protected:
-            HexagonVector _hexagons; // The 200x200 grid
+            friend class Hexagon;
+
+            enum WalkFlags : uint8_t
+            {
+                WALK_BLOCKED = 1 << 0,
+                // objects which can change their walkability, e.g. doors, are asked each time
+                WALK_DYNAMIC = 1 << 1
+            };
+
+            // The 200x200 grid, all the arrays below are indexed by hexagon number
+            std::vector<Hexagon> _hexagons;
+            std::vector<Point> _positions;
+            std::vector<int16_t> _cubeX;
+            std::vector<int16_t> _cubeZ; // cube y is -x-z
+            std::vector<std::array<int32_t, HEX_SIDES>> _neighbors; // -1 at the map's borders
+            std::vector<unsigned int> _light;
+            std::vector<uint8_t> _walkFlags;
+            // index of the first object node of each hexagon, -1 if there are no objects
+            std::vector<int32_t> _firstObjects;
+            std::vector<HexagonObjectNode> _objectNodes;
+            int32_t _freeObjectNode = -1;
+            // numbers of hexagons which mayWalkThru() has changed, the first one is of revision _walkChangesBase
+            std::vector<unsigned int> _walkChanges;
+            unsigned int _walkChangesBase = 0;
+            // light blockers of this elevation
+            std::bitset<GRID_WIDTH * GRID_HEIGHT> _lightBlocked;
+            std::vector<LightBlocker> _lightBlockers;
+
+            unsigned int _distance(unsigned int from, unsigned int to) const;
+            // A* from start to goal over hexagons accepted by walkable(number), last is the hexagon path ends at
+            template <typename Walkable>
+            PathResult _searchPath(unsigned int start, unsigned int goal, const Walkable& walkable, unsigned int maxNodes, unsigned int& last) const;
+
+            void _addObject(unsigned int number, Game::Object* object);
+            bool _removeObject(unsigned int number, Game::Object* object);
+            void _updateWalkFlags(unsigned int number);
+            bool _canWalkThru(unsigned int number) const;
     };
 }
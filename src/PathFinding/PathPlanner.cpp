@@ -0,0 +1,387 @@
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include "../PathFinding/Hexagon.h"
+#include "../PathFinding/PathPlanner.h"
+
+namespace Falltergeist
+{
+    namespace
+    {
+        const uint16_t UNREACHABLE = 0xFFFF;
+    }
+
+    PathPlanner::PathPlanner(HexagonGrid* grid, size_t cacheSize)
+        : _grid(grid),
+          _cacheSize(cacheSize),
+          _blocks(BLOCK_COLUMNS * BLOCK_ROWS),
+          _portalIndex(GRID_WIDTH * GRID_HEIGHT, -1),
+          _routes([](const Route&) { return static_cast<size_t>(1); }),
+          _stamps(GRID_WIDTH * GRID_HEIGHT, 0),
+          _costs(GRID_WIDTH * GRID_HEIGHT, 0),
+          _parents(GRID_WIDTH * GRID_HEIGHT, -1)
+    {
+    }
+
+    PathResult PathPlanner::findPath(Hexagon* from, Hexagon* to, std::vector<Hexagon*>& path)
+    {
+        path.clear();
+        auto start = from->number();
+        auto goal = to->number();
+        if (!usesPortals(start, goal))
+        {
+            return _grid->findPath(from, to, path);
+        }
+        if (!to->canWalkThru())
+        {
+            return PathResult::NOT_FOUND;
+        }
+
+        _update();
+        _routes.setEpoch(++_tick);
+
+        auto fromBlock = _blockOf(start);
+        auto toBlock = _blockOf(goal);
+        uint32_t key = fromBlock * BLOCK_COLUMNS * BLOCK_ROWS + toBlock;
+        if (auto route = _routes.get(key, _tick))
+        {
+            if (_valid(*route) && _refine(from, to, route->portals, path))
+            {
+                return PathResult::FOUND;
+            }
+            _routes.erase(key);
+        }
+
+        if (_searchPortals(start, goal, _chain) && _refine(from, to, _chain, path))
+        {
+            auto route = std::make_unique<Route>();
+            route->portals = _chain;
+            for (auto portal : _chain)
+            {
+                auto block = _blockOf(portal);
+                if (route->blocks.empty() || route->blocks.back().first != block)
+                {
+                    route->blocks.emplace_back(block, _blocks[block].version);
+                }
+            }
+            _routes.insert(key, std::move(route), _tick);
+            while (_routes.size() > _cacheSize && _routes.evictOldest())
+            {
+            }
+            return PathResult::FOUND;
+        }
+
+        // portals assume doors are open
+        return _grid->findPath(from, to, path);
+    }
+
+    bool PathPlanner::usesPortals(unsigned int from, unsigned int to) const
+    {
+        // short paths are found faster without portals
+        return _blockOf(from) != _blockOf(to) && _grid->distance(from, to) >= BLOCK_SIZE;
+    }
+
+    unsigned int PathPlanner::_blockOf(unsigned int number) const
+    {
+        return (number / GRID_WIDTH / BLOCK_SIZE) * BLOCK_COLUMNS + (number % GRID_WIDTH) / BLOCK_SIZE;
+    }
+
+    unsigned int PathPlanner::_localIndex(unsigned int number) const
+    {
+        return (number / GRID_WIDTH % BLOCK_SIZE) * BLOCK_SIZE + number % GRID_WIDTH % BLOCK_SIZE;
+    }
+
+    void PathPlanner::_update()
+    {
+        if (_grid->walkChanges(_walkRevision, _walkChanges))
+        {
+            // portals between a changed block and its neighbors change for both of them
+            for (auto number : _walkChanges)
+            {
+                int row = static_cast<int>(_blockOf(number) / BLOCK_COLUMNS);
+                int column = static_cast<int>(_blockOf(number) % BLOCK_COLUMNS);
+                for (int neighborRow = std::max(row - 1, 0); neighborRow <= std::min(row + 1, static_cast<int>(BLOCK_ROWS) - 1); ++neighborRow)
+                {
+                    for (int neighborColumn = std::max(column - 1, 0); neighborColumn <= std::min(column + 1, static_cast<int>(BLOCK_COLUMNS) - 1); ++neighborColumn)
+                    {
+                        _blocks[neighborRow * BLOCK_COLUMNS + neighborColumn].dirty = true;
+                    }
+                }
+            }
+        }
+        else
+        {
+            for (auto& block : _blocks)
+            {
+                block.dirty = true;
+            }
+        }
+        _walkChanges.clear();
+        _walkRevision = _grid->walkRevision();
+
+        for (unsigned int block = 0; block != _blocks.size(); ++block)
+        {
+            if (_blocks[block].dirty)
+            {
+                _rebuild(block);
+            }
+        }
+    }
+
+    void PathPlanner::_rebuild(unsigned int index)
+    {
+        auto& block = _blocks[index];
+        for (auto portal : block.portals)
+        {
+            _portalIndex[portal] = -1;
+        }
+        block.portals.clear();
+        block.links.clear();
+
+        int row = static_cast<int>(index / BLOCK_COLUMNS);
+        int column = static_cast<int>(index % BLOCK_COLUMNS);
+        for (int neighborRow = std::max(row - 1, 0); neighborRow <= std::min(row + 1, static_cast<int>(BLOCK_ROWS) - 1); ++neighborRow)
+        {
+            for (int neighborColumn = std::max(column - 1, 0); neighborColumn <= std::min(column + 1, static_cast<int>(BLOCK_COLUMNS) - 1); ++neighborColumn)
+            {
+                unsigned int neighbor = neighborRow * BLOCK_COLUMNS + neighborColumn;
+                if (neighbor == index)
+                {
+                    continue;
+                }
+
+                // both blocks must choose the same portals, so the border is always scanned from the lower one
+                _borderLinks.clear();
+                _findBorderLinks(std::min(index, neighbor), std::max(index, neighbor), _borderLinks);
+                for (auto& link : _borderLinks)
+                {
+                    auto portal = index < neighbor ? link.first : link.second;
+                    auto target = index < neighbor ? link.second : link.first;
+                    if (_portalIndex[portal] < 0)
+                    {
+                        _portalIndex[portal] = static_cast<int16_t>(block.portals.size());
+                        block.portals.push_back(portal);
+                    }
+                    block.links.emplace_back(_portalIndex[portal], target);
+                }
+            }
+        }
+
+        auto count = block.portals.size();
+        block.distances.assign(count * count, UNREACHABLE);
+        for (size_t i = 0; i != count; ++i)
+        {
+            _blockDistances(block.portals[i], _fromDistances);
+            for (size_t j = 0; j != count; ++j)
+            {
+                block.distances[i * count + j] = _fromDistances[_localIndex(block.portals[j])];
+            }
+        }
+
+        ++block.version;
+        block.dirty = false;
+    }
+
+    void PathPlanner::_findBorderLinks(unsigned int a, unsigned int b, std::vector<std::pair<unsigned int, unsigned int>>& links)
+    {
+        _borderEdges.clear();
+        unsigned int firstRow = a / BLOCK_COLUMNS * BLOCK_SIZE;
+        unsigned int firstColumn = a % BLOCK_COLUMNS * BLOCK_SIZE;
+        // rows and columns are scanned in order, so hexagons along the border come one after another
+        for (unsigned int row = firstRow; row != firstRow + BLOCK_SIZE; ++row)
+        {
+            for (unsigned int column = firstColumn; column != firstColumn + BLOCK_SIZE; ++column)
+            {
+                unsigned int number = row * GRID_WIDTH + column;
+                if (!_grid->mayWalkThru(number))
+                {
+                    continue;
+                }
+                for (auto neighbor : _grid->neighborNumbers(number))
+                {
+                    if (neighbor >= 0 && _blockOf(neighbor) == b && _grid->mayWalkThru(neighbor))
+                    {
+                        _borderEdges.emplace_back(number, neighbor);
+                    }
+                }
+            }
+        }
+
+        // the middle pair of each continuous part of the border becomes a portal
+        size_t partBegin = 0;
+        for (size_t i = 1; i <= _borderEdges.size(); ++i)
+        {
+            if (i != _borderEdges.size())
+            {
+                auto previous = _borderEdges[i - 1].first;
+                auto current = _borderEdges[i].first;
+                auto& neighbors = _grid->neighborNumbers(current);
+                if (previous == current || std::find(neighbors.begin(), neighbors.end(), static_cast<int32_t>(previous)) != neighbors.end())
+                {
+                    continue;
+                }
+            }
+            links.push_back(_borderEdges[partBegin + (i - partBegin) / 2]);
+            partBegin = i;
+        }
+    }
+
+    void PathPlanner::_blockDistances(unsigned int start, std::vector<uint16_t>& distances)
+    {
+        distances.assign(BLOCK_SIZE * BLOCK_SIZE, UNREACHABLE);
+        auto block = _blockOf(start);
+        distances[_localIndex(start)] = 0;
+        _queue.clear();
+        _queue.push_back(start);
+        for (size_t i = 0; i != _queue.size(); ++i)
+        {
+            auto current = _queue[i];
+            auto distance = distances[_localIndex(current)];
+            for (auto neighbor : _grid->neighborNumbers(current))
+            {
+                if (neighbor < 0 || _blockOf(neighbor) != block || !_grid->mayWalkThru(neighbor))
+                {
+                    continue;
+                }
+                auto& neighborDistance = distances[_localIndex(neighbor)];
+                if (neighborDistance == UNREACHABLE)
+                {
+                    neighborDistance = distance + 1;
+                    _queue.push_back(neighbor);
+                }
+            }
+        }
+    }
+
+    bool PathPlanner::_searchPortals(unsigned int from, unsigned int to, std::vector<unsigned int>& chain)
+    {
+        chain.clear();
+        auto toBlock = _blockOf(to);
+        _blockDistances(from, _fromDistances);
+        _blockDistances(to, _toDistances);
+
+        if (++_generation == 0)
+        {
+            std::fill(_stamps.begin(), _stamps.end(), 0);
+            _generation = 1;
+        }
+        _open.clear();
+
+        auto visit = [this, to](unsigned int portal, unsigned int cost, int32_t parent) {
+            if (_stamps[portal] == _generation && cost >= _costs[portal])
+            {
+                return;
+            }
+            _stamps[portal] = _generation;
+            _costs[portal] = cost;
+            _parents[portal] = parent;
+            _open.push_back(static_cast<uint64_t>(cost + _grid->distance(portal, to)) << 32 | portal);
+            std::push_heap(_open.begin(), _open.end(), std::greater<uint64_t>());
+        };
+
+        for (auto portal : _blocks[_blockOf(from)].portals)
+        {
+            auto distance = _fromDistances[_localIndex(portal)];
+            if (distance != UNREACHABLE)
+            {
+                visit(portal, distance, -1);
+            }
+        }
+
+        unsigned int best = UINT32_MAX;
+        int32_t bestPortal = -1;
+        while (!_open.empty())
+        {
+            std::pop_heap(_open.begin(), _open.end(), std::greater<uint64_t>());
+            auto node = _open.back();
+            _open.pop_back();
+            auto estimate = static_cast<unsigned int>(node >> 32);
+            auto portal = static_cast<unsigned int>(node & 0xFFFFFFFF);
+            if (estimate >= best)
+            {
+                break;
+            }
+            auto cost = _costs[portal];
+            // the portal was pushed again with lower cost
+            if (cost + _grid->distance(portal, to) != estimate)
+            {
+                continue;
+            }
+
+            auto blockIndex = _blockOf(portal);
+            if (blockIndex == toBlock)
+            {
+                auto distance = _toDistances[_localIndex(portal)];
+                if (distance != UNREACHABLE && cost + distance < best)
+                {
+                    best = cost + distance;
+                    bestPortal = static_cast<int32_t>(portal);
+                }
+            }
+
+            auto& block = _blocks[blockIndex];
+            auto index = static_cast<size_t>(_portalIndex[portal]);
+            auto count = block.portals.size();
+            for (size_t i = 0; i != count; ++i)
+            {
+                auto distance = block.distances[index * count + i];
+                if (i != index && distance != UNREACHABLE)
+                {
+                    visit(block.portals[i], cost + distance, static_cast<int32_t>(portal));
+                }
+            }
+            for (auto& link : block.links)
+            {
+                if (link.first == index && _portalIndex[link.second] >= 0)
+                {
+                    visit(link.second, cost + 1, static_cast<int32_t>(portal));
+                }
+            }
+        }
+
+        if (bestPortal < 0)
+        {
+            return false;
+        }
+        for (auto portal = bestPortal; portal >= 0; portal = _parents[portal])
+        {
+            chain.push_back(static_cast<unsigned int>(portal));
+        }
+        std::reverse(chain.begin(), chain.end());
+        return true;
+    }
+
+    bool PathPlanner::_refine(Hexagon* from, Hexagon* to, const std::vector<unsigned int>& chain, std::vector<Hexagon*>& path)
+    {
+        path.clear();
+        // paths go from destination to the first step, so segments are joined starting from the last one
+        Hexagon* segmentEnd = to;
+        for (size_t i = chain.size() + 1; i-- > 0;)
+        {
+            Hexagon* segmentStart = i == 0 ? from : _grid->at(chain[i - 1]);
+            if (segmentStart == segmentEnd)
+            {
+                continue;
+            }
+            if (_grid->findPath(segmentStart, segmentEnd, _segment) != PathResult::FOUND)
+            {
+                return false;
+            }
+            path.insert(path.end(), _segment.begin(), _segment.end());
+            segmentEnd = segmentStart;
+        }
+        return true;
+    }
+
+    bool PathPlanner::_valid(const Route& route) const
+    {
+        for (auto& block : route.blocks)
+        {
+            if (_blocks[block.first].version != block.second)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "../Base/LruCache.h"
+#include "../PathFinding/HexagonGrid.h"
+
+namespace Falltergeist
+{
+    class Hexagon;
+
+    /**
+     * @brief Finds long paths through portals between blocks of hexagons
+     *
+     * The grid is split into square blocks. Walkable hexagon pairs on block borders become portals,
+     * and distances between portals of each block are precomputed. Far destinations are searched
+     * on this small graph first, then each step between portals is refined with HexagonGrid::findPath().
+     * Blocks are rebuilt only when walkability of their hexagons or their neighbors' hexagons changes.
+     * Recent portal chains are cached by pair of start and destination blocks.
+     */
+    class PathPlanner final
+    {
+        public:
+            explicit PathPlanner(HexagonGrid* grid, size_t cacheSize = 64);
+
+            // The same as HexagonGrid::findPath(), but isn't limited by path length
+            PathResult findPath(Hexagon* from, Hexagon* to, std::vector<Hexagon*>& path);
+
+            // Whether findPath() goes through portals for given hexagons, other paths are left to HexagonGrid alone
+            bool usesPortals(unsigned int from, unsigned int to) const;
+
+        private:
+            static const unsigned int BLOCK_SIZE = 10;
+            static const unsigned int BLOCK_COLUMNS = GRID_WIDTH / BLOCK_SIZE;
+            static const unsigned int BLOCK_ROWS = GRID_HEIGHT / BLOCK_SIZE;
+
+            struct Block
+            {
+                // numbers of portal hexagons
+                std::vector<unsigned int> portals;
+                // portal index and number of hexagon in neighbor block it leads to
+                std::vector<std::pair<unsigned int, unsigned int>> links;
+                // distances between portals inside the block, portals.size() squared
+                std::vector<uint16_t> distances;
+                uint32_t version = 0;
+                bool dirty = true;
+            };
+
+            struct Route
+            {
+                std::vector<unsigned int> portals;
+                // blocks the route goes through and their versions at the moment it was found
+                std::vector<std::pair<unsigned int, uint32_t>> blocks;
+            };
+
+            HexagonGrid* _grid;
+            size_t _cacheSize;
+            std::vector<Block> _blocks;
+            // index of portal in its block for each hexagon, -1 if it isn't a portal
+            std::vector<int16_t> _portalIndex;
+            unsigned int _walkRevision = 0;
+            std::vector<unsigned int> _walkChanges;
+            Base::LruCache<uint32_t, Route> _routes;
+            uint64_t _tick = 0;
+
+            // portal graph search state
+            std::vector<uint32_t> _stamps;
+            std::vector<uint32_t> _costs;
+            std::vector<int32_t> _parents;
+            std::vector<uint64_t> _open;
+            uint32_t _generation = 0;
+
+            // distances inside a block from its start and destination hexagons
+            std::vector<uint16_t> _fromDistances;
+            std::vector<uint16_t> _toDistances;
+            std::vector<unsigned int> _queue;
+            std::vector<std::pair<unsigned int, unsigned int>> _borderEdges;
+            std::vector<std::pair<unsigned int, unsigned int>> _borderLinks;
+            std::vector<unsigned int> _chain;
+            std::vector<Hexagon*> _segment;
+
+            unsigned int _blockOf(unsigned int number) const;
+            unsigned int _localIndex(unsigned int number) const;
+
+            void _update();
+            void _rebuild(unsigned int block);
+            // walkable hexagon pairs chosen as portals between blocks a < b, one pair for each part of their border
+            void _findBorderLinks(unsigned int a, unsigned int b, std::vector<std::pair<unsigned int, unsigned int>>& links);
+            // breadth-first search limited to the block of start, distances are indexed by _localIndex()
+            void _blockDistances(unsigned int start, std::vector<uint16_t>& distances);
+
+            bool _searchPortals(unsigned int from, unsigned int to, std::vector<unsigned int>& chain);
+            // Joins steps from start through all portals of chain to destination
+            bool _refine(Hexagon* from, Hexagon* to, const std::vector<unsigned int>& chain, std::vector<Hexagon*>& path);
+            bool _valid(const Route& route) const;
+    };
+}
@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <chrono>
+#include "../Base/ThreadPool.h"
+#include "../Game/Object.h"
+#include "../PathFinding/Hexagon.h"
+#include "../PathFinding/PathPlanner.h"
+#include "../PathFinding/PathQueue.h"
+
+namespace Falltergeist
+{
+    namespace
+    {
+        // searches are short, a couple of workers keep up with all critters of a map
+        const size_t WORKERS = 2;
+    }
+
+    PathQueue::PathQueue(HexagonGrid* grid, PathPlanner* planner) : _grid(grid), _planner(planner)
+    {
+    }
+
+    PathQueue::~PathQueue()
+    {
+        for (auto& batch : _batches)
+        {
+            for (auto& job : batch->jobs)
+            {
+                job.done.wait();
+            }
+        }
+    }
+
+    void PathQueue::request(Game::Object* owner, Hexagon* from, Hexagon* to, unsigned int maxNodes, Callback callback)
+    {
+        _mute(owner);
+
+        Query query;
+        query.owner = owner;
+        query.from = from->number();
+        query.to = to->number();
+        query.maxNodes = maxNodes;
+        query.callback = std::move(callback);
+        query.planned = false;
+        query.result = PathResult::NOT_FOUND;
+        _queued.push_back(std::move(query));
+    }
+
+    void PathQueue::cancel(Game::Object* owner)
+    {
+        _mute(owner);
+    }
+
+    void PathQueue::_mute(Game::Object* owner)
+    {
+        _queued.erase(
+            std::remove_if(_queued.begin(), _queued.end(), [owner](const Query& query) {
+                return query.owner == owner;
+            }),
+            _queued.end()
+        );
+        // dispatched queries are still being searched, so they are only muted
+        for (auto& batch : _batches)
+        {
+            for (auto& query : batch->queries)
+            {
+                if (query.owner == owner)
+                {
+                    query.callback = nullptr;
+                }
+            }
+        }
+    }
+
+    void PathQueue::dispatch()
+    {
+        if (_queued.empty())
+        {
+            return;
+        }
+
+        if (!_threadPool)
+        {
+            _threadPool = std::make_unique<Base::ThreadPool>(std::min<size_t>(WORKERS, std::max(1u, std::thread::hardware_concurrency())));
+        }
+
+        // only the limit of path length is lifted, limited searches stay with the grid
+        if (_planner)
+        {
+            for (auto& query : _queued)
+            {
+                if (query.maxNodes != 0 || !_planner->usesPortals(query.from, query.to))
+                {
+                    continue;
+                }
+                query.result = _planner->findPath(_grid->at(query.from), _grid->at(query.to), _path);
+                for (auto hexagon : _path)
+                {
+                    query.path.push_back(hexagon->number());
+                }
+                query.planned = true;
+            }
+        }
+
+        auto batch = std::make_unique<Batch>();
+        _grid->walkableSnapshot(batch->walkable);
+        batch->queries.swap(_queued);
+
+        auto& queries = batch->queries;
+        auto jobCount = std::min(_threadPool->size(), queries.size());
+        auto perJob = (queries.size() + jobCount - 1) / jobCount;
+        for (size_t first = 0; first < queries.size(); first += perJob)
+        {
+            auto last = std::min(first + perJob, queries.size());
+            // workers only touch results of their own queries, the grid and the snapshot are read-only
+            auto data = batch.get();
+            Job job;
+            job.first = first;
+            job.last = last;
+            job.done = _threadPool->enqueue([this, data, first, last]() {
+                for (auto i = first; i != last; ++i)
+                {
+                    auto& query = data->queries[i];
+                    if (query.planned)
+                    {
+                        continue;
+                    }
+                    query.result = _grid->findPath(query.from, query.to, data->walkable, query.maxNodes, query.path);
+                }
+            });
+            batch->jobs.push_back(std::move(job));
+        }
+        _batches.push_back(std::move(batch));
+    }
+
+    void PathQueue::deliver()
+    {
+        while (!_batches.empty())
+        {
+            auto& batch = *_batches.front();
+            while (!batch.jobs.empty())
+            {
+                auto& job = batch.jobs.front();
+                // unfinished searches stay queued until one of the next ticks
+                if (job.done.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                {
+                    return;
+                }
+                job.done.get();
+                for (auto i = job.first; i != job.last; ++i)
+                {
+                    _deliver(batch.queries[i]);
+                }
+                batch.jobs.pop_front();
+            }
+            _batches.pop_front();
+        }
+    }
+
+    void PathQueue::_deliver(Query& query)
+    {
+        if (!query.callback)
+        {
+            return;
+        }
+        // callback may cancel queries, including its own
+        auto callback = std::move(query.callback);
+        query.callback = nullptr;
+
+        // owner was moved while the path was searched, so the path doesn't start where it stands
+        auto hexagon = query.owner->hexagon();
+        if (!hexagon)
+        {
+            return;
+        }
+        if (hexagon->number() != query.from)
+        {
+            request(query.owner, hexagon, _grid->at(query.to), query.maxNodes, std::move(callback));
+            return;
+        }
+
+        _path.clear();
+        for (auto number : query.path)
+        {
+            _path.push_back(_grid->at(number));
+        }
+        callback(query.result, _path);
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+#include "../PathFinding/HexagonGrid.h"
+
+namespace Falltergeist
+{
+    namespace Base
+    {
+        class ThreadPool;
+    }
+
+    namespace Game
+    {
+        class Object;
+    }
+
+    class Hexagon;
+    class PathPlanner;
+
+    /**
+     * @brief Solves many path queries at once on worker threads
+     *
+     * Queries made during a tick are searched in parallel when dispatch() is called,
+     * against a snapshot of walkable hexagons taken at that moment.
+     * Results are delivered to callbacks by deliver() on the main thread, at the start of the first tick when they are ready.
+     * A query whose owner has left the start hexagon meanwhile is searched again from where the owner is.
+     * Searches have a small pool of their own, so they never wait behind loading of resources.
+     * Unlimited queries between far hexagons are planned through portals by PathPlanner instead,
+     * on the main thread when they are dispatched, since the planner keeps state of its own.
+     */
+    class PathQueue final
+    {
+        public:
+            using Callback = std::function<void(PathResult result, const std::vector<Hexagon*>& path)>;
+
+            // planner may be null, then all paths are limited the same way as in HexagonGrid::findPath()
+            PathQueue(HexagonGrid* grid, PathPlanner* planner);
+            // Waits for dispatched searches, their callbacks are not called
+            ~PathQueue();
+
+            // Queries are owned by objects, so they can be cancelled when object goes away.
+            // A new query replaces queries of the same owner which are not delivered yet.
+            // maxNodes limits the search the same way as in HexagonGrid::findPath().
+            void request(Game::Object* owner, Hexagon* from, Hexagon* to, unsigned int maxNodes, Callback callback);
+            void cancel(Game::Object* owner);
+
+            // Starts searching queries made since the last call
+            void dispatch();
+            // Calls callbacks of finished searches, never waits for the rest
+            void deliver();
+
+        private:
+            struct Query
+            {
+                Game::Object* owner;
+                unsigned int from;
+                unsigned int to;
+                unsigned int maxNodes;
+                Callback callback;
+                // already found by the planner, workers skip it
+                bool planned;
+                // written by workers
+                PathResult result;
+                std::vector<unsigned int> path;
+            };
+
+            struct Job
+            {
+                std::future<void> done;
+                size_t first;
+                size_t last;
+            };
+
+            // Queries dispatched at once, the snapshot and queries stay in place while their jobs run
+            struct Batch
+            {
+                std::vector<Query> queries;
+                std::vector<uint8_t> walkable;
+                // jobs which are not delivered yet, in order
+                std::deque<Job> jobs;
+            };
+
+            HexagonGrid* _grid;
+            PathPlanner* _planner;
+            std::vector<Query> _queued;
+            // batches in order of dispatch, results are delivered in the same order
+            std::deque<std::unique_ptr<Batch>> _batches;
+            std::vector<Hexagon*> _path;
+            std::unique_ptr<Base::ThreadPool> _threadPool;
+
+            void _mute(Game::Object* owner);
+            void _deliver(Query& query);
+    };
+}
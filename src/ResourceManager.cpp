@@ -1,14 +1,18 @@
-﻿#include <fstream>
+﻿#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <locale>
 #include <memory>
 #include <utility>
 #include <SDL_image.h>
+#include "Base/ThreadPool.h"
 #include "CrossPlatform.h"
 #include "Exception.h"
 #include "Format/Acm/File.h"
 #include "Format/Bio/File.h"
+#include "Format/Dat/DiskCache.h"
 #include "Format/Dat/Stream.h"
 #include "Format/Dat/File.h"
 #include "Format/Dat/MiscFile.h"
@@ -31,14 +35,18 @@
 #include "Format/Txt/CSVBasedFile.h"
 #include "Format/Txt/MapsFile.h"
 #include "Format/Txt/WorldmapFile.h"
+#include "Game/Game.h"
 #include "Game/Location.h"
 #include "Graphics/Font.h"
 #include "Graphics/Font/AAF.h"
 #include "Graphics/Font/FON.h"
+#include "Graphics/Renderer.h"
 #include "Graphics/Texture.h"
+#include "Graphics/TextureAtlas.h"
 #include "Graphics/Shader.h"
 #include "Logger.h"
 #include "ResourceManager.h"
+#include "Settings.h"
 #include "Ini/File.h"
 
 namespace Falltergeist
@@ -52,14 +60,77 @@ namespace Falltergeist
         {
             return ResourceManager::getInstance()->proFileType(PID);
         }
+
+        // Users keep pointers to items of these types for a long time, so such items are never evicted
+        template <class T> struct IsLongLivedItem : std::false_type {};
+        template <> struct IsLongLivedItem<Aaf::File> : std::true_type {};
+        template <> struct IsLongLivedItem<Acm::File> : std::true_type {};
+        template <> struct IsLongLivedItem<Fon::File> : std::true_type {};
+        template <> struct IsLongLivedItem<Int::File> : std::true_type {};
+        template <> struct IsLongLivedItem<Lip::File> : std::true_type {};
+        template <> struct IsLongLivedItem<Mve::File> : std::true_type {};
+        template <> struct IsLongLivedItem<Sve::File> : std::true_type {};
+        template <> struct IsLongLivedItem<Dat::MiscFile> : std::true_type {};
+
+        // Prototype directories and LST file names by object type
+        const char* const PROTO_TYPES[] = {"items", "critters", "scenery", "walls", "tiles", "misc"};
+
+        // Path to prototype file of given PID taken from given LST contents, or empty string if PID is out of range
+        string protoFilename(unsigned int PID, const vector<string>& names)
+        {
+            unsigned int index = 0x00000FFF & PID;
+            if (index == 0 || index > names.size()) {
+                return "";
+            }
+            return string("proto/") + PROTO_TYPES[PID >> 24] + "/" + names.at(index - 1);
+        }
+
+        bool hasExtension(const string& path, const char* extension)
+        {
+            auto length = std::char_traits<char>::length(extension);
+            return path.size() > length && path.compare(path.size() - length, length, extension) == 0;
+        }
     }
 
-ResourceManager::ResourceManager()
+ResourceManager::ResourceManager() :
+    _datItems([](const Dat::Item& item) { return item.memoryUsage(); }),
+    _textures([](const Graphics::Texture& texture) { return texture.memoryUsage(); }),
+    _fonts([](const Graphics::Font& font) { return font.memoryUsage(); }),
+    _shaders([](const Graphics::Shader&) { return size_t(0); })
 {
+    auto settings = Game::Game::getInstance()->settings();
+    bool memoryMapped = settings ? settings->memoryMappedDatFiles() : true;
+    _memoryBudget = settings ? static_cast<size_t>(settings->memoryBudget()) * 1024 * 1024 : 0;
+
     for (auto filename : CrossPlatform::findFalloutDataFiles())
     {
         string path = CrossPlatform::findFalloutDataPath() + "/" + filename;
-        _datFiles.push_back(std::make_unique<Dat::File>(path));
+        _datFiles.push_back(std::make_unique<Dat::File>(path, memoryMapped));
+    }
+
+    // Loose files override DAT contents, the same way as in the original game.
+    // Fallout data path may be the whole game or executable directory, so only directories which archives have are scanned there.
+    vector<Dat::File*> datFiles;
+    for (auto& datFile : _datFiles)
+    {
+        datFiles.push_back(datFile.get());
+    }
+    _fileSystem.addDirectory(CrossPlatform::findFalloutDataPath(), "", VirtualFileSystem::topDirectories(datFiles));
+    _fileSystem.addDirectory(CrossPlatform::findFalltergeistDataPath() + "/data", "data/");
+    for (auto& datFile : _datFiles)
+    {
+        _fileSystem.addDatFile(datFile.get());
+    }
+    _fileSystem.build();
+    Logger::info("RESOURCE MANAGER") << "Indexed " << _fileSystem.size() << " files" << endl;
+
+    if (settings && !settings->cachePath().empty()) {
+        try {
+            CrossPlatform::createDirectory(settings->cachePath());
+            _diskCache = std::make_unique<Dat::DiskCache>(settings->cachePath());
+        } catch (const std::runtime_error& e) {
+            Logger::warning("RESOURCE MANAGER") << "Disk cache is disabled: " << e.what() << endl;
+        }
     }
 }
 
@@ -69,52 +140,280 @@ ResourceManager* ResourceManager::getInstance()
     return Base::Singleton<ResourceManager>::get();
 }
 
-void ResourceManager::_loadStreamForFile(string filename, std::function<void(Dat::Stream&&)> callback) {
-    // Searching file in Fallout data directory
-    {
-        string path = CrossPlatform::findFalloutDataPath() + "/" + filename;
+// Destructor is defined here since Base::ThreadPool is incomplete in the header
+ResourceManager::~ResourceManager() = default;
 
-        ifstream stream;
-        stream.open(path, ios_base::binary);
-        if (stream.is_open()) {
-            Logger::debug("RESOURCE MANAGER") << "Loading file: " << filename << " [FROM FALLOUT DATA DIR]" << endl;
-        } else {
-            path = CrossPlatform::findFalltergeistDataPath() + "/" + filename;
-            stream.open(path, ios_base::binary);
-            if (stream.is_open()) {
-                Logger::debug("RESOURCE MANAGER") << "Loading file: " << filename << " [FROM FALLTERGEIST DATA DIR]" << endl;
-            }
+unique_ptr<Dat::Stream> ResourceManager::_createStream(const VirtualFileSystem::Record& record)
+{
+    // Plain file from Fallout or Falltergeist data directory
+    if (record.entry == nullptr) {
+        ifstream stream(_fileSystem.diskPath(record), ios_base::binary);
+        if (!stream.is_open()) {
+            return nullptr;
         }
+        return std::make_unique<Dat::Stream>(stream);
+    }
 
-        if (stream.is_open()) {
-            callback(Dat::Stream(stream));
-            stream.close();
+    // only packed entries are worth caching, unpacked ones are read straight from the archive
+    auto entry = record.entry;
+    if (_diskCache && entry->compressed()) {
+        auto stream = _diskCache->load(*entry);
+        if (stream) {
+            return stream;
+        }
+        stream = std::make_unique<Dat::Stream>(*entry);
+        _diskCache->store(*entry, *stream);
+        return stream;
+    }
+    return std::make_unique<Dat::Stream>(*entry);
+}
+
+void ResourceManager::_loadStreamForFile(const VirtualFileSystem::Record& record, std::function<void(Dat::Stream&&)> callback) {
+    // Take the data prepared by prefetch() if there is any
+    auto prefetchedIt = _prefetchedStreams.find(&record);
+    if (prefetchedIt != _prefetchedStreams.end()) {
+        prefetchedIt->second.ready.wait();
+        auto stream = std::move(*prefetchedIt->second.stream);
+        _prefetchedStreams.erase(prefetchedIt);
+        if (stream) {
+            Logger::debug("RESOURCE MANAGER") << "Loading file: " << _fileSystem.path(record) << " [PREFETCHED]" << endl;
+            callback(std::move(*stream));
             return;
         }
     }
 
-    // Search in DAT files
-    for (auto& datfile : _datFiles) {
-        auto entry = datfile->entry(filename);
-        if (entry != nullptr) {
-            Logger::debug("RESOURCE MANAGER") << "Loading file: " << filename << " [FROM " << datfile->filename() << "]" << endl;
-            callback(Dat::Stream(*entry));
-            return;
+    auto stream = _createStream(record);
+    if (stream) {
+        Logger::debug("RESOURCE MANAGER") << "Loading file: " << _fileSystem.path(record) << " [FROM " << _fileSystem.sourceName(record) << "]" << endl;
+        callback(std::move(*stream));
+        return;
+    }
+    Logger::error("RESOURCE MANAGER") << "Loading file: " << _fileSystem.path(record) << " [CAN'T READ]" << endl;
+}
+
+vector<shared_future<void>> ResourceManager::prefetch(const vector<string>& filenames)
+{
+    _startThreadPool();
+
+    vector<shared_future<void>> futures;
+    futures.reserve(filenames.size());
+    for (auto& filename : filenames) {
+        auto record = _fileSystem.find(filename);
+
+        // Missing files, already loaded and preloading items are not read
+        if (record == nullptr || _datItems.contains(record) || _preloadedItems.count(record) != 0) {
+            std::promise<void> promise;
+            promise.set_value();
+            futures.push_back(promise.get_future().share());
+            continue;
+        }
+
+        auto prefetchedIt = _prefetchedStreams.find(record);
+        if (prefetchedIt != _prefetchedStreams.end()) {
+            futures.push_back(prefetchedIt->second.ready);
+            continue;
+        }
+
+        // the stream stays with the resource manager, callers only learn when it is ready
+        auto stream = std::make_shared<std::unique_ptr<Dat::Stream>>();
+        auto future = _threadPool->enqueue([this, record, stream]() {
+            *stream = _createStream(*record);
+        }).share();
+        _prefetchedStreams.emplace(record, PrefetchedStream{future, stream});
+        futures.push_back(future);
+    }
+    return futures;
+}
+
+vector<string> ResourceManager::listFiles(const string& prefix) const
+{
+    vector<string> files;
+    auto range = _fileSystem.list(prefix);
+    files.reserve(range.second - range.first);
+    for (auto record = range.first; record != range.second; ++record) {
+        files.push_back(_fileSystem.path(*record));
+    }
+    return files;
+}
+
+void ResourceManager::preload(const vector<string>& filenames)
+{
+    _startThreadPool();
+
+    std::shared_ptr<vector<vector<string>>> protoNames;
+    for (auto& filename : filenames) {
+        auto record = _fileSystem.find(filename);
+        if (record == nullptr || _datItems.contains(record) || _preloadedItems.count(record) != 0) {
+            continue;
+        }
+
+        auto path = _fileSystem.path(*record);
+        std::future<vector<PreloadedItem>> future;
+        if (hasExtension(path, ".map")) {
+            // workers can't use the cache, so they get their own copy of prototype lists
+            if (!protoNames) {
+                protoNames = std::make_shared<vector<vector<string>>>();
+                for (unsigned int typeId = 0; typeId != sizeof(PROTO_TYPES) / sizeof(PROTO_TYPES[0]); ++typeId) {
+                    auto names = _protoNames(typeId);
+                    protoNames->push_back(names ? *names : vector<string>());
+                }
+            }
+            future = _threadPool->enqueue([this, record, protoNames]() { return _parseMap(*record, protoNames); });
+        } else if (hasExtension(path, ".frm") || (path.size() > 4 && path.compare(path.size() - 4, 3, ".fr") == 0)) {
+            future = _threadPool->enqueue([this, record]() { return _parseItem<Frm::File>(*record); });
+        } else if (hasExtension(path, ".pro")) {
+            future = _threadPool->enqueue([this, record]() { return _parseItem<Pro::File>(*record); });
+        } else if (hasExtension(path, ".int")) {
+            future = _threadPool->enqueue([this, record]() { return _parseItem<Int::File>(*record); });
+        } else if (hasExtension(path, ".lst")) {
+            future = _threadPool->enqueue([this, record]() { return _parseItem<Lst::File>(*record); });
+        } else if (hasExtension(path, ".msg")) {
+            future = _threadPool->enqueue([this, record]() { return _parseItem<Msg::File>(*record); });
+        } else {
+            Logger::warning("RESOURCE MANAGER") << "Can't preload file of unknown type: " << path << endl;
+            continue;
+        }
+        _preloadedItems.emplace(record, std::move(future));
+    }
+}
+
+size_t ResourceManager::adoptPreloadedItems()
+{
+    for (auto it = _preloadedItems.begin(); it != _preloadedItems.end();) {
+        if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        auto future = std::move(it->second);
+        it = _preloadedItems.erase(it);
+        try {
+            _adoptPreloadedItems(future.get());
+        } catch (const std::exception& e) {
+            // the file will be loaded again on request, which reports the problem in the usual way
+            Logger::warning("RESOURCE MANAGER") << "Preloading failed: " << e.what() << endl;
+        }
+    }
+    _enforceMemoryBudget();
+    return _preloadedItems.size();
+}
+
+bool ResourceManager::isPreloading(const string& filename) const
+{
+    auto record = _fileSystem.find(filename);
+    return record != nullptr && _preloadedItems.count(record) != 0;
+}
+
+bool ResourceManager::isLoaded(const string& filename) const
+{
+    auto record = _fileSystem.find(filename);
+    return record != nullptr && _datItems.contains(record);
+}
+
+size_t ResourceManager::memoryUsage() const
+{
+    return _datItems.bytes() + _textures.bytes() + _fonts.bytes() + _shaders.bytes();
+}
+
+template <class T>
+vector<ResourceManager::PreloadedItem> ResourceManager::_parseItem(const VirtualFileSystem::Record& record)
+{
+    vector<PreloadedItem> items;
+    auto stream = _createStream(record);
+    if (!stream) {
+        return items;
+    }
+    auto sourceSize = stream->size();
+    auto item = std::make_unique<T>(std::move(*stream));
+    item->setFilename(_fileSystem.path(record));
+    item->setSourceSize(sourceSize);
+    items.push_back({&record, std::move(item), IsLongLivedItem<T>::value});
+    return items;
+}
+
+vector<ResourceManager::PreloadedItem> ResourceManager::_parseMap(const VirtualFileSystem::Record& record, std::shared_ptr<vector<vector<string>>> protoNames)
+{
+    auto items = _parseItem<Map::File>(record);
+    if (items.empty()) {
+        return items;
+    }
+
+    std::unordered_map<uint32_t, Pro::File*> protos;
+    auto map = static_cast<Map::File*>(items.front().item.get());
+    map->init([this, &items, &protos, &protoNames](uint32_t PID) -> Pro::File* {
+        auto it = protos.find(PID);
+        if (it != protos.end()) {
+            return it->second;
+        }
+
+        unsigned int typeId = PID >> 24;
+        auto protoRecord = typeId < protoNames->size() ? _fileSystem.find(protoFilename(PID, protoNames->at(typeId))) : nullptr;
+        if (protoRecord == nullptr) {
+            throw Exception("ResourceManager::_parseMap() - can't find prototype for PID: " + std::to_string(PID));
+        }
+        auto protoItems = _parseItem<Pro::File>(*protoRecord);
+        if (protoItems.empty()) {
+            throw Exception("ResourceManager::_parseMap() - can't read prototype for PID: " + std::to_string(PID));
         }
+        auto proto = static_cast<Pro::File*>(protoItems.front().item.get());
+        items.push_back(std::move(protoItems.front()));
+        protos.emplace(PID, proto);
+        return proto;
+    });
+    return items;
+}
+
+void ResourceManager::_adoptPreloadedItems(vector<PreloadedItem>&& items)
+{
+    for (auto& preloaded : items) {
+        // the same prototype may come with several maps
+        if (_datItems.contains(preloaded.record)) {
+            continue;
+        }
+        _datItems.insert(preloaded.record, std::move(preloaded.item), ++_tick);
+        if (preloaded.pinned) {
+            _datItems.pin(preloaded.record);
+        }
+    }
+}
+
+void ResourceManager::_startThreadPool()
+{
+    if (!_threadPool) {
+        _threadPool = std::make_unique<Base::ThreadPool>();
     }
-    Logger::error("RESOURCE MANAGER") << "Loading file: " << filename << " [ NOT FOUND]" << endl;
 }
 
 template <class T>
-T* ResourceManager::_datFileItem(string filename)
+T* ResourceManager::_datFileItem(const string& filename)
 {
-    std::transform(filename.begin(), filename.end(), filename.begin(), ::tolower);
+    auto record = _fileSystem.find(filename);
+    if (record == nullptr)
+    {
+        Logger::error("RESOURCE MANAGER") << "Loading file: " << filename << " [ NOT FOUND]" << endl;
+        return nullptr;
+    }
+
+    // Wait for the item if it is being parsed on a worker thread
+    auto preloadedIt = _preloadedItems.find(record);
+    if (preloadedIt != _preloadedItems.end())
+    {
+        auto future = std::move(preloadedIt->second);
+        _preloadedItems.erase(preloadedIt);
+        try
+        {
+            _adoptPreloadedItems(future.get());
+        }
+        catch (const std::exception& e)
+        {
+            Logger::warning("RESOURCE MANAGER") << "Preloading failed: " << e.what() << endl;
+        }
+    }
 
     // Return item from cache
-    auto itemIt = _datItems.find(filename);
-    if (itemIt != _datItems.end())
+    auto cachedItem = _datItems.get(record, ++_tick);
+    if (cachedItem != nullptr)
     {
-        auto itemPtr = dynamic_cast<T*>(itemIt->second.get());
+        auto itemPtr = dynamic_cast<T*>(cachedItem);
         if (itemPtr == nullptr)
         {
             Logger::error("RESOURCE MANAGER") << "Requested file type does not match type in the cache: " << filename << endl;
@@ -123,14 +422,22 @@ T* ResourceManager::_datFileItem(string filename)
     }
 
     T* itemPtr = nullptr;
-    _loadStreamForFile(filename, [this, &filename, &itemPtr](Dat::Stream&& stream)
+    _loadStreamForFile(*record, [this, record, &itemPtr](Dat::Stream&& stream)
     {
+        auto sourceSize = stream.size();
         auto item = std::make_unique<T>(std::move(stream));
         itemPtr = item.get();
-        item->setFilename(filename);
-        _datItems.emplace(filename, std::move(item));
+        item->setFilename(_fileSystem.path(*record));
+        item->setSourceSize(sourceSize);
+        _datItems.insert(record, std::move(item), ++_tick);
+        if (IsLongLivedItem<T>::value) {
+            _datItems.pin(record);
+        }
     });
 
+    if (itemPtr) {
+        _enforceMemoryBudget();
+    }
     return itemPtr;
 }
 
@@ -276,9 +583,9 @@ Txt::QuestsFile* ResourceManager::questsTxt()
 
 Graphics::Texture* ResourceManager::texture(const string& filename)
 {
-    if (_textures.count(filename))
+    if (auto cachedTexture = _textures.get(filename, ++_tick))
     {
-        return _textures.at(filename).get();
+        return cachedTexture;
     }
 
     string ext = filename.substr(filename.length() - 4);
@@ -314,25 +621,65 @@ Graphics::Texture* ResourceManager::texture(const string& filename)
     {
         auto frm = frmFileType(filename);
         if (!frm) return nullptr;
-        texture = new Graphics::Texture(frm->width(), frm->height());
-        texture->loadFromRGBA(frm->rgba(palFileType("color.pal")));
-        texture->setMask(frm->mask(palFileType("color.pal")));
+        texture = _indexedTexture(frm->width(), frm->height(), frm->indexes());
+        texture->setMask(frm->mask());
     }
     else
     {
         throw Exception("ResourceManager::surface() - unknown image type:" + filename);
     }
 
-    _textures.insert(make_pair(filename, unique_ptr<Graphics::Texture>(texture)));
+    _textures.insert(filename, unique_ptr<Graphics::Texture>(texture), ++_tick);
+    _enforceMemoryBudget();
+    return texture;
+}
+
+Graphics::Texture* ResourceManager::texture(const string& filename, unsigned int direction)
+{
+    auto name = textureName(filename, direction);
+    if (auto cachedTexture = _textures.get(name, ++_tick))
+    {
+        return cachedTexture;
+    }
+
+    auto frm = frmFileType(filename);
+    if (!frm) return nullptr;
+    auto texture = _indexedTexture(frm->width(direction), frm->height(direction), frm->indexes(direction));
+    texture->setMask(frm->mask(direction));
+
+    _textures.insert(name, unique_ptr<Graphics::Texture>(texture), ++_tick);
+    _enforceMemoryBudget();
+    return texture;
+}
+
+// static
+string ResourceManager::textureName(const string& filename, unsigned int direction)
+{
+    return filename + "#" + std::to_string(direction);
+}
+
+Graphics::Texture* ResourceManager::_indexedTexture(unsigned int width, unsigned int height, const vector<uint8_t>& indexes)
+{
+    if (!_textureAtlas)
+    {
+        _textureAtlas = std::make_unique<Graphics::TextureAtlas>(Game::Game::getInstance()->renderer()->maxTextureSize());
+    }
+    // sheets too large for atlas page get their own texture
+    auto texture = _textureAtlas->add(width, height, indexes.data()).release();
+    if (!texture)
+    {
+        texture = new Graphics::Texture(width, height);
+        texture->loadFromIndexes(indexes.data());
+    }
     return texture;
 }
 
 Graphics::Font* ResourceManager::font(const string& filename)
 {
 
-    if (_fonts.count(filename))
+    if (auto cachedFont = _fonts.get(filename, ++_tick))
     {
-        return _fonts.at(filename).get();
+        return cachedFont;
     }
 
     std::string ext = filename.substr(filename.length() - 4);
@@ -346,86 +693,108 @@ Graphics::Font* ResourceManager::font(const string& filename)
     {
         fontPtr = new Graphics::FON(filename);
     }
-    _fonts.emplace(filename, std::unique_ptr<Graphics::Font>(fontPtr));
+    if (fontPtr == nullptr)
+    {
+        return nullptr;
+    }
+    // fonts are used by every text area for the whole session
+    _fonts.insert(filename, std::unique_ptr<Graphics::Font>(fontPtr), ++_tick);
+    _fonts.pin(filename);
     return fontPtr;
 }
 
 
 Graphics::Shader* ResourceManager::shader(const string& filename)
 {
-    if (_shaders.count(filename))
+    if (auto cachedShader = _shaders.get(filename, ++_tick))
     {
-        return _shaders.at(filename).get();
+        return cachedShader;
     }
 
     Graphics::Shader* shader = new Graphics::Shader(filename);
 
-    _shaders.emplace(filename, unique_ptr<Graphics::Shader>(shader));
+    // shaders are shared by all sprites for the whole session
+    _shaders.insert(filename, unique_ptr<Graphics::Shader>(shader), ++_tick);
+    _shaders.pin(filename);
     return shader;
 }
 
 
 Pro::File* ResourceManager::proFileType(unsigned int PID)
 {
-    unsigned int typeId = PID >> 24;
-    string listFile;
-    switch ((OBJECT_TYPE)typeId)
+    auto names = _protoNames(PID >> 24);
+    if (names == nullptr)
     {
-        case OBJECT_TYPE::ITEM:
-            listFile += "proto/items/items.lst";
-            break;
-        case OBJECT_TYPE::CRITTER:
-            listFile += "proto/critters/critters.lst";
-            break;
-        case OBJECT_TYPE::SCENERY:
-            listFile += "proto/scenery/scenery.lst";
-            break;
-        case OBJECT_TYPE::WALL:
-            listFile += "proto/walls/walls.lst";
-            break;
-        case OBJECT_TYPE::TILE:
-            listFile += "proto/tiles/tiles.lst";
-            break;
-        case OBJECT_TYPE::MISC:
-            listFile += "proto/misc/misc.lst";
-            break;
-        default:
-            Logger::error("") << "ResourceManager::proFileType(unsigned int) - wrong PID: " << PID << endl;
-            return nullptr;
+        Logger::error("") << "ResourceManager::proFileType(unsigned int) - wrong PID: " << PID << endl;
+        return nullptr;
     }
 
-    auto lst = lstFileType(listFile);
-
-    unsigned int index = 0x00000FFF & PID;
-
-    if (index > lst->strings()->size())
+    auto filename = protoFilename(PID, *names);
+    if (filename.empty())
     {
         Logger::error("") << "ResourceManager::proFileType(unsigned int) - LST size < PID: " << PID << endl;
         return nullptr;
     }
+    return proFileType(filename);
+}
 
-    string protoName = lst->strings()->at(index-1);
+vector<string>* ResourceManager::_protoNames(unsigned int typeId)
+{
+    if (typeId >= sizeof(PROTO_TYPES) / sizeof(PROTO_TYPES[0])) {
+        return nullptr;
+    }
+    auto lst = lstFileType(string("proto/") + PROTO_TYPES[typeId] + "/" + PROTO_TYPES[typeId] + ".lst");
+    return lst ? lst->strings() : nullptr;
+}
 
-    switch ((OBJECT_TYPE)typeId)
-    {
-        case OBJECT_TYPE::ITEM:
-            return proFileType("proto/items/" + protoName);
-        case OBJECT_TYPE::CRITTER:
-            return proFileType("proto/critters/" + protoName);
-        case OBJECT_TYPE::SCENERY:
-            return proFileType("proto/scenery/" + protoName);
-        case OBJECT_TYPE::WALL:
-            return proFileType("proto/walls/" + protoName);
-        case OBJECT_TYPE::TILE:
-            return proFileType("proto/tiles/" + protoName);
-        case OBJECT_TYPE::MISC:
-            return proFileType("proto/misc/" + protoName);
-    }
-    return nullptr;
+void ResourceManager::pinTexture(const std::string& filename)
+{
+    _textures.pin(filename);
+}
+
+void ResourceManager::unpinTexture(const std::string& filename)
+{
+    _textures.unpin(filename);
+}
+
+void ResourceManager::startLocationEpoch()
+{
+    ++_epoch;
+    _datItems.setEpoch(_epoch);
+    _textures.setEpoch(_epoch);
+    _fonts.setEpoch(_epoch);
+    _shaders.setEpoch(_epoch);
+    _enforceMemoryBudget();
+}
+
+void ResourceManager::_enforceMemoryBudget()
+{
+    if (_memoryBudget == 0) {
+        return;
+    }
+
+    while (memoryUsage() > _memoryBudget) {
+        // fonts and shaders are always pinned, so only items and textures compete for eviction
+        bool evicted = _datItems.oldestTick() <= _textures.oldestTick()
+            ? _datItems.evictOldest()
+            : _textures.evictOldest();
+        if (!evicted) {
+            break;
+        }
+    }
 }
 
 void ResourceManager::unloadResources()
 {
+    // wait for pending prefetch and preload tasks since they may still read from DAT files
+    for (auto& prefetched : _prefetchedStreams) {
+        prefetched.second.ready.wait();
+    }
+    _prefetchedStreams.clear();
+    for (auto& preloaded : _preloadedItems) {
+        preloaded.second.wait();
+    }
+    _preloadedItems.clear();
     _datItems.clear();
 }
 
@@ -499,6 +868,7 @@ string ResourceManager::FIDtoFrmName(unsigned int FID)
 void ResourceManager::shutdown()
 {
     unloadResources();
+    _threadPool.reset();
 }
 
 }
@@ -2,15 +2,22 @@
 
 #include <fstream>
 #include <functional>
+#include <future>
 #include <string>
 #include <map>
 #include <memory>
 #include <unordered_map>
 #include <vector>
+#include "Base/LruCache.h"
 #include "Base/Singleton.h"
+#include "VirtualFileSystem.h"
 
 namespace Falltergeist
 {
+    namespace Base
+    {
+        class ThreadPool;
+    }
     namespace Format
     {
         namespace Aaf { class File; }
@@ -19,6 +26,7 @@ namespace Falltergeist
         namespace Bio { class File; }
         namespace Dat
         {
+            class DiskCache;
             class File;
             class Item;
             class MiscFile;
@@ -71,6 +79,7 @@ namespace Falltergeist
     namespace Graphics
     {
         class Texture;
+        class TextureAtlas;
         class Font;
         class Shader;
     }
@@ -113,9 +122,48 @@ namespace Falltergeist
             Format::Txt::KarmaVarFile* karmaVarTxt();
             Format::Txt::QuestsFile* questsTxt();
 
+            // Reads and unpacks given files on worker threads ahead of time.
+            // Subsequent requests for these files will pick up prepared data instead of reading it on the main thread.
+            // Each future becomes ready once its file is read, or right away if file was not found or is already loaded.
+            std::vector<std::shared_future<void>> prefetch(const std::vector<std::string>& filenames);
+
+            // Reads and parses given files on worker threads. Item type is chosen by file extension,
+            // only frm, int, lst, map, msg and pro files are supported. Prototypes used by maps are parsed along with them.
+            // Parsed items get to the cache with adoptPreloadedItems() or with the first request of the file.
+            void preload(const std::vector<std::string>& filenames);
+
+            // Moves items of finished preload tasks to the cache. Returns number of files which are still being parsed.
+            size_t adoptPreloadedItems();
+
+            // Whether given file is still being parsed by preload()
+            bool isPreloading(const std::string& filename) const;
+
+            // Whether given file is parsed and cached
+            bool isLoaded(const std::string& filename) const;
+
+            // Total size of cached resources in bytes
+            size_t memoryUsage() const;
+
+            // Normalized names of all game files which names start with given prefix, e.g. "art/critters/"
+            std::vector<std::string> listFiles(const std::string& prefix) const;
+
             Graphics::Texture* texture(const std::string& filename);
+            // Image of one direction of FRM file. Animations show a single direction,
+            // so images of directions nobody looks at are never built, and unpinned ones are evicted as usual.
+            Graphics::Texture* texture(const std::string& filename, unsigned int direction);
+            // Name under which texture of the direction is cached, pinned and unpinned
+            static std::string textureName(const std::string& filename, unsigned int direction);
             Graphics::Font* font(const std::string& filename = "font1.aaf");
             Graphics::Shader* shader(const std::string& filename);
+
+            // Pinned textures are never evicted. Holders of texture pointers must pin them for their whole lifetime.
+            void pinTexture(const std::string& filename);
+            void unpinTexture(const std::string& filename);
+
+            // Marks the beginning of a new location. Resources which were not requested since then
+            // become subject to eviction once the memory budget is exceeded.
+            void startLocationEpoch();
+
             void unloadResources();
             std::string FIDtoFrmName(unsigned int FID);
             Game::Location* gameLocation(unsigned int number);
@@ -124,22 +172,75 @@ namespace Falltergeist
         private:
             friend class Base::Singleton<ResourceManager>;
 
+            struct PreloadedItem
+            {
+                const VirtualFileSystem::Record* record;
+                std::unique_ptr<Format::Dat::Item> item;
+                bool pinned;
+            };
+
+            // Data read by a prefetch task, only the first request of the file takes it
+            struct PrefetchedStream
+            {
+                std::shared_future<void> ready;
+                std::shared_ptr<std::unique_ptr<Format::Dat::Stream>> stream;
+            };
+
             std::vector<std::unique_ptr<Format::Dat::File>> _datFiles;
-            std::unordered_map<std::string, std::unique_ptr<Format::Dat::Item>> _datItems;
-            std::unordered_map<std::string, std::unique_ptr<Graphics::Texture>> _textures;
-            std::unordered_map<std::string, std::unique_ptr<Graphics::Font>> _fonts;
-            std::unordered_map<std::string, std::unique_ptr<Graphics::Shader>> _shaders;
+            VirtualFileSystem _fileSystem;
+            Base::LruCache<const VirtualFileSystem::Record*, Format::Dat::Item> _datItems;
+            // images of FRM files share its pages, so it has to outlive the textures
+            std::unique_ptr<Graphics::TextureAtlas> _textureAtlas;
+            Base::LruCache<std::string, Graphics::Texture> _textures;
+            Base::LruCache<std::string, Graphics::Font> _fonts;
+            Base::LruCache<std::string, Graphics::Shader> _shaders;
+            std::unordered_map<const VirtualFileSystem::Record*, PrefetchedStream> _prefetchedStreams;
+            std::unordered_map<const VirtualFileSystem::Record*, std::future<std::vector<PreloadedItem>>> _preloadedItems;
+            std::unique_ptr<Base::ThreadPool> _threadPool;
+            std::unique_ptr<Format::Dat::DiskCache> _diskCache;
+            // total size of cached resources in bytes after which least recently used ones are evicted, zero means no limit
+            size_t _memoryBudget = 0;
+            uint64_t _tick = 0;
+            uint64_t _epoch = 0;
 
             ResourceManager();
+            ~ResourceManager();
             ResourceManager(const ResourceManager&) = delete;
             ResourceManager& operator=(const ResourceManager&) = delete;
 
             // Retrieves given file item from "virtual file system".
             // All items are cached after being requested for the first time.
             template <class T>
-            T* _datFileItem(std::string filename);
+            T* _datFileItem(const std::string& filename);
+
+            // Calls the given callback with Dat::Stream created from given file of virtual "file system".
+            void _loadStreamForFile(const VirtualFileSystem::Record& record, std::function<void(Format::Dat::Stream&&)> callback);
+
+            // Creates Dat::Stream from given file of virtual "file system", or returns nullptr if file can't be read.
+            // Does not log and does not touch caches, so it is safe to be called from worker threads.
+            std::unique_ptr<Format::Dat::Stream> _createStream(const VirtualFileSystem::Record& record);
+
+            // Parses given file on a worker thread
+            template <class T>
+            std::vector<PreloadedItem> _parseItem(const VirtualFileSystem::Record& record);
+
+            // Parses given map on a worker thread along with all prototypes it refers to.
+            // Prototype names are taken from given LST contents, indexed by object type.
+            std::vector<PreloadedItem> _parseMap(const VirtualFileSystem::Record& record, std::shared_ptr<std::vector<std::vector<std::string>>> protoNames);
+
+            // Puts items parsed on worker threads to the cache
+            void _adoptPreloadedItems(std::vector<PreloadedItem>&& items);
+
+            // Starts worker threads if they are not running yet
+            void _startThreadPool();
+
+            // Contents of LST file with prototype names for given object type, or nullptr
+            std::vector<std::string>* _protoNames(unsigned int typeId);
+
+            // Evicts least recently used resources until their total size fits the memory budget
+            void _enforceMemoryBudget();
 
-            // Searches for a given file within virtual "file system" and calls the given callback with Dat::Stream created from that file.
-            void _loadStreamForFile(std::string filename, std::function<void(Format::Dat::Stream&&)> callback);
+            // Texture of palette indexes, placed into the atlas if it fits there
+            Graphics::Texture* _indexedTexture(unsigned int width, unsigned int height, const std::vector<uint8_t>& indexes);
     };
 }
@@ -51,6 +51,13 @@ namespace Falltergeist
         audio->setPropertyDouble("sfx_volume", _sfxVolume);
         audio->setPropertyString("music_path", _musicPath);
         audio->setPropertyInt("buffer_size", _audioBufferSize);
+        audio->setPropertyInt("ring_buffers", _audioRingBuffers);
+
+        auto resources = file.section("resources");
+        resources->setPropertyBool("mmap_dat_files", _memoryMappedDatFiles);
+        resources->setPropertyString("cache_path", _cachePath);
+        resources->setPropertyInt("memory_budget", _memoryBudget);
+        resources->setPropertyInt("prefetch_memory", _prefetchMemory);
 
         auto logger = file.section("logger");
         logger->setPropertyString("level", _loggerLevel);
@@ -160,6 +167,16 @@ namespace Falltergeist
             _sfxVolume = audio->propertyDouble("sfx_volume", _sfxVolume);
             _musicPath = audio->propertyString("music_path", _musicPath);
             _audioBufferSize = audio->propertyInt("buffer_size", _audioBufferSize);
+            _audioRingBuffers = audio->propertyInt("ring_buffers", _audioRingBuffers);
+        }
+
+        auto resources = file->section("resources");
+        if (resources)
+        {
+            _memoryMappedDatFiles = resources->propertyBool("mmap_dat_files", _memoryMappedDatFiles);
+            _cachePath = resources->propertyString("cache_path", _cachePath);
+            _memoryBudget = resources->propertyInt("memory_budget", _memoryBudget);
+            _prefetchMemory = resources->propertyInt("prefetch_memory", _prefetchMemory);
         }
 
         auto logger = file->section("logger");
@@ -458,4 +475,29 @@ namespace Falltergeist
     {
         return _audioBufferSize;
     }
+
+    unsigned int Settings::audioRingBuffers() const
+    {
+        return _audioRingBuffers;
+    }
+
+    bool Settings::memoryMappedDatFiles() const
+    {
+        return _memoryMappedDatFiles;
+    }
+
+    const std::string& Settings::cachePath() const
+    {
+        return _cachePath;
+    }
+
+    unsigned int Settings::memoryBudget() const
+    {
+        return _memoryBudget;
+    }
+
+    unsigned int Settings::prefetchMemory() const
+    {
+        return _prefetchMemory;
+    }
 }
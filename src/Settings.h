@@ -90,6 +90,15 @@ namespace Falltergeist
             bool alwaysOnTop() const;
             void setAudioBufferSize(int _audioBufferSize);
             int audioBufferSize() const;
+            // number of audio buffers decoded ahead of playback
+            unsigned int audioRingBuffers() const;
+            bool memoryMappedDatFiles() const;
+            // directory for persistent cache of unpacked resources; empty string disables the cache
+            const std::string& cachePath() const;
+            // memory budget for cached resources in megabytes; zero means no limit
+            unsigned int memoryBudget() const;
+            // memory in megabytes which may be spent on resources of maps reachable from the current one; zero disables prefetching
+            unsigned int prefetchMemory() const;
 
         private:
             unsigned int _screenWidth = 640;
@@ -131,5 +140,11 @@ namespace Falltergeist
             double _sfxVolume = 1.0;
             double _voiceVolume = 1.0;
             int _audioBufferSize = 512;
+            unsigned int _audioRingBuffers = 8;
+            // [resources]
+            bool _memoryMappedDatFiles = true;
+            std::string _cachePath = "";
+            unsigned int _memoryBudget = 512;
+            unsigned int _prefetchMemory = 64;
     };
 }
@@ -142,7 +142,7 @@ namespace Falltergeist
                 if (Game::Game::getInstance()->locationState()->currentMapIndex() == destination->mapId) {
                     logger->info() << "[ELEVATOR] same location";
                     Game::Game::getInstance()->locationState()->setElevation(destination->elevation);
-                    Game::Game::getInstance()->locationState()->setPosition(Hexagon(destination->position).position());
+                    Game::Game::getInstance()->locationState()->setPosition(Point(0, 0));
                 } else {
                     logger->info() << "[ELEVATOR] loading map...";
                     Helpers::GameLocationHelper gameLocationHelper(logger);
@@ -15,18 +15,24 @@
 #include "../Game/ExitMiscObject.h"
 #include "../Game/Game.h"
 #include "../Game/LadderSceneryObject.h"
+#include "../Game/LightField.h"
 #include "../Game/StairsSceneryObject.h"
 #include "../Game/Location.h"
 #include "../Game/LocationElevation.h"
+#include "../Game/LocationLoader.h"
+#include "../Game/LocationPrefetcher.h"
 #include "../Game/ObjectFactory.h"
 #include "../Game/SpatialObject.h"
 #include "../Game/WeaponItemObject.h"
+#include "../Graphics/SpriteBatch.h"
 #include "../Helpers/GameLocationHelper.h"
 #include "../Helpers/GameObjectHelper.h"
 #include "../LocationCamera.h"
 #include "../Logger.h"
 #include "../PathFinding/Hexagon.h"
 #include "../PathFinding/HexagonGrid.h"
+#include "../PathFinding/PathPlanner.h"
+#include "../PathFinding/PathQueue.h"
 #include "../ResourceManager.h"
 #include "../Settings.h"
 #include "../State/CursorDropdown.h"
@@ -73,6 +79,9 @@ namespace Falltergeist
             this->logger = std::move(logger);
         }
 
+        // Destructor is defined here since Game::LocationLoader is incomplete in the header
+        Location::~Location() = default;
+
         void Location::init()
         {
             if (initialized()) {
@@ -80,6 +89,9 @@ namespace Falltergeist
             }
             State::init();
 
+            // resources of previous locations may now be evicted
+            ResourceManager::getInstance()->startLocationEpoch();
+
             mouse->setState(Input::Mouse::Cursor::ACTION);
 
             _camera = std::make_unique<LocationCamera>(renderer->size(), Point(0, 0));
@@ -88,14 +100,23 @@ namespace Falltergeist
             _hexagonInfo->setWidth(135);
             _hexagonInfo->setHorizontalAlign(UI::TextArea::HorizontalAlign::RIGHT);
 
+            _loadingInfo = std::make_unique<UI::TextArea>("", 0, renderer->height() / 2);
+            _loadingInfo->setWidth(renderer->width());
+            _loadingInfo->setHorizontalAlign(UI::TextArea::HorizontalAlign::CENTER);
+
             setFullscreen(true);
             setModal(true);
 
+            // queries refer to objects and the grid
+            _pathQueue.reset();
             _objects.clear();
             _flatObjects.clear();
             _spatials.clear();
 
             _hexagonGrid = std::make_unique<HexagonGrid>();
+            _pathPlanner = std::make_unique<PathPlanner>(_hexagonGrid.get());
+            _pathQueue = std::make_unique<PathQueue>(_hexagonGrid.get(), _pathPlanner.get());
+            _lightField = std::make_unique<Game::LightField>(_hexagonGrid.get());
 
             initializeLightmap();
 
@@ -219,13 +240,15 @@ namespace Falltergeist
             _locationScriptTimer.start(10000.0f, true);
             _locationScriptTimer.tickHandler().add([this](Event::Event*) {
                 if (_location->script()) {
-                    _location->script()->call("map_update_p_proc");
+                    _location->script()->call(PROCEDURE::MAP_UPDATE);
                 }
                 for (auto &object : _objects) {
                     object->map_update_p_proc();
                 }
                 player->map_update_p_proc();
             });
+
+            startPrefetching();
         }
 
         void Location::onStateActivate(Event::State *event)
@@ -370,7 +393,7 @@ namespace Falltergeist
         std::vector<Input::Mouse::Icon> Location::getCursorIconsForObject(Game::Object *object)
         {
             std::vector<Input::Mouse::Icon> icons;
-            if (object->script() && object->script()->hasFunction("use_p_proc")) {
+            if (object->script() && object->script()->hasFunction(PROCEDURE::USE)) {
                 icons.push_back(Input::Mouse::Icon::USE);
             } else if (dynamic_cast<Game::DoorSceneryObject *>(object)) {
                 icons.push_back(Input::Mouse::Icon::USE);
@@ -447,14 +470,21 @@ namespace Falltergeist
             _lightmap->render(_camera->topLeft());
             renderCursor();
             renderObjects();
+            // objects are drawn in few batches, before the roof covers them
+            renderer->spriteBatch()->flush();
             elevation->roof()->render();
             renderObjectsText();
             renderCursorOutline();
             renderTestingOutline();
+            renderer->spriteBatch()->flush();
             if (active()) {
                 _hexagonInfo->render();
             }
+            if (_exitLoader) {
+                _loadingInfo->render();
+            }
             State::render();
+            renderer->spriteBatch()->flush();
         }
 
         void Location::renderTestingOutline() const
@@ -508,6 +538,17 @@ namespace Falltergeist
 
         void Location::think(const float &deltaTime)
         {
+            if (_exitLoader) {
+                // the world stands still until the next map is loaded
+                if (!thinkExitLoading()) {
+                    State::think(deltaTime);
+                }
+                return;
+            }
+            if (_prefetcher) {
+                _prefetcher->think();
+            }
+            _pathQueue->deliver();
             gameTime->think(deltaTime);
             thinkObjects(deltaTime);
             player->think(deltaTime);
@@ -518,6 +559,81 @@ namespace Falltergeist
             }
             processTimers(deltaTime);
             State::think(deltaTime);
+            _pathQueue->dispatch();
+        }
+
+        void Location::startExitLoading(Game::ExitMiscObject* exitGrid)
+        {
+            if (_exitLoader) {
+                return;
+            }
+
+            auto mapsFile = ResourceManager::getInstance()->mapsTxt();
+            std::string mapName = mapsFile->maps().at(exitGrid->exitMapNumber()).name;
+
+            _exitPosition = exitGrid->exitHexagonNumber();
+            _exitOrientation = exitGrid->exitDirection();
+            _exitElevation = exitGrid->exitElevationNumber();
+            _exitLoader = std::make_unique<Game::LocationLoader>(mapName, _exitElevation, logger);
+            _exitLoader->setProgressCallback([this](float progress) {
+                Logger::debug("LOCATION") << "Loading " << _exitLoader->name() << ": " << static_cast<int>(progress * 100) << "%" << std::endl;
+                _loadingInfo->setText("Loading... " + std::to_string(static_cast<int>(progress * 100)) + "%");
+            });
+            _loadingInfo->setText("Loading...");
+            player->stopMovement();
+            _path.clear();
+            mouse->pushState(Input::Mouse::Cursor::WAIT);
+        }
+
+        bool Location::thinkExitLoading()
+        {
+            if (!_exitLoader->think()) {
+                return false;
+            }
+
+            auto location = _exitLoader->location();
+            _exitLoader.reset();
+            mouse->popState();
+            if (!location) {
+                Logger::error("LOCATION") << "Can't load location" << std::endl;
+                return false;
+            }
+
+            location->setDefaultPosition(_exitPosition);
+            location->setDefaultOrientation(_exitOrientation);
+            location->setDefaultElevationIndex(_exitElevation);
+
+            // TODO move this instantiation to StateLocationHelper or some kind of state manager
+            auto state = new Location(player, mouse, settings, renderer, audioMixer, gameTime, resourceManager, logger);
+            state->setLocation(location);
+            // TODO delegate state manipulation to some kind of state manager
+            Game::Game::getInstance()->setState(state);
+            return true;
+        }
+
+        void Location::startPrefetching()
+        {
+            if (settings->prefetchMemory() == 0) {
+                return;
+            }
+
+            const auto& maps = ResourceManager::getInstance()->mapsTxt()->maps();
+            std::vector<std::string> names;
+            for (auto& object : *_location->elevations()->at(_elevation)->objects()) {
+                auto exitGrid = dynamic_cast<Game::ExitMiscObject*>(object);
+                // negative numbers lead to the world map
+                if (!exitGrid || exitGrid->exitMapNumber() < 0 || static_cast<size_t>(exitGrid->exitMapNumber()) >= maps.size()) {
+                    continue;
+                }
+                auto& name = maps.at(exitGrid->exitMapNumber()).name;
+                if (name != _location->name() && std::find(names.begin(), names.end(), name) == names.end()) {
+                    names.push_back(name);
+                }
+            }
+
+            if (!names.empty()) {
+                _prefetcher = std::make_unique<Game::LocationPrefetcher>(names, static_cast<size_t>(settings->prefetchMemory()) * 1024 * 1024);
+            }
         }
 
         // timers processing
@@ -556,7 +672,7 @@ namespace Falltergeist
             }
 
             if (_location->script()) {
-                _location->script()->call("map_enter_p_proc");
+                _location->script()->call(PROCEDURE::MAP_ENTER);
             }
 
             // By some reason we need to use reverse iterator to prevent scripts problems
@@ -658,6 +774,11 @@ namespace Falltergeist
 
         void Location::handle(Event::Event *event)
         {
+            // player can't act while the next map is loading
+            if (_exitLoader) {
+                return;
+            }
+
             State::handle(event);
             if (event->handled()) {
                 return;
@@ -747,14 +868,11 @@ namespace Falltergeist
                     // Here goes the movement
                     auto hexagon = hexagonGrid()->hexagonAt(mouse->position() + _camera->topLeft());
                     if (hexagon) {
-                        auto path = hexagonGrid()->findPath(player->hexagon(), hexagon);
-                        if (path.size()) {
+                        if (_pathPlanner->findPath(player->hexagon(), hexagon, _path) == PathResult::FOUND) {
                             player->stopMovement();
                             player->setRunning((_lastClickedTile != 0 && hexagon->number() == _lastClickedTile) ||
                                                (event->shiftPressed() != settings->running()));
-                            for (auto pathHexagon : path) {
-                                player->movementQueue()->push_back(pathHexagon);
-                            }
+                            player->movementQueue()->assign(_path.begin(), _path.end());
                         }
                         event->setHandled(true);
                         _lastClickedTile = hexagon->number();
@@ -867,24 +985,20 @@ namespace Falltergeist
             auto hexagon = object->hexagon();
 
             for (auto adjacentHex : hexagon->neighbors()) {
-                if (!adjacentHex->canWalkThru()) {
+                if (!adjacentHex || !adjacentHex->canWalkThru()) {
                     continue;
                 }
 
-                auto path = hexagonGrid()->findPath(player->hexagon(), adjacentHex);
-
-                if (path.size()) {
+                if (hexagonGrid()->findPath(player->hexagon(), adjacentHex, _path) == PathResult::FOUND) {
                     /* Remove the last hexagon from the path so the player stops on
                     an adjacent tile (rather than on the tile the object occupies) */
-                    path.pop_back();
+                    _path.pop_back();
 
                     player->stopMovement();
                     player->setRunning(true);
 
                     // Move!
-                    for (auto pathHexagon : path) {
-                        player->movementQueue()->push_back(pathHexagon);
-                    }
+                    player->movementQueue()->assign(_path.begin(), _path.end());
                     // The player was able to move to an adjacent tile
                     return true;
                 }
@@ -924,53 +1038,14 @@ namespace Falltergeist
             auto elevation = _location->elevations()->at(_elevation);
 
             auto oldHexagon = object->hexagon();
+            Game::ExitMiscObject* exitGrid = nullptr;
             if (oldHexagon) {
-                if (update) {
-                    //_hexagonGrid->initLight(oldHexagon, false);
-                }
+                oldHexagon->removeObject(object);
 
-                for (auto it = oldHexagon->objects()->begin(); it != oldHexagon->objects()->end(); ++it) {
-                    if (*it == object) {
-                        oldHexagon->objects()->erase(it);
-                        break;
-                    }
-                }
-
-                /* JUST FOR EXIT GRIDS TESTING*/
-                if (object->type() == Game::Object::Type::DUDE) {
-                    for (auto obj : *hexagon->objects()) {
-                        if (auto exitGrid = dynamic_cast<Game::ExitMiscObject *>(obj)) {
-                            auto &debug = Logger::critical("LOCATION");
-                            debug << " PID: 0x" << std::hex << exitGrid->PID() << std::dec << std::endl;
-                            debug << " name: " << exitGrid->name() << std::endl;
-                            debug << " exitMapNumber: " << exitGrid->exitMapNumber() << std::endl;
-                            debug << " exitElevationNumber: " << exitGrid->exitElevationNumber() << std::endl;
-                            debug << " exitHexagonNumber: " << exitGrid->exitHexagonNumber() << std::endl;
-                            debug << " exitDirection: " << exitGrid->exitDirection() << std::endl << std::endl;
-
-                            if (exitGrid->exitMapNumber() < 0) {
-                                auto worldMapState = new WorldMap(resourceManager);
-                                // TODO delegate state manipulation to some kind of state manager
-                                Game::Game::getInstance()->setState(worldMapState);
-                                return;
-                            }
-
-                            auto mapsFile = ResourceManager::getInstance()->mapsTxt();
-                            std::string mapName = mapsFile->maps().at(exitGrid->exitMapNumber()).name;
-
-                            GameLocationHelper gameLocationHelper(logger);
-                            auto location = gameLocationHelper.getByName(mapName);
-                            location->setDefaultPosition(exitGrid->exitHexagonNumber());
-                            location->setDefaultOrientation(exitGrid->exitDirection());
-                            location->setDefaultElevationIndex(exitGrid->exitElevationNumber());
-
-                            // TODO move this instantiation to StateLocationHelper or some kind of state manager
-                            auto state = new Location(player, mouse, settings, renderer, audioMixer, gameTime, resourceManager, logger);
-                            state->setLocation(location);
-                            // TODO delegate state manipulation to some kind of state manager
-                            Game::Game::getInstance()->setState(state);
-
-                            return;
+                if (object->type() == Game::Object::Type::DUDE && hexagon) {
+                    for (auto obj : hexagon->objects()) {
+                        if ((exitGrid = dynamic_cast<Game::ExitMiscObject *>(obj))) {
+                            break;
                         }
                     }
                 }
@@ -978,7 +1053,7 @@ namespace Falltergeist
 
             object->setHexagon(hexagon);
             if (hexagon) {
-                hexagon->objects()->push_back(object);
+                hexagon->addObject(object);
             }
 
             if (object->type() == Game::Object::Type::CRITTER || object->type() == Game::Object::Type::DUDE)
@@ -1000,22 +1075,15 @@ namespace Falltergeist
                             return obj1->hexagon()->number() < obj2->hexagon()->number();
                         }
                 );
+                _lightField->objectMoved(object, oldHexagon, hexagon);
+                uploadLight();
+            } else {
+                // light is recalculated later, but blockers must follow the object right away
+                if (oldHexagon) {
+                    _hexagonGrid->updateLightBlocker(oldHexagon);
+                }
                 if (hexagon) {
-                    initLight();
-                    /*_hexagonGrid->initLight(hexagon, true);
-                    std::vector<float> lights;
-                    for (auto hex: _hexagonGrid->hexagons())
-                    {
-                        int lightLevel = 100;
-                        unsigned int light = hex->light();
-                        if (light<=_lightLevel) light=655;
-                        lightLevel = light / ((65536-655)/100);
-
-                        float l = lightLevel/100.0;
-                        lights.push_back(l);
-                    }
-                    _lightmap->update(lights);*/
-
+                    _hexagonGrid->updateLightBlocker(hexagon);
                 }
             }
 
@@ -1036,18 +1104,35 @@ namespace Falltergeist
                     elevation->roof()->setInside(false);
                 }
             }
+
+            // the move is finished first, so the player stays on the grid while the next map is loading
+            if (exitGrid) {
+                /* JUST FOR EXIT GRIDS TESTING*/
+                auto &debug = Logger::critical("LOCATION");
+                debug << " PID: 0x" << std::hex << exitGrid->PID() << std::dec << std::endl;
+                debug << " name: " << exitGrid->name() << std::endl;
+                debug << " exitMapNumber: " << exitGrid->exitMapNumber() << std::endl;
+                debug << " exitElevationNumber: " << exitGrid->exitElevationNumber() << std::endl;
+                debug << " exitHexagonNumber: " << exitGrid->exitHexagonNumber() << std::endl;
+                debug << " exitDirection: " << exitGrid->exitDirection() << std::endl << std::endl;
+
+                if (exitGrid->exitMapNumber() < 0) {
+                    auto worldMapState = new WorldMap(resourceManager);
+                    // TODO delegate state manipulation to some kind of state manager
+                    Game::Game::getInstance()->setState(worldMapState);
+                    return;
+                }
+
+                startExitLoading(exitGrid);
+            }
         }
 
         void Location::removeObjectFromMap(Game::Object *object)
         {
-            auto objectsAtHex = object->hexagon()->objects();
-
-            for (auto it = objectsAtHex->begin(); it != objectsAtHex->end(); ++it) {
-                if (*it == object) {
-                    objectsAtHex->erase(it);
-                    break;
-                }
-            }
+            object->hexagon()->removeObject(object);
+            _pathQueue->cancel(object);
+            _lightField->objectMoved(object, object->hexagon(), nullptr);
+            uploadLight();
             if (_objectUnderCursor == object) {
                 _objectUnderCursor = nullptr;
             }
@@ -1144,6 +1229,11 @@ namespace Falltergeist
             return _hexagonGrid.get();
         }
 
+        PathQueue *Location::pathQueue()
+        {
+            return _pathQueue.get();
+        }
+
         UI::PlayerPanel *Location::playerPanel()
         {
             return _playerPanel;
@@ -1157,7 +1247,7 @@ namespace Falltergeist
                 if (obj) {
                     if (auto vm = obj->script()) {
                         vm->setFixedParam(fixedParam);
-                        vm->call("timed_event_p_proc");
+                        vm->call(PROCEDURE::TIMED_EVENT);
                     }
                 }
             });
@@ -1193,35 +1283,43 @@ namespace Falltergeist
                 level = 0x4000;
             }
             _lightLevel = level;
-            initLight();
+            // light of hexagons doesn't change, only the way it is displayed
+            _lightField->invalidate();
+            uploadLight();
         }
 
         void Location::initLight()
         {
-            for (auto hex: _hexagonGrid->hexagons()) {
-                hex->setLight(655);
-            }
+            _lightField->rebuild();
+            uploadLight();
+        }
 
-            for (auto hex: _hexagonGrid->hexagons()) {
-                _hexagonGrid->initLight(hex);
-            }
+        void Location::updateLight(Game::Object *object)
+        {
+            _lightField->objectChanged(object);
+            uploadLight();
+        }
 
-            std::vector<float> lights;
-            for (auto hex: _hexagonGrid->hexagons()) {
-                int lightLevel;
+        void Location::uploadLight()
+        {
+            if (!_lightField->dirty()) {
+                return;
+            }
 
-                unsigned int light = hex->light();
+            _lights.resize(GRID_WIDTH * GRID_HEIGHT);
+            for (size_t i = _lightField->dirtyBegin(); i != _lightField->dirtyEnd(); ++i) {
+                unsigned int light = _hexagonGrid->at(i)->light();
 
                 if (light <= _lightLevel) {
                     light = 655;
                 }
 
-                lightLevel = light / ((65536 - 655) / 100);
+                int lightLevel = light / ((65536 - 655) / 100);
 
-                auto l = static_cast<float>(lightLevel / 100.0);
-                lights.push_back(l);
+                _lights[i] = static_cast<float>(lightLevel / 100.0);
             }
-            _lightmap->update(lights);
+            _lightmap->update(_lights, _lightField->dirtyBegin(), _lightField->dirtyEnd() - _lightField->dirtyBegin());
+            _lightField->clearDirty();
         }
 
         Game::Object *Location::addObject(unsigned int PID, unsigned int position, unsigned int elevation)
@@ -28,7 +28,11 @@ namespace Falltergeist
     namespace Game
     {
         class DudeObject;
+        class ExitMiscObject;
+        class LightField;
         class Location;
+        class LocationLoader;
+        class LocationPrefetcher;
         class Object;
         class SpatialObject;
         class Time;
@@ -49,6 +53,8 @@ namespace Falltergeist
     class Hexagon;
     class HexagonGrid;
     class LocationCamera;
+    class PathPlanner;
+    class PathQueue;
     class Settings;
 
     namespace State
@@ -73,7 +79,7 @@ namespace Falltergeist
                     std::shared_ptr<UI::IResourceManager> resourceManager,
                     std::shared_ptr<ILogger> logger
                 );
-                ~Location() override = default;
+                ~Location() override;
 
                 void init() override;
                 void think(const float &deltaTime) override;
@@ -83,6 +89,8 @@ namespace Falltergeist
                 void handleByGameObjects(Event::Mouse* event);
 
                 HexagonGrid* hexagonGrid();
+                // Path queries of critters, solved in parallel and delivered on the next tick
+                PathQueue* pathQueue();
                 LocationCamera* camera();
 
                 std::shared_ptr<Game::Location> location();
@@ -128,8 +136,12 @@ namespace Falltergeist
 
                 UI::PlayerPanel* playerPanel();
 
+                // Recalculates light of the whole map
                 void initLight();
 
+                // Updates light around object which has changed its light source or ability to let light through
+                void updateLight(Game::Object* object);
+
                 Game::Object* addObject(unsigned int PID, unsigned int position, unsigned int elevation);
 
                 SKILL skillInUse() const;
@@ -166,6 +178,10 @@ namespace Falltergeist
                 std::map<std::string, unsigned char> _ambientSfx;
 
                 std::unique_ptr<HexagonGrid> _hexagonGrid;
+                // reused by player's path searches
+                std::vector<Hexagon*> _path;
+                std::unique_ptr<PathQueue> _pathQueue;
+                std::unique_ptr<PathPlanner> _pathPlanner;
                 std::unique_ptr<LocationCamera> _camera;
                 std::map<std::string, VM::StackValue> _EVARS;
 
@@ -191,6 +207,8 @@ namespace Falltergeist
                 std::list<std::shared_ptr<Game::Object>> _flatObjects;
 
                 std::unique_ptr<UI::TextArea> _hexagonInfo;
+                // progress of loading the map behind an exit grid
+                std::unique_ptr<UI::TextArea> _loadingInfo;
 
                 Event::MouseHandler _mouseDownHandler, _mouseUpHandler, _mouseMoveHandler;
 
@@ -198,13 +216,26 @@ namespace Falltergeist
 
                 unsigned int _lightLevel = 0x10000;
                 Falltergeist::Graphics::Lightmap* _lightmap;
+                std::unique_ptr<Game::LightField> _lightField;
+                // values uploaded to the lightmap, one per hexagon
+                std::vector<float> _lights;
 
                 std::vector<Game::SpatialObject*> _spatials;
 
+                // map which player is going to through exit grid, loaded in the background
+                std::unique_ptr<Game::LocationLoader> _exitLoader;
+                unsigned int _exitPosition = 0;
+                unsigned int _exitOrientation = 0;
+                unsigned int _exitElevation = 0;
+                std::unique_ptr<Game::LocationPrefetcher> _prefetcher;
+
                 void initializePlayerTestAppareance(std::shared_ptr<Game::DudeObject> player) const;
 
                 void initializeLightmap();
 
+                // uploads light of hexagons changed since the last upload
+                void uploadLight();
+
                 void loadAmbient(const std::string &name);
 
                 void renderCursor() const;
@@ -226,6 +257,11 @@ namespace Falltergeist
 
                 bool movePlayerToObject(Game::Object *object);
 
+                void startExitLoading(Game::ExitMiscObject* exitGrid);
+                void startPrefetching();
+                // Returns true if loading is finished and this state is replaced
+                bool thinkExitLoading();
+
                 Game::Object* getGameObjectUnderCursor();
         };
     }
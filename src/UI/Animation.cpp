@@ -34,20 +34,15 @@ namespace Falltergeist
                 return;
             }
 
-            _animation = std::make_unique<Graphics::Animation>(frmName);
+            _animation = std::make_unique<Graphics::Animation>(frmName, direction);
             _actionFrame = frm->actionFrame();
             auto& dir = frm->directions().at(direction);
             _shift = Point(dir.shiftX(), dir.shiftY());
 
-            // Frame offset in texture's animation
+            // Frame offset in the image of the direction
             int x = 0;
             int y = 0;
 
-            for (unsigned int d = 0; d != direction; ++d)
-            {
-                y += frm->directions().at(d).height(); //? может i - 1
-            }
-
             int xOffset = 1;
             int yOffset = 1;
             for (unsigned int f = 0; f != frm->framesPerDirection(); ++f)
@@ -128,7 +123,7 @@ namespace Falltergeist
             auto& frame = _animationFrames.at(_currentFrame);
             Point offsetPosition = position() + shift() + frame->offset();
             _animation->trans(_trans);
-            _animation->render(offsetPosition.x(), offsetPosition.y(), _direction, _currentFrame, eggTransparency, light(),
+            _animation->render(offsetPosition.x(), offsetPosition.y(), _currentFrame, eggTransparency, light(),
                                _outline, _lightLevel);
         }
 
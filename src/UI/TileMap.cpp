@@ -105,6 +105,39 @@ namespace  Falltergeist
             _atlases = (uint32_t)std::ceil((float)numbers.size() / (float)_tilesPerAtlas);
             logger->info() << "[GAME] Tilemap atlases " << _atlases << std::endl;
 
+            // tiles are sorted by top edge in each atlas, so the ones in camera rows are a continuous range
+            std::vector<std::vector<std::pair<int, unsigned int>>> atlasTiles(_atlases);
+            _slots.clear();
+            GLuint vertex = 0;
+            for (auto& it : _tiles)
+            {
+                auto& slot = _slots[it.first];
+                slot.atlas = it.second->index() / _tilesPerAtlas;
+                slot.vertex = vertex;
+                vertex += 4;
+                atlasTiles.at(slot.atlas).emplace_back(it.second->position().y(), it.first);
+            }
+
+            _atlasIndexes.assign(_atlases, AtlasIndexes());
+            for (uint32_t i = 0; i < _atlases; i++)
+            {
+                auto& tiles = atlasTiles.at(i);
+                std::stable_sort(tiles.begin(), tiles.end(), [](const std::pair<int, unsigned int>& a, const std::pair<int, unsigned int>& b) {
+                    return a.first < b.first;
+                });
+
+                auto& atlas = _atlasIndexes.at(i);
+                atlas.indexes.resize(tiles.size() * 6);
+                for (auto& tile : tiles)
+                {
+                    auto& slot = _slots.at(tile.second);
+                    slot.offset = static_cast<uint32_t>(atlas.tops.size() * 6);
+                    atlas.tops.push_back(tile.first);
+                    _writeIndexes(slot, _tiles.at(tile.second)->enabled());
+                }
+                _tilemap->setIndexes(i, atlas.indexes);
+            }
+
             auto tilesLst = ResourceManager::getInstance()->lstFileType("art/tiles/tiles.lst");
 
             for (uint8_t i = 0; i < _atlases; i++)
@@ -134,37 +167,22 @@ namespace  Falltergeist
         void TileMap::render()
         {
             auto camera = Game::Game::getInstance()->locationState()->camera();
-            std::vector<std::vector<GLuint>> indexes;
-            for (uint8_t i = 0; i < _atlases; i++)
-            {
-                indexes.push_back(std::vector<GLuint>());
-            }
-            int cnt = 0;
-
             auto topLeft = camera->topLeft();
             auto size = camera->size();
-            for (auto& it : _tiles)
-            {
-                auto& tile = it.second;
-                const Size tileSize = Size(80, 36);
-                if (tile->enabled() && Rect::intersects(tile->position(), tileSize, topLeft, size))
-                {
-                    uint32_t aIndex = tile->index() / _tilesPerAtlas;
-                    indexes.at(aIndex).push_back(cnt * 4);
-                    indexes.at(aIndex).push_back(cnt * 4 + 1);
-                    indexes.at(aIndex).push_back(cnt * 4 + 2);
-                    indexes.at(aIndex).push_back(cnt * 4 + 3);
-                    indexes.at(aIndex).push_back(cnt * 4 + 2);
-                    indexes.at(aIndex).push_back(cnt * 4 + 1);
-                }
-                cnt++;
-            }
 
             for (uint32_t i = 0; i < _atlases; i++)
             {
-                //render atlas with indexes->at(atlasIndex)
-                _tilemap.get()->render(topLeft, indexes.at(i), i);
+                auto& atlas = _atlasIndexes.at(i);
+                if (atlas.dirtyBegin != atlas.dirtyEnd)
+                {
+                    _tilemap->updateIndexes(i, atlas.dirtyBegin, &atlas.indexes[atlas.dirtyBegin], atlas.dirtyEnd - atlas.dirtyBegin);
+                    atlas.dirtyBegin = atlas.dirtyEnd = 0;
+                }
 
+                // only rows are culled, GPU clips tiles outside of the screen horizontally
+                auto first = std::lower_bound(atlas.tops.begin(), atlas.tops.end(), topLeft.y() - 36);
+                auto last = std::upper_bound(first, atlas.tops.end(), topLeft.y() + size.height());
+                _tilemap->render(topLeft, i, (first - atlas.tops.begin()) * 6, (last - first) * 6);
             }
 
         }
@@ -183,7 +201,7 @@ namespace  Falltergeist
         {
             for (auto& tile : _tiles)
             {
-                tile.second->enable();
+                _setEnabled(tile.first, *tile.second, true);
             }
 
         }
@@ -207,7 +225,7 @@ namespace  Falltergeist
             int num = y * 100 + x;
             if (_tiles.count(num) && _tiles.at(num)->enabled())
             {
-                _tiles.at(num)->disable();
+                _setEnabled(num, *_tiles.at(num), false);
                 _floodDisable(x + 1, y);
                 _floodDisable(x - 1, y);
                 _floodDisable(x, y + 1);
@@ -215,6 +233,53 @@ namespace  Falltergeist
             }
         }
 
+        void TileMap::_setEnabled(unsigned int num, Tile& tile, bool enabled)
+        {
+            if (tile.enabled() == enabled)
+            {
+                return;
+            }
+            if (enabled)
+            {
+                tile.enable();
+            }
+            else
+            {
+                tile.disable();
+            }
+
+            auto slot = _slots.find(num);
+            if (slot == _slots.end())
+            {
+                return;
+            }
+            _writeIndexes(slot->second, enabled);
+
+            auto& atlas = _atlasIndexes.at(slot->second.atlas);
+            size_t begin = slot->second.offset;
+            size_t end = begin + 6;
+            if (atlas.dirtyBegin == atlas.dirtyEnd)
+            {
+                atlas.dirtyBegin = begin;
+                atlas.dirtyEnd = end;
+            }
+            else
+            {
+                atlas.dirtyBegin = std::min(atlas.dirtyBegin, begin);
+                atlas.dirtyEnd = std::max(atlas.dirtyEnd, end);
+            }
+        }
+
+        void TileMap::_writeIndexes(const Slot& slot, bool enabled)
+        {
+            static const GLuint quad[6] = {0, 1, 2, 3, 2, 1};
+            auto indexes = &_atlasIndexes.at(slot.atlas).indexes[slot.offset];
+            for (unsigned int i = 0; i != 6; ++i)
+            {
+                indexes[i] = slot.vertex + (enabled ? quad[i] : 0);
+            }
+        }
+
         bool TileMap::opaque(const Point &pos)
         {
             auto camera = Game::Game::getInstance()->locationState()->camera();
@@ -227,15 +292,11 @@ namespace  Falltergeist
                 if (tile->enabled() && Rect::inRect(pos + camera->topLeft(), tile->position(), tileSize))
                 {
                     auto frm = ResourceManager::getInstance()->frmFileType("art/tiles/" + tilesLst->strings()->at(tile->number()));
-                    auto& mask = frm->mask(ResourceManager::getInstance()->palFileType("color.pal"));
                     auto position = pos - tile->position() + camera->topLeft() + Point(1, 1);
 
-                    if ((position.y() * 82 + position.x()) > 0 && ((unsigned)(position.y() * 82 + position.x()) < mask.size()))
+                    if (frm->mask().get(position.x(), position.y()))
                     {
-                        if (mask.at(position.y() * 82 + position.x()))
-                        {
-                            return true;
-                        }
+                        return true;
                     }
                 }
             }
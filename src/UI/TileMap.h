@@ -2,6 +2,8 @@
 
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 #include "../Graphics/Point.h"
 #include "../Graphics/Rect.h"
 #include "../Graphics/Renderer.h"
@@ -39,13 +41,36 @@ namespace Falltergeist
                 bool opaque(const Point& pos);
 
             private:
+                // Where six indexes of a tile are in the index buffer of its atlas
+                struct Slot
+                {
+                    uint32_t atlas;
+                    uint32_t offset;
+                    GLuint vertex;
+                };
+
+                // Copy of atlas index buffer, tiles are sorted by top edge
+                struct AtlasIndexes
+                {
+                    std::vector<GLuint> indexes;
+                    std::vector<int> tops;
+                    // part of indexes changed since the last upload
+                    size_t dirtyBegin = 0;
+                    size_t dirtyEnd = 0;
+                };
+
                 std::shared_ptr<ILogger> logger;
                 std::map<unsigned int, std::unique_ptr<Tile>> _tiles;
                 uint32_t _tilesPerAtlas;
                 std::unique_ptr<Graphics::Tilemap> _tilemap;
                 uint32_t _atlases;
+                std::vector<AtlasIndexes> _atlasIndexes;
+                std::unordered_map<unsigned int, Slot> _slots;
                 bool _inside = false;
                 void _floodDisable(int x, int y);
+                void _setEnabled(unsigned int num, Tile& tile, bool enabled);
+                // disabled tiles are degenerate triangles
+                void _writeIndexes(const Slot& slot, bool enabled);
         };
     }
 }
@@ -1,11 +0,0 @@
-#include "../VM/HaltException.h"
-
-namespace Falltergeist
-{
-    namespace VM
-    {
-        HaltException::HaltException()
-        {
-        }
-    }
-}
@@ -1,13 +0,0 @@
-#pragma once
-
-namespace Falltergeist
-{
-    namespace VM
-    {
-        class HaltException
-        {
-            public:
-                HaltException();
-        };
-    }
-}
@@ -1,5 +1,4 @@
 #include "../../VM/Handler/Opcode8010Handler.h"
-#include "../../VM/HaltException.h"
 #include "../../VM/Script.h"
 
 namespace Falltergeist
@@ -17,7 +16,7 @@ namespace Falltergeist
             {
                 logger->debug() << "[8010] [*] op_exit_prog" << std::endl;
                 _script->setInitialized(true);
-                throw VM::HaltException();
+                _script->halt();
             }
         }
     }
@@ -16,7 +16,7 @@ namespace Falltergeist
             void Opcode8012::_run()
             {
                 auto number = _script->dataStack()->popInteger();
-                auto value = _script->dataStack()->values()->at(_script->SVARbase() + number);
+                auto value = _script->dataStack()->at(_script->SVARbase() + number);
                 _script->dataStack()->push(value);
 
                 logger->debug()
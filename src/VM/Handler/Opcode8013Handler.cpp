@@ -17,7 +17,7 @@ namespace Falltergeist
             {
                 auto number = _script->dataStack()->popInteger();
                 auto value = _script->dataStack()->pop();
-                _script->dataStack()->values()->at(_script->SVARbase() + number) = value;
+                _script->dataStack()->at(_script->SVARbase() + number) = value;
 
                 auto &debug = logger->debug();
 
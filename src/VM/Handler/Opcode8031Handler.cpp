@@ -20,7 +20,7 @@ namespace Falltergeist
                     << "[8031] [*] op_store " << "var" << std::hex << num << " type = "
                     << value.typeName() << std::endl
                 ;
-                _script->dataStack()->values()->at(_script->DVARbase() + num) = value;
+                _script->dataStack()->at(_script->DVARbase() + num) = value;
             }
         }
     }
@@ -15,7 +15,7 @@ namespace Falltergeist
             void Opcode8032::_run()
             {
                 auto num = _script->dataStack()->popInteger();
-                auto value = _script->dataStack()->values()->at(_script->DVARbase() + num);
+                auto value = _script->dataStack()->at(_script->DVARbase() + num);
                 _script->dataStack()->push(value);
                 logger->debug()
                     << "[8032] [*] op_fetch " << "var" << std::hex << num << " type = "
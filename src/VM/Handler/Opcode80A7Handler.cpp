@@ -27,7 +27,7 @@ namespace Falltergeist
                 auto position = _script->dataStack()->popInteger();
                 auto game = Game::Game::getInstance();
                 Game::Object *found = nullptr;
-                for (auto object : *game->locationState()->hexagonGrid()->at(position)->objects()) {
+                for (auto object : game->locationState()->hexagonGrid()->at(position)->objects()) {
                     if (object->PID() == PID && object->elevation() == elevation) {
                         found = object;
                         break;
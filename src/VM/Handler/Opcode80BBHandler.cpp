@@ -30,7 +30,7 @@ namespace Falltergeist
                 auto position = _script->dataStack()->popInteger();
                 auto game = Game::Game::getInstance();
                 int found = 0;
-                for (auto object : *game->locationState()->hexagonGrid()->at(position)->objects()) {
+                for (auto object : game->locationState()->hexagonGrid()->at(position)->objects()) {
                     if (object->PID() == PID && object->elevation() == elevation) {
                         found = 1;
                     }
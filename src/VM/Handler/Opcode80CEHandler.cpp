@@ -2,6 +2,7 @@
 #include "../../Game/CritterObject.h"
 #include "../../Game/Game.h"
 #include "../../PathFinding/HexagonGrid.h"
+#include "../../PathFinding/PathQueue.h"
 #include "../../State/Location.h"
 #include "../../VM/Script.h"
 
@@ -32,17 +33,17 @@ namespace Falltergeist
                 // ANIMATE_INTERRUPT (16) - flag to interrupt current animation
                 auto critter = dynamic_cast<Game::CritterObject *>(object);
                 auto state = Game::Game::getInstance()->locationState();
-                if (state) {
+                if (state && critter && critter->hexagon()) {
                     auto tileObj = state->hexagonGrid()->at(tile);
-                    auto path = state->hexagonGrid()->findPath(object->hexagon(), tileObj);
-                    if (path.size()) {
-                        critter->stopMovement();
-                        critter->setRunning((speed & 1) != 0);
-                        auto queue = critter->movementQueue();
-                        for (auto pathHexagon : path) {
-                            queue->push_back(pathHexagon);
+                    // critters move on the next tick, when all their paths are found,
+                    // and stay where they are meanwhile so the path starts at their hexagon
+                    critter->stopMovement();
+                    state->pathQueue()->request(object, object->hexagon(), tileObj, 0, [critter, speed](PathResult result, const std::vector<Hexagon*>& path) {
+                        if (result == PathResult::FOUND) {
+                            critter->setRunning((speed & 1) != 0);
+                            critter->movementQueue()->assign(path.begin(), path.end());
                         }
-                    }
+                    });
                 }
             }
         }
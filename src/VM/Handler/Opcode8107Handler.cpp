@@ -1,5 +1,7 @@
 #include "../../VM/Handler/Opcode8107Handler.h"
+#include "../../Game/Game.h"
 #include "../../Game/Object.h"
+#include "../../State/Location.h"
 #include "../../VM/Script.h"
 
 namespace Falltergeist
@@ -32,6 +34,10 @@ namespace Falltergeist
                 unsigned int light = 65536 / 100 * level;
                 object->setLightIntensity(light);
                 object->setLightRadius(radius);
+                auto location = Game::Game::getInstance()->locationState();
+                if (location && object->hexagon()) {
+                    location->updateLight(object);
+                }
             }
         }
     }
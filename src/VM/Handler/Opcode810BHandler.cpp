@@ -52,7 +52,7 @@ namespace Falltergeist
                                             auto position = hexagon->number();
                                             auto objects = Game::Game::getInstance()->locationState()->hexagonGrid()->at(position)->objects();
 
-                                            for (auto object : *objects) {
+                                            for (auto object : objects) {
                                                 if (object->type() == Game::Object::Type::SCENERY && object->PID() == PID_ELEVATOR_STUB) {
                                                     if (auto elevatorStub = dynamic_cast<Game::ElevatorSceneryObject *>(object)) {
                                                         logger->info() << "[ELEVATOR] stub found: type = " << (uint32_t)elevatorStub->elevatorType() << " level = " << (uint32_t)elevatorStub->elevatorLevel() << std::endl;
@@ -2,7 +2,6 @@
 #include "../../Game/Game.h"
 #include "../../State/CritterDialog.h"
 #include "../../State/CritterInteract.h"
-#include "../../VM/HaltException.h"
 #include "../../VM/Script.h"
 
 namespace Falltergeist
@@ -22,7 +21,8 @@ namespace Falltergeist
                 auto dialog = dynamic_cast<State::CritterDialog *>(Game::Game::getInstance()->topState());
                 if (dialog->hasAnswers()) {
                     _script->dataStack()->push(0); // function return value
-                    throw HaltException();
+                    _script->halt();
+                    return;
                 }
                 if (auto interact = dynamic_cast<Falltergeist::State::CritterInteract *>(Game::Game::getInstance()->topState(
                         1))) {
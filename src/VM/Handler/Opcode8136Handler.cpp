@@ -2,7 +2,6 @@
 #include "../../Game/Game.h"
 #include "../../Graphics/Renderer.h"
 #include "../../State/State.h"
-#include "../../VM/HaltException.h"
 #include "../../VM/Script.h"
 
 namespace Falltergeist
@@ -26,7 +25,7 @@ namespace Falltergeist
 
                 auto state = Game::Game::getInstance()->topState();
                 state->scriptFade(_script, false);
-                throw HaltException();
+                _script->halt();
             }
         }
     }
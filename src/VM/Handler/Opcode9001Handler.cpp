@@ -16,24 +16,16 @@ namespace Falltergeist
 
             void Opcode9001::_run()
             {
-                unsigned int data = _script->script()->readValue();
-                unsigned short nextOpcode = _script->script()->readOpcode();
+                unsigned int data = _script->operand();
 
-                // Skip 4 readed bytes
+                // Skip 4 bytes of the value
                 _script->setProgramCounter(_script->programCounter() + 4);
 
-                switch (nextOpcode) {
-                    case 0x8014: // get exported var value
-                    case 0x8015: // set exported var value
-                    case 0x8016: // export var
-                    {
-                        _script->dataStack()->push(_script->script()->identifiers().at(data));
-                        break;
-                    }
-                    default: {
-                        _script->dataStack()->push(_script->script()->strings().at(data));
-                        break;
-                    }
+                // both kinds of constants were put into the string pool when the script was created
+                if (_script->operandKind() == Format::Int::OperandKind::IDENTIFIER) {
+                    _script->dataStack()->push(StackValue::constant(_script->script()->identifierId(data)));
+                } else {
+                    _script->dataStack()->push(StackValue::constant(_script->script()->stringId(data)));
                 }
 
                 auto value = _script->dataStack()->top();
@@ -1,5 +1,4 @@
 #include "../../VM/Handler/OpcodeA001Handler.h"
-#include "../../Format/Int/File.h"
 #include "../../VM/Script.h"
 #include "../../VM/StackValue.h"
 
@@ -21,7 +20,7 @@ namespace Falltergeist
                     float fValue;
                 } uValue;
 
-                uValue.iValue = _script->script()->readValue();
+                uValue.iValue = _script->operand();
 
                 // Skip 4 bytes for read float value
                 _script->setProgramCounter(_script->programCounter() + 4);
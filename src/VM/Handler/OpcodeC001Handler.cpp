@@ -1,5 +1,4 @@
 #include "../../VM/Handler/OpcodeC001Handler.h"
-#include "../../Format/Int/File.h"
 #include "../../VM/Script.h"
 #include "../../VM/StackValue.h"
 
@@ -16,7 +15,7 @@ namespace Falltergeist
 
             void OpcodeC001::_run()
             {
-                int value = _script->script()->readValue();
+                int value = _script->operand();
 
                 // Skip 4 bytes for readed integer value
                 _script->setProgramCounter(_script->programCounter() + 4);
@@ -1,8 +1,6 @@
 #include "../VM/OpcodeFactory.h"
-#include <sstream>
+#include <array>
 #include <memory>
-#include "../Exception.h"
-#include "../Logger.h"
 #include "../VM/Handler/Opcode8002.h"
 #include "../VM/Handler/Opcode8003.h"
 #include "../VM/Handler/Opcode8004.h"
@@ -188,414 +186,243 @@ namespace Falltergeist
 {
     namespace VM
     {
-        std::unique_ptr<OpcodeHandler> OpcodeFactory::createOpcode(unsigned int number, VM::Script *script)
+        namespace
         {
-            auto logger = std::make_shared<Logger>();
+            const unsigned int OPERATORS_BASE = 0x8000;
+            const unsigned int OPERATORS_COUNT = 0x200;
+
+            // Handlers are created on the stack, so running an opcode doesn't allocate anything
+            template <class T>
+            void execute(VM::Script *script, const std::shared_ptr<ILogger> &logger)
+            {
+                T handler(script, logger);
+                handler.run();
+            }
+
+            template <Handler::OpcodeComparison::Type type>
+            void executeComparison(VM::Script *script, const std::shared_ptr<ILogger> &logger)
+            {
+                Handler::OpcodeComparison handler(script, type, logger);
+                handler.run();
+            }
+
+            void executeNoop(VM::Script *script, const std::shared_ptr<ILogger> &)
+            {
+                OpcodeHandler handler(script);
+                handler.run();
+            }
+
+            // Operators 0x8000 - 0x81FF, unimplemented ones are nullptr
+            std::array<OpcodeFactory::Executor, OPERATORS_COUNT> createOperatorsTable()
+            {
+                std::array<OpcodeFactory::Executor, OPERATORS_COUNT> table{};
+                table[0x8000 - OPERATORS_BASE] = &executeNoop; // O_NOOP
+                table[0x8002 - OPERATORS_BASE] = &execute<Handler::Opcode8002>;
+                table[0x8003 - OPERATORS_BASE] = &execute<Handler::Opcode8003>;
+                table[0x8004 - OPERATORS_BASE] = &execute<Handler::Opcode8004>;
+                table[0x8005 - OPERATORS_BASE] = &execute<Handler::Opcode8005>;
+                table[0x800C - OPERATORS_BASE] = &execute<Handler::Opcode800C>;
+                table[0x800D - OPERATORS_BASE] = &execute<Handler::Opcode800D>;
+                table[0x8010 - OPERATORS_BASE] = &execute<Handler::Opcode8010>;
+                table[0x8012 - OPERATORS_BASE] = &execute<Handler::Opcode8012>;
+                table[0x8013 - OPERATORS_BASE] = &execute<Handler::Opcode8013>;
+                table[0x8014 - OPERATORS_BASE] = &execute<Handler::Opcode8014>;
+                table[0x8015 - OPERATORS_BASE] = &execute<Handler::Opcode8015>;
+                table[0x8016 - OPERATORS_BASE] = &execute<Handler::Opcode8016>;
+                table[0x8018 - OPERATORS_BASE] = &execute<Handler::Opcode8018>;
+                table[0x8019 - OPERATORS_BASE] = &execute<Handler::Opcode8019>;
+                table[0x801A - OPERATORS_BASE] = &execute<Handler::Opcode801A>;
+                table[0x801B - OPERATORS_BASE] = &execute<Handler::Opcode801B>;
+                table[0x801C - OPERATORS_BASE] = &execute<Handler::Opcode801C>;
+                table[0x8027 - OPERATORS_BASE] = &execute<Handler::Opcode8027>;
+                table[0x8028 - OPERATORS_BASE] = &execute<Handler::Opcode8028>;
+                table[0x8029 - OPERATORS_BASE] = &execute<Handler::Opcode8029>;
+                table[0x802A - OPERATORS_BASE] = &execute<Handler::Opcode802A>;
+                table[0x802B - OPERATORS_BASE] = &execute<Handler::Opcode802B>;
+                table[0x802C - OPERATORS_BASE] = &execute<Handler::Opcode802C>;
+                table[0x802F - OPERATORS_BASE] = &execute<Handler::Opcode802F>;
+                table[0x8030 - OPERATORS_BASE] = &execute<Handler::Opcode8030>;
+                table[0x8031 - OPERATORS_BASE] = &execute<Handler::Opcode8031>;
+                table[0x8032 - OPERATORS_BASE] = &execute<Handler::Opcode8032>;
+                table[0x8033 - OPERATORS_BASE] = &executeComparison<Handler::OpcodeComparison::Type::EQUAL>;
+                table[0x8034 - OPERATORS_BASE] = &executeComparison<Handler::OpcodeComparison::Type::NOT_EQUAL>;
+                table[0x8035 - OPERATORS_BASE] = &executeComparison<Handler::OpcodeComparison::Type::LESS_EQUAL>;
+                table[0x8036 - OPERATORS_BASE] = &executeComparison<Handler::OpcodeComparison::Type::GREATER_EQUAL>;
+                table[0x8037 - OPERATORS_BASE] = &executeComparison<Handler::OpcodeComparison::Type::LESS>;
+                table[0x8038 - OPERATORS_BASE] = &executeComparison<Handler::OpcodeComparison::Type::GREATER>;
+                table[0x8039 - OPERATORS_BASE] = &execute<Handler::Opcode8039>;
+                table[0x803A - OPERATORS_BASE] = &execute<Handler::Opcode803A>;
+                table[0x803B - OPERATORS_BASE] = &execute<Handler::Opcode803B>;
+                table[0x803C - OPERATORS_BASE] = &execute<Handler::Opcode803C>;
+                table[0x803D - OPERATORS_BASE] = &execute<Handler::Opcode803D>;
+                table[0x803E - OPERATORS_BASE] = &execute<Handler::Opcode803E>;
+                table[0x803F - OPERATORS_BASE] = &execute<Handler::Opcode803F>;
+                table[0x8040 - OPERATORS_BASE] = &execute<Handler::Opcode8040>;
+                table[0x8041 - OPERATORS_BASE] = &execute<Handler::Opcode8041>;
+                table[0x8042 - OPERATORS_BASE] = &execute<Handler::Opcode8042>; // bwxor
+                table[0x8043 - OPERATORS_BASE] = &execute<Handler::Opcode8043>; // bwnot
+                table[0x8044 - OPERATORS_BASE] = &execute<Handler::Opcode8044>;
+                table[0x8045 - OPERATORS_BASE] = &execute<Handler::Opcode8045>;
+                table[0x8046 - OPERATORS_BASE] = &execute<Handler::Opcode8046>;
+                table[0x80A1 - OPERATORS_BASE] = &execute<Handler::Opcode80A1>;
+                table[0x80A3 - OPERATORS_BASE] = &execute<Handler::Opcode80A3>;
+                table[0x80A4 - OPERATORS_BASE] = &execute<Handler::Opcode80A4>;
+                table[0x80A6 - OPERATORS_BASE] = &execute<Handler::Opcode80A6>;
+                table[0x80A7 - OPERATORS_BASE] = &execute<Handler::Opcode80A7>;
+                table[0x80A8 - OPERATORS_BASE] = &execute<Handler::Opcode80A8>;
+                table[0x80A9 - OPERATORS_BASE] = &execute<Handler::Opcode80A9>;
+                table[0x80AA - OPERATORS_BASE] = &execute<Handler::Opcode80AA>;
+                table[0x80AB - OPERATORS_BASE] = &execute<Handler::Opcode80AB>;
+                table[0x80AC - OPERATORS_BASE] = &execute<Handler::Opcode80AC>;
+                table[0x80AE - OPERATORS_BASE] = &execute<Handler::Opcode80AE>;
+                table[0x80AF - OPERATORS_BASE] = &execute<Handler::Opcode80AF>;
+                table[0x80B0 - OPERATORS_BASE] = &execute<Handler::Opcode80B0>;
+                table[0x80B2 - OPERATORS_BASE] = &execute<Handler::Opcode80B2>;
+                table[0x80B4 - OPERATORS_BASE] = &execute<Handler::Opcode80B4>;
+                table[0x80B6 - OPERATORS_BASE] = &execute<Handler::Opcode80B6>;
+                table[0x80B7 - OPERATORS_BASE] = &execute<Handler::Opcode80B7>;
+                table[0x80B8 - OPERATORS_BASE] = &execute<Handler::Opcode80B8>;
+                table[0x80B9 - OPERATORS_BASE] = &execute<Handler::Opcode80B9>;
+                table[0x80BA - OPERATORS_BASE] = &execute<Handler::Opcode80BA>;
+                table[0x80BB - OPERATORS_BASE] = &execute<Handler::Opcode80BB>;
+                table[0x80BC - OPERATORS_BASE] = &execute<Handler::Opcode80BC>; // self_obj
+                table[0x80BD - OPERATORS_BASE] = &execute<Handler::Opcode80BD>; // source_obj
+                table[0x80BE - OPERATORS_BASE] = &execute<Handler::Opcode80BE>; // target_obj
+                table[0x80BF - OPERATORS_BASE] = &execute<Handler::Opcode80BF>; // dude_obj
+                // obj_being_used_with - uses the same code as target_obj in original
+                table[0x80C0 - OPERATORS_BASE] = &execute<Handler::Opcode80BE>;
+                table[0x80C1 - OPERATORS_BASE] = &execute<Handler::Opcode80C1>;
+                table[0x80C2 - OPERATORS_BASE] = &execute<Handler::Opcode80C2>;
+                table[0x80C3 - OPERATORS_BASE] = &execute<Handler::Opcode80C3>;
+                table[0x80C4 - OPERATORS_BASE] = &execute<Handler::Opcode80C4>;
+                table[0x80C5 - OPERATORS_BASE] = &execute<Handler::Opcode80C5>;
+                table[0x80C6 - OPERATORS_BASE] = &execute<Handler::Opcode80C6>;
+                table[0x80C7 - OPERATORS_BASE] = &execute<Handler::Opcode80C7>;
+                table[0x80C8 - OPERATORS_BASE] = &execute<Handler::Opcode80C8>;
+                table[0x80C9 - OPERATORS_BASE] = &execute<Handler::Opcode80C9>;
+                table[0x80CA - OPERATORS_BASE] = &execute<Handler::Opcode80CA>;
+                table[0x80CB - OPERATORS_BASE] = &execute<Handler::Opcode80CB>;
+                table[0x80CC - OPERATORS_BASE] = &execute<Handler::Opcode80CC>;
+                table[0x80CD - OPERATORS_BASE] = &execute<Handler::Opcode80CD>;
+                table[0x80CE - OPERATORS_BASE] = &execute<Handler::Opcode80CE>;
+                table[0x80CF - OPERATORS_BASE] = &execute<Handler::Opcode80CF>;
+                table[0x80D0 - OPERATORS_BASE] = &execute<Handler::Opcode80D0>;
+                table[0x80D2 - OPERATORS_BASE] = &execute<Handler::Opcode80D2>;
+                table[0x80D3 - OPERATORS_BASE] = &execute<Handler::Opcode80D3>;
+                table[0x80D4 - OPERATORS_BASE] = &execute<Handler::Opcode80D4>;
+                table[0x80D5 - OPERATORS_BASE] = &execute<Handler::Opcode80D5>;
+                table[0x80D8 - OPERATORS_BASE] = &execute<Handler::Opcode80D8>;
+                table[0x80D9 - OPERATORS_BASE] = &execute<Handler::Opcode80D9>;
+                table[0x80DA - OPERATORS_BASE] = &execute<Handler::Opcode80DA>;
+                table[0x80DC - OPERATORS_BASE] = &execute<Handler::Opcode80DC>;
+                table[0x80DE - OPERATORS_BASE] = &execute<Handler::Opcode80DE>;
+                table[0x80DF - OPERATORS_BASE] = &execute<Handler::Opcode80DF>;
+                table[0x80E1 - OPERATORS_BASE] = &execute<Handler::Opcode80E1>;
+                table[0x80E3 - OPERATORS_BASE] = &execute<Handler::Opcode80E3>;
+                table[0x80E4 - OPERATORS_BASE] = &execute<Handler::Opcode80E4>;
+                table[0x80E5 - OPERATORS_BASE] = &execute<Handler::Opcode80E6>;
+                table[0x80E6 - OPERATORS_BASE] = &execute<Handler::Opcode80E5>;
+                table[0x80E7 - OPERATORS_BASE] = &execute<Handler::Opcode80E7>;
+                table[0x80E8 - OPERATORS_BASE] = &execute<Handler::Opcode80E8>;
+                table[0x80E9 - OPERATORS_BASE] = &execute<Handler::Opcode80E9>;
+                table[0x80EA - OPERATORS_BASE] = &execute<Handler::Opcode80EA>;
+                table[0x80EC - OPERATORS_BASE] = &execute<Handler::Opcode80EC>;
+                table[0x80EE - OPERATORS_BASE] = &execute<Handler::Opcode80EE>;
+                table[0x80EF - OPERATORS_BASE] = &execute<Handler::Opcode80EF>;
+                table[0x80F0 - OPERATORS_BASE] = &execute<Handler::Opcode80F0>;
+                table[0x80F1 - OPERATORS_BASE] = &execute<Handler::Opcode80F1>;
+                table[0x80F2 - OPERATORS_BASE] = &execute<Handler::Opcode80F2>;
+                table[0x80F3 - OPERATORS_BASE] = &execute<Handler::Opcode80F3>;
+                table[0x80F4 - OPERATORS_BASE] = &execute<Handler::Opcode80F4>;
+                table[0x80F6 - OPERATORS_BASE] = &execute<Handler::Opcode80F6>;
+                table[0x80F7 - OPERATORS_BASE] = &execute<Handler::Opcode80F7>;
+                table[0x80F8 - OPERATORS_BASE] = &execute<Handler::Opcode80F8>;
+                table[0x80F9 - OPERATORS_BASE] = &execute<Handler::Opcode80F9>;
+                table[0x80FA - OPERATORS_BASE] = &execute<Handler::Opcode80FA>;
+                table[0x80FB - OPERATORS_BASE] = &execute<Handler::Opcode80FB>;
+                table[0x80FC - OPERATORS_BASE] = &execute<Handler::Opcode80FC>;
+                table[0x80FD - OPERATORS_BASE] = &execute<Handler::Opcode80FD>;
+                table[0x80FE - OPERATORS_BASE] = &execute<Handler::Opcode80FE>;
+                table[0x80FF - OPERATORS_BASE] = &execute<Handler::Opcode80FF>;
+                table[0x8100 - OPERATORS_BASE] = &execute<Handler::Opcode8100>;
+                table[0x8101 - OPERATORS_BASE] = &execute<Handler::Opcode8101>;
+                table[0x8102 - OPERATORS_BASE] = &execute<Handler::Opcode8102>;
+                table[0x8105 - OPERATORS_BASE] = &execute<Handler::Opcode8105>;
+                table[0x8106 - OPERATORS_BASE] = &execute<Handler::Opcode8106>;
+                table[0x8107 - OPERATORS_BASE] = &execute<Handler::Opcode8107>;
+                table[0x810A - OPERATORS_BASE] = &execute<Handler::Opcode810A>;
+                table[0x810B - OPERATORS_BASE] = &execute<Handler::Opcode810B>;
+                table[0x810C - OPERATORS_BASE] = &execute<Handler::Opcode810C>;
+                table[0x810D - OPERATORS_BASE] = &execute<Handler::Opcode810D>;
+                table[0x810E - OPERATORS_BASE] = &execute<Handler::Opcode810E>;
+                table[0x810F - OPERATORS_BASE] = &execute<Handler::Opcode810F>;
+                table[0x8113 - OPERATORS_BASE] = &execute<Handler::Opcode8113>;
+                table[0x8115 - OPERATORS_BASE] = &execute<Handler::Opcode8115>;
+                table[0x8116 - OPERATORS_BASE] = &execute<Handler::Opcode8116>;
+                table[0x8117 - OPERATORS_BASE] = &execute<Handler::Opcode8117>;
+                table[0x8118 - OPERATORS_BASE] = &execute<Handler::Opcode8118>;
+                table[0x8119 - OPERATORS_BASE] = &execute<Handler::Opcode8119>;
+                table[0x811A - OPERATORS_BASE] = &execute<Handler::Opcode811A>;
+                table[0x811C - OPERATORS_BASE] = &execute<Handler::Opcode811C>;
+                table[0x811D - OPERATORS_BASE] = &execute<Handler::Opcode811D>;
+                table[0x811E - OPERATORS_BASE] = &execute<Handler::Opcode811E>;
+                table[0x8120 - OPERATORS_BASE] = &execute<Handler::Opcode8120>;
+                table[0x8121 - OPERATORS_BASE] = &execute<Handler::Opcode8121>;
+                table[0x8122 - OPERATORS_BASE] = &execute<Handler::Opcode8122>;
+                table[0x8123 - OPERATORS_BASE] = &execute<Handler::Opcode8123>;
+                table[0x8126 - OPERATORS_BASE] = &execute<Handler::Opcode8126>;
+                table[0x8127 - OPERATORS_BASE] = &execute<Handler::Opcode8127>;
+                table[0x8128 - OPERATORS_BASE] = &execute<Handler::Opcode8128>;
+                table[0x8129 - OPERATORS_BASE] = &execute<Handler::Opcode8129>;
+                table[0x812D - OPERATORS_BASE] = &execute<Handler::Opcode812D>;
+                table[0x812E - OPERATORS_BASE] = &execute<Handler::Opcode812E>;
+                table[0x812F - OPERATORS_BASE] = &execute<Handler::Opcode812F>;
+                table[0x8130 - OPERATORS_BASE] = &execute<Handler::Opcode8130>;
+                table[0x8131 - OPERATORS_BASE] = &execute<Handler::Opcode8131>;
+                table[0x8132 - OPERATORS_BASE] = &execute<Handler::Opcode8132>;
+                table[0x8133 - OPERATORS_BASE] = &execute<Handler::Opcode8133>;
+                table[0x8134 - OPERATORS_BASE] = &execute<Handler::Opcode8134>;
+                table[0x8136 - OPERATORS_BASE] = &execute<Handler::Opcode8136>;
+                table[0x8137 - OPERATORS_BASE] = &execute<Handler::Opcode8137>;
+                table[0x8138 - OPERATORS_BASE] = &execute<Handler::Opcode8138>;
+                table[0x8139 - OPERATORS_BASE] = &execute<Handler::Opcode8139>;
+                table[0x813C - OPERATORS_BASE] = &execute<Handler::Opcode813C>;
+                table[0x8143 - OPERATORS_BASE] = &execute<Handler::Opcode8143>;
+                table[0x8145 - OPERATORS_BASE] = &execute<Handler::Opcode8145>;
+                table[0x8147 - OPERATORS_BASE] = &execute<Handler::Opcode8147>;
+                table[0x8149 - OPERATORS_BASE] = &execute<Handler::Opcode8149>;
+                table[0x814A - OPERATORS_BASE] = &execute<Handler::Opcode814A>;
+                table[0x814B - OPERATORS_BASE] = &execute<Handler::Opcode814B>;
+                table[0x814C - OPERATORS_BASE] = &execute<Handler::Opcode814C>;
+                table[0x814E - OPERATORS_BASE] = &execute<Handler::Opcode814E>;
+                table[0x8150 - OPERATORS_BASE] = &execute<Handler::Opcode8150>;
+                table[0x8151 - OPERATORS_BASE] = &execute<Handler::Opcode8151>;
+                table[0x8152 - OPERATORS_BASE] = &execute<Handler::Opcode8152>;
+                table[0x8153 - OPERATORS_BASE] = &execute<Handler::Opcode8153>;
+                table[0x8154 - OPERATORS_BASE] = &execute<Handler::Opcode8154>;
+                return table;
+            }
+        }
+
+        OpcodeFactory::Executor OpcodeFactory::executor(unsigned int number)
+        {
+            static const auto operators = createOperatorsTable();
 
             switch (number) {
-                case 0x8000:
-                    return std::make_unique<OpcodeHandler>(script); // O_NOOP
-                case 0x8002:
-                    return std::make_unique<Handler::Opcode8002>(script, logger);
-                case 0x8003:
-                    return std::make_unique<Handler::Opcode8003>(script, logger);
-                case 0x8004:
-                    return std::make_unique<Handler::Opcode8004>(script, logger);
-                case 0x8005:
-                    return std::make_unique<Handler::Opcode8005>(script, logger);
-                case 0x800C:
-                    return std::make_unique<Handler::Opcode800C>(script, logger);
-                case 0x800D:
-                    return std::make_unique<Handler::Opcode800D>(script, logger);
-                case 0x8010:
-                    return std::make_unique<Handler::Opcode8010>(script, logger);
-                case 0x8012:
-                    return std::make_unique<Handler::Opcode8012>(script, logger);
-                case 0x8013:
-                    return std::make_unique<Handler::Opcode8013>(script, logger);
-                case 0x8014:
-                    return std::make_unique<Handler::Opcode8014>(script, logger);
-                case 0x8015:
-                    return std::make_unique<Handler::Opcode8015>(script, logger);
-                case 0x8016:
-                    return std::make_unique<Handler::Opcode8016>(script, logger);
-                case 0x8018:
-                    return std::make_unique<Handler::Opcode8018>(script, logger);
-                case 0x8019:
-                    return std::make_unique<Handler::Opcode8019>(script, logger);
-                case 0x801A:
-                    return std::make_unique<Handler::Opcode801A>(script, logger);
-                case 0x801B:
-                    return std::make_unique<Handler::Opcode801B>(script, logger);
-                case 0x801C:
-                    return std::make_unique<Handler::Opcode801C>(script, logger);
-                case 0x8027:
-                    return std::make_unique<Handler::Opcode8027>(script, logger);
-                case 0x8028:
-                    return std::make_unique<Handler::Opcode8028>(script, logger);
-                case 0x8029:
-                    return std::make_unique<Handler::Opcode8029>(script, logger);
-                case 0x802A:
-                    return std::make_unique<Handler::Opcode802A>(script, logger);
-                case 0x802B:
-                    return std::make_unique<Handler::Opcode802B>(script, logger);
-                case 0x802C:
-                    return std::make_unique<Handler::Opcode802C>(script, logger);
-                case 0x802F:
-                    return std::make_unique<Handler::Opcode802F>(script, logger);
-                case 0x8030:
-                    return std::make_unique<Handler::Opcode8030>(script, logger);
-                case 0x8031:
-                    return std::make_unique<Handler::Opcode8031>(script, logger);
-                case 0x8032:
-                    return std::make_unique<Handler::Opcode8032>(script, logger);
-                case 0x8033:
-                    return std::make_unique<Handler::OpcodeComparison>(
-                        script,
-                        Handler::OpcodeComparison::Type::EQUAL,
-                        logger
-                    );
-                case 0x8034:
-                    return std::make_unique<Handler::OpcodeComparison>(
-                        script,
-                       Handler::OpcodeComparison::Type::NOT_EQUAL,
-                       logger
-                   );
-                case 0x8035:
-                    return std::make_unique<Handler::OpcodeComparison>(
-                        script,
-                        Handler::OpcodeComparison::Type::LESS_EQUAL,
-                        logger
-                    );
-                case 0x8036:
-                    return std::make_unique<Handler::OpcodeComparison>(
-                        script,
-                        Handler::OpcodeComparison::Type::GREATER_EQUAL,
-                        logger
-                    );
-                case 0x8037:
-                    return std::make_unique<Handler::OpcodeComparison>(
-                        script,
-                        Handler::OpcodeComparison::Type::LESS,
-                        logger
-                    );
-                case 0x8038:
-                    return std::make_unique<Handler::OpcodeComparison>(
-                        script,
-                        Handler::OpcodeComparison::Type::GREATER,
-                        logger
-                    );
-                case 0x8039:
-                    return std::make_unique<Handler::Opcode8039>(script, logger);
-                case 0x803A:
-                    return std::make_unique<Handler::Opcode803A>(script, logger);
-                case 0x803B:
-                    return std::make_unique<Handler::Opcode803B>(script, logger);
-                case 0x803C:
-                    return std::make_unique<Handler::Opcode803C>(script, logger);
-                case 0x803D:
-                    return std::make_unique<Handler::Opcode803D>(script, logger);
-                case 0x803E:
-                    return std::make_unique<Handler::Opcode803E>(script, logger);
-                case 0x803F:
-                    return std::make_unique<Handler::Opcode803F>(script, logger);
-                case 0x8040:
-                    return std::make_unique<Handler::Opcode8040>(script, logger);
-                case 0x8041:
-                    return std::make_unique<Handler::Opcode8041>(script, logger);
-                case 0x8042:
-                    return std::make_unique<Handler::Opcode8042>(script, logger); // bwxor
-                case 0x8043:
-                    return std::make_unique<Handler::Opcode8043>(script, logger); // bwnot
-                case 0x8044:
-                    return std::make_unique<Handler::Opcode8044>(script, logger);
-                case 0x8045:
-                    return std::make_unique<Handler::Opcode8045>(script, logger);
-                case 0x8046:
-                    return std::make_unique<Handler::Opcode8046>(script, logger);
-                case 0x80A1:
-                    return std::make_unique<Handler::Opcode80A1>(script, logger);
-                case 0x80A3:
-                    return std::make_unique<Handler::Opcode80A3>(script, logger);
-                case 0x80A4:
-                    return std::make_unique<Handler::Opcode80A4>(script, logger);
-                case 0x80A6:
-                    return std::make_unique<Handler::Opcode80A6>(script, logger);
-                case 0x80A7:
-                    return std::make_unique<Handler::Opcode80A7>(script, logger);
-                case 0x80A8:
-                    return std::make_unique<Handler::Opcode80A8>(script, logger);
-                case 0x80A9:
-                    return std::make_unique<Handler::Opcode80A9>(script, logger);
-                case 0x80AA:
-                    return std::make_unique<Handler::Opcode80AA>(script, logger);
-                case 0x80AB:
-                    return std::make_unique<Handler::Opcode80AB>(script, logger);
-                case 0x80AC:
-                    return std::make_unique<Handler::Opcode80AC>(script, logger);
-                case 0x80AE:
-                    return std::make_unique<Handler::Opcode80AE>(script, logger);
-                case 0x80AF:
-                    return std::make_unique<Handler::Opcode80AF>(script, logger);
-                case 0x80B0:
-                    return std::make_unique<Handler::Opcode80B0>(script, logger);
-                case 0x80B2:
-                    return std::make_unique<Handler::Opcode80B2>(script, logger);
-                case 0x80B4:
-                    return std::make_unique<Handler::Opcode80B4>(script, logger);
-                case 0x80B6:
-                    return std::make_unique<Handler::Opcode80B6>(script, logger);
-                case 0x80B7:
-                    return std::make_unique<Handler::Opcode80B7>(script, logger);
-                case 0x80B8:
-                    return std::make_unique<Handler::Opcode80B8>(script, logger);
-                case 0x80B9:
-                    return std::make_unique<Handler::Opcode80B9>(script, logger);
-                case 0x80BA:
-                    return std::make_unique<Handler::Opcode80BA>(script, logger);
-                case 0x80BB:
-                    return std::make_unique<Handler::Opcode80BB>(script, logger);
-                case 0x80BC:
-                    return std::make_unique<Handler::Opcode80BC>(script, logger); // self_obj
-                case 0x80BD:
-                    return std::make_unique<Handler::Opcode80BD>(script, logger); // source_obj
-                case 0x80BE:
-                    return std::make_unique<Handler::Opcode80BE>(script, logger); // target_obj
-                case 0x80BF:
-                    return std::make_unique<Handler::Opcode80BF>(script, logger); // dude_obj
-                case 0x80C0:
-                    // obj_being_used_with - uses the same code as target_obj in original
-                    return std::make_unique<Handler::Opcode80BE>(script, logger);
-                case 0x80C1:
-                    return std::make_unique<Handler::Opcode80C1>(script, logger);
-                case 0x80C2:
-                    return std::make_unique<Handler::Opcode80C2>(script, logger);
-                case 0x80C3:
-                    return std::make_unique<Handler::Opcode80C3>(script, logger);
-                case 0x80C4:
-                    return std::make_unique<Handler::Opcode80C4>(script, logger);
-                case 0x80C5:
-                    return std::make_unique<Handler::Opcode80C5>(script, logger);
-                case 0x80C6:
-                    return std::make_unique<Handler::Opcode80C6>(script, logger);
-                case 0x80C7:
-                    return std::make_unique<Handler::Opcode80C7>(script, logger);
-                case 0x80C8:
-                    return std::make_unique<Handler::Opcode80C8>(script, logger);
-                case 0x80C9:
-                    return std::make_unique<Handler::Opcode80C9>(script, logger);
-                case 0x80CA:
-                    return std::make_unique<Handler::Opcode80CA>(script, logger);
-                case 0x80CB:
-                    return std::make_unique<Handler::Opcode80CB>(script, logger);
-                case 0x80CC:
-                    return std::make_unique<Handler::Opcode80CC>(script, logger);
-                case 0x80CD:
-                    return std::make_unique<Handler::Opcode80CD>(script, logger);
-                case 0x80CE:
-                    return std::make_unique<Handler::Opcode80CE>(script, logger);
-                case 0x80CF:
-                    return std::make_unique<Handler::Opcode80CF>(script, logger);
-                case 0x80D0:
-                    return std::make_unique<Handler::Opcode80D0>(script, logger);
-                case 0x80D2:
-                    return std::make_unique<Handler::Opcode80D2>(script, logger);
-                case 0x80D3:
-                    return std::make_unique<Handler::Opcode80D3>(script, logger);
-                case 0x80D4:
-                    return std::make_unique<Handler::Opcode80D4>(script, logger);
-                case 0x80D5:
-                    return std::make_unique<Handler::Opcode80D5>(script, logger);
-                case 0x80D8:
-                    return std::make_unique<Handler::Opcode80D8>(script, logger);
-                case 0x80D9:
-                    return std::make_unique<Handler::Opcode80D9>(script, logger);
-                case 0x80DA:
-                    return std::make_unique<Handler::Opcode80DA>(script, logger);
-                case 0x80DC:
-                    return std::make_unique<Handler::Opcode80DC>(script, logger);
-                case 0x80DE:
-                    return std::make_unique<Handler::Opcode80DE>(script, logger);
-                case 0x80DF:
-                    return std::make_unique<Handler::Opcode80DF>(script, logger);
-                case 0x80E1:
-                    return std::make_unique<Handler::Opcode80E1>(script, logger);
-                case 0x80E3:
-                    return std::make_unique<Handler::Opcode80E3>(script, logger);
-                case 0x80E4:
-                    return std::make_unique<Handler::Opcode80E4>(script, logger);
-                case 0x80E5:
-                    return std::make_unique<Handler::Opcode80E6>(script, logger);
-                case 0x80E6:
-                    return std::make_unique<Handler::Opcode80E5>(script, logger);
-                case 0x80E7:
-                    return std::make_unique<Handler::Opcode80E7>(script, logger);
-                case 0x80E8:
-                    return std::make_unique<Handler::Opcode80E8>(script, logger);
-                case 0x80E9:
-                    return std::make_unique<Handler::Opcode80E9>(script, logger);
-                case 0x80EA:
-                    return std::make_unique<Handler::Opcode80EA>(script, logger);
-                case 0x80EC:
-                    return std::make_unique<Handler::Opcode80EC>(script, logger);
-                case 0x80EE:
-                    return std::make_unique<Handler::Opcode80EE>(script, logger);
-                case 0x80EF:
-                    return std::make_unique<Handler::Opcode80EF>(script, logger);
-                case 0x80F0:
-                    return std::make_unique<Handler::Opcode80F0>(script, logger);
-                case 0x80F1:
-                    return std::make_unique<Handler::Opcode80F1>(script, logger);
-                case 0x80F2:
-                    return std::make_unique<Handler::Opcode80F2>(script, logger);
-                case 0x80F3:
-                    return std::make_unique<Handler::Opcode80F3>(script, logger);
-                case 0x80F4:
-                    return std::make_unique<Handler::Opcode80F4>(script, logger);
-                case 0x80F6:
-                    return std::make_unique<Handler::Opcode80F6>(script, logger);
-                case 0x80F7:
-                    return std::make_unique<Handler::Opcode80F7>(script, logger);
-                case 0x80F8:
-                    return std::make_unique<Handler::Opcode80F8>(script, logger);
-                case 0x80F9:
-                    return std::make_unique<Handler::Opcode80F9>(script, logger);
-                case 0x80FA:
-                    return std::make_unique<Handler::Opcode80FA>(script, logger);
-                case 0x80FB:
-                    return std::make_unique<Handler::Opcode80FB>(script, logger);
-                case 0x80FC:
-                    return std::make_unique<Handler::Opcode80FC>(script, logger);
-                case 0x80FD:
-                    return std::make_unique<Handler::Opcode80FD>(script, logger);
-                case 0x80FE:
-                    return std::make_unique<Handler::Opcode80FE>(script, logger);
-                case 0x80FF:
-                    return std::make_unique<Handler::Opcode80FF>(script, logger);
-                case 0x8100:
-                    return std::make_unique<Handler::Opcode8100>(script, logger);
-                case 0x8101:
-                    return std::make_unique<Handler::Opcode8101>(script, logger);
-                case 0x8102:
-                    return std::make_unique<Handler::Opcode8102>(script, logger);
-                case 0x8105:
-                    return std::make_unique<Handler::Opcode8105>(script, logger);
-                case 0x8106:
-                    return std::make_unique<Handler::Opcode8106>(script, logger);
-                case 0x8107:
-                    return std::make_unique<Handler::Opcode8107>(script, logger);
-                case 0x810A:
-                    return std::make_unique<Handler::Opcode810A>(script, logger);
-                case 0x810B:
-                    return std::make_unique<Handler::Opcode810B>(script, logger);
-                case 0x810C:
-                    return std::make_unique<Handler::Opcode810C>(script, logger);
-                case 0x810D:
-                    return std::make_unique<Handler::Opcode810D>(script, logger);
-                case 0x810E:
-                    return std::make_unique<Handler::Opcode810E>(script, logger);
-                case 0x810F:
-                    return std::make_unique<Handler::Opcode810F>(script, logger);
-                case 0x8113:
-                    return std::make_unique<Handler::Opcode8113>(script, logger);
-                case 0x8115:
-                    return std::make_unique<Handler::Opcode8115>(script, logger);
-                case 0x8116:
-                    return std::make_unique<Handler::Opcode8116>(script, logger);
-                case 0x8117:
-                    return std::make_unique<Handler::Opcode8117>(script, logger);
-                case 0x8118:
-                    return std::make_unique<Handler::Opcode8118>(script, logger);
-                case 0x8119:
-                    return std::make_unique<Handler::Opcode8119>(script, logger);
-                case 0x811A:
-                    return std::make_unique<Handler::Opcode811A>(script, logger);
-                case 0x811C:
-                    return std::make_unique<Handler::Opcode811C>(script, logger);
-                case 0x811D:
-                    return std::make_unique<Handler::Opcode811D>(script, logger);
-                case 0x811E:
-                    return std::make_unique<Handler::Opcode811E>(script, logger);
-                case 0x8120:
-                    return std::make_unique<Handler::Opcode8120>(script, logger);
-                case 0x8121:
-                    return std::make_unique<Handler::Opcode8121>(script, logger);
-                case 0x8122:
-                    return std::make_unique<Handler::Opcode8122>(script, logger);
-                case 0x8123:
-                    return std::make_unique<Handler::Opcode8123>(script, logger);
-                case 0x8126:
-                    return std::make_unique<Handler::Opcode8126>(script, logger);
-                case 0x8127:
-                    return std::make_unique<Handler::Opcode8127>(script, logger);
-                case 0x8128:
-                    return std::make_unique<Handler::Opcode8128>(script, logger);
-                case 0x8129:
-                    return std::make_unique<Handler::Opcode8129>(script, logger);
-                case 0x812D:
-                    return std::make_unique<Handler::Opcode812D>(script, logger);
-                case 0x812E:
-                    return std::make_unique<Handler::Opcode812E>(script, logger);
-                case 0x812F:
-                    return std::make_unique<Handler::Opcode812F>(script, logger);
-                case 0x8130:
-                    return std::make_unique<Handler::Opcode8130>(script, logger);
-                case 0x8131:
-                    return std::make_unique<Handler::Opcode8131>(script, logger);
-                case 0x8132:
-                    return std::make_unique<Handler::Opcode8132>(script, logger);
-                case 0x8133:
-                    return std::make_unique<Handler::Opcode8133>(script, logger);
-                case 0x8134:
-                    return std::make_unique<Handler::Opcode8134>(script, logger);
-                case 0x8136:
-                    return std::make_unique<Handler::Opcode8136>(script, logger);
-                case 0x8137:
-                    return std::make_unique<Handler::Opcode8137>(script, logger);
-                case 0x8138:
-                    return std::make_unique<Handler::Opcode8138>(script, logger);
-                case 0x8139:
-                    return std::make_unique<Handler::Opcode8139>(script, logger);
-                case 0x813C:
-                    return std::make_unique<Handler::Opcode813C>(script, logger);
-                case 0x8143:
-                    return std::make_unique<Handler::Opcode8143>(script, logger);
-                case 0x8145:
-                    return std::make_unique<Handler::Opcode8145>(script, logger);
-                case 0x8147:
-                    return std::make_unique<Handler::Opcode8147>(script, logger);
-                case 0x8149:
-                    return std::make_unique<Handler::Opcode8149>(script, logger);
-                case 0x814A:
-                    return std::make_unique<Handler::Opcode814A>(script, logger);
-                case 0x814B:
-                    return std::make_unique<Handler::Opcode814B>(script, logger);
-                case 0x814C:
-                    return std::make_unique<Handler::Opcode814C>(script, logger);
-                case 0x814E:
-                    return std::make_unique<Handler::Opcode814E>(script, logger);
-                case 0x8150:
-                    return std::make_unique<Handler::Opcode8150>(script, logger);
-                case 0x8151:
-                    return std::make_unique<Handler::Opcode8151>(script, logger);
-                case 0x8152:
-                    return std::make_unique<Handler::Opcode8152>(script, logger);
-                case 0x8153:
-                    return std::make_unique<Handler::Opcode8153>(script, logger);
-                case 0x8154:
-                    return std::make_unique<Handler::Opcode8154>(script, logger);
                 case 0x9001:
-                    return std::make_unique<Handler::Opcode9001>(script, logger);
+                    return &execute<Handler::Opcode9001>;
                 case 0xC001:
-                    return std::make_unique<Handler::OpcodeC001>(script, logger);
+                    return &execute<Handler::OpcodeC001>;
                 case 0xA001:
-                    return std::make_unique<Handler::OpcodeA001>(script, logger);
-                default: {
-                    std::stringstream ss;
-                    ss << "OpcodeFactory::createOpcode() - unimplemented opcode: " << std::hex << number;
-                    throw Exception(ss.str());
-                }
+                    return &execute<Handler::OpcodeA001>;
+                default:
+                    break;
+            }
+
+            if (number >= OPERATORS_BASE && number < OPERATORS_BASE + OPERATORS_COUNT) {
+                return operators[number - OPERATORS_BASE];
             }
+            return nullptr;
         }
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include "../ILogger.h"
 #include "../VM/OpcodeHandler.h"
 
 namespace Falltergeist
@@ -12,7 +13,11 @@ namespace Falltergeist
         class OpcodeFactory
         {
             public:
-                static std::unique_ptr<OpcodeHandler> createOpcode(unsigned int number, VM::Script *script);
+                // Runs handler of one opcode
+                using Executor = void (*)(VM::Script *script, const std::shared_ptr<ILogger> &logger);
+
+                // Returns executor of given opcode or nullptr if opcode is not implemented
+                static Executor executor(unsigned int number);
         };
     }
 }
@@ -12,31 +12,35 @@
 #include "../Logger.h"
 #include "../ResourceManager.h"
 #include "../VM/ErrorException.h"
-#include "../VM/HaltException.h"
 #include "../VM/OpcodeFactory.h"
 #include "../VM/Script.h"
 #include "../VM/StackValue.h"
+#include "../VM/StringPool.h"
 
 namespace Falltergeist
 {
     namespace VM
     {
         Script::Script(Format::Int::File *script, Game::Object *owner)
+            : _dataStack(DATA_STACK_CAPACITY), _returnStack(RETURN_STACK_CAPACITY)
         {
             _owner = owner;
             _script = script;
             if (!_script) {
                 throw Exception("Script::VM() - script is null");
             }
+            _script->internConstants(StringPool::intern);
         }
 
         Script::Script(const std::string &filename, Game::Object *owner)
+            : _dataStack(DATA_STACK_CAPACITY), _returnStack(RETURN_STACK_CAPACITY)
         {
             _owner = owner;
             _script = ResourceManager::getInstance()->intFileType(filename);
             if (!_script) {
                 throw Exception("Script::VM() - script is null: " + filename);
             }
+            _script->internConstants(StringPool::intern);
         }
 
         Script::~Script()
@@ -53,10 +57,24 @@ namespace Falltergeist
             return _script->procedure(name) != nullptr;
         }
 
+        bool Script::hasFunction(PROCEDURE procedure)
+        {
+            return _script->procedure(procedure) != nullptr;
+        }
+
         void Script::call(const std::string &name)
+        {
+            _call(_script->procedure(name));
+        }
+
+        void Script::call(PROCEDURE procedure)
+        {
+            _call(_script->procedure(procedure));
+        }
+
+        void Script::_call(const Format::Int::Procedure* procedure)
         {
             _overrides = false;
-            auto procedure = _script->procedure(name);
             if (!procedure) {
                 return;
             }
@@ -64,7 +82,7 @@ namespace Falltergeist
             _programCounter = procedure->bodyOffset();
             _dataStack.push(0); // arguments counter;
             _returnStack.push(0); // return address
-            Logger::debug("SCRIPT") << "CALLED: " << name << " [" << _script->filename() << "]" << std::endl;
+            Logger::debug("SCRIPT") << "CALLED: " << procedure->name() << " [" << _script->filename() << "]" << std::endl;
             run();
             _dataStack.popInteger(); // remove function result
             Logger::debug("SCRIPT") << "Function ended" << std::endl;
@@ -86,29 +104,64 @@ namespace Falltergeist
 
         void Script::run()
         {
-            while (_programCounter != _script->size()) {
-                if (_programCounter == 0 && _initialized) {
-                    return;
-                }
-                auto offset = _programCounter;
-                _script->setPosition(_programCounter);
-                unsigned short opcode = _script->readOpcode();
-
-                std::unique_ptr<OpcodeHandler> opcodeHandler(OpcodeFactory::createOpcode(opcode, this));
-                try {
-                    opcodeHandler->run();
-                } catch (const HaltException &) {
-                    return;
-                } catch (const ErrorException &e) {
-                    Logger::error("SCRIPT") << e.what() << " in [" << std::hex << opcode << "] at "
-                                            << _script->filename() << ":0x" << offset << std::endl;
-                    _dataStack.values()->clear();
-                    _dataStack.push(0); // to end script properly
-                    return;
+            static const std::shared_ptr<ILogger> logger = std::make_shared<Logger>();
+
+            const auto& instructions = _script->instructions();
+            size_t index = instructions.size();
+            Format::Int::Instruction instruction{};
+            try {
+                while (_programCounter != _script->size()) {
+                    if (_programCounter == 0 && _initialized) {
+                        return;
+                    }
+
+                    // sequential code just moves to the next decoded instruction, jumps and calls search for it
+                    if (index + 1 < instructions.size() && instructions[index + 1].offset == _programCounter) {
+                        ++index;
+                    } else {
+                        index = _script->instructionIndex(_programCounter);
+                    }
+                    instruction = index < instructions.size() ? instructions[index] : _script->decodeInstruction(_programCounter);
+
+                    auto executor = OpcodeFactory::executor(instruction.opcode);
+                    if (!executor) {
+                        std::stringstream ss;
+                        ss << "Script::run() - unimplemented opcode: " << std::hex << instruction.opcode;
+                        throw Exception(ss.str());
+                    }
+
+                    _operand = instruction.operand;
+                    _operandKind = instruction.operandKind;
+                    executor(this, logger);
+
+                    if (_halted) {
+                        _halted = false;
+                        return;
+                    }
                 }
+            } catch (const ErrorException &e) {
+                Logger::error("SCRIPT") << e.what() << " in [" << std::hex << instruction.opcode << "] at "
+                                        << _script->filename() << ":0x" << instruction.offset << std::endl;
+                _dataStack.clear();
+                _dataStack.push(0); // to end script properly
             }
         }
 
+        void Script::halt()
+        {
+            _halted = true;
+        }
+
+        uint32_t Script::operand() const
+        {
+            return _operand;
+        }
+
+        Format::Int::OperandKind Script::operandKind() const
+        {
+            return _operandKind;
+        }
+
         std::string Script::msgMessage(int msg_file_num, int msg_num)
         {
             auto lst = ResourceManager::getInstance()->lstFileType("scripts/scripts.lst");
@@ -1,25 +1,28 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "../Format/Enums.h"
 #include "../VM/Stack.h"
 #include "../VM/StackValue.h"
 
 namespace Falltergeist
 {
+    namespace Game
+    {
+        class Object;
+    }
+
     namespace Format
     {
         namespace Int
         {
             class File;
+            class Procedure;
+            enum class OperandKind : uint8_t;
         }
     }
 
-    namespace Game
-    {
-        class Object;
-    }
-
     namespace VM
     {
         /**
@@ -39,6 +42,14 @@ namespace Falltergeist
 
                 void run();
 
+                // Stops execution after the current opcode
+                void halt();
+
+                // Inline value of the current push opcode
+                uint32_t operand() const;
+                // How the current push opcode treats its value
+                Format::Int::OperandKind operandKind() const;
+
                 void initialize();
 
                 bool initialized();
@@ -58,8 +69,13 @@ namespace Falltergeist
 
                 bool hasFunction(const std::string &name);
 
+                bool hasFunction(PROCEDURE procedure);
+
                 void call(const std::string &name);
 
+                // Calls one of the standard procedures, does nothing if script doesn't have it
+                void call(PROCEDURE procedure);
+
                 Format::Int::File *script();
 
                 Game::Object *owner();
@@ -99,6 +115,10 @@ namespace Falltergeist
                 VM::Script *setUsedSkill(SKILL skill);
 
             protected:
+                // stacks are allocated once, scripts which go deeper fail with ErrorException
+                static const size_t DATA_STACK_CAPACITY = 512;
+                static const size_t RETURN_STACK_CAPACITY = 256;
+
                 Game::Object *_owner = nullptr;
                 Game::Object *_sourceObject = nullptr;
                 Game::Object *_targetObject = nullptr;
@@ -115,6 +135,11 @@ namespace Falltergeist
                 unsigned int _programCounter = 0;
                 size_t _DVAR_base = 0;
                 size_t _SVAR_base = 0;
+                bool _halted = false;
+                uint32_t _operand = 0;
+                Format::Int::OperandKind _operandKind{};
+
+                void _call(const Format::Int::Procedure* procedure);
         };
     }
 }
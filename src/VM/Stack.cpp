@@ -1,5 +1,7 @@
 #include <string>
+#include <utility>
 #include "../Exception.h"
+#include "../VM/ErrorException.h"
 #include "../VM/Stack.h"
 #include "../VM/StackValue.h"
 
@@ -7,7 +9,7 @@ namespace Falltergeist
 {
     namespace VM
     {
-        Stack::Stack()
+        Stack::Stack(size_t capacity) : _values(new StackValue[capacity]), _capacity(capacity)
         {
         }
 
@@ -17,46 +19,60 @@ namespace Falltergeist
 
         void Stack::push(const StackValue &value)
         {
-            _values.push_back(value);
+            if (_size == _capacity) {
+                throw ErrorException("Stack::push() - stack overflow, capacity is " + std::to_string(_capacity));
+            }
+            _values[_size++] = value;
         }
 
-        const StackValue Stack::pop()
+        StackValue Stack::pop()
         {
-            if (_values.size() == 0) {
+            if (_size == 0) {
                 throw Exception("Stack::pop() - stack is empty");
             }
-            auto value = _values.back();
-            _values.pop_back();
-            return value;
+            // moving leaves an empty cell, so popped strings don't stay referenced by the stack
+            return std::move(_values[--_size]);
         }
 
-        size_t Stack::size()
+        size_t Stack::size() const
         {
-            return _values.size();
+            return _size;
+        }
+
+        size_t Stack::capacity() const
+        {
+            return _capacity;
         }
 
         void Stack::swap()
         {
-            if (_values.size() < 2) {
+            if (_size < 2) {
                 throw Exception("Stack::swap() - size is < 2");
             }
+            std::swap(_values[_size - 1], _values[_size - 2]);
+        }
 
-            auto value1 = _values.back();
-            _values.pop_back();
-            auto value2 = _values.back();
-            _values.pop_back();
-            _values.push_back(value1);
-            _values.push_back(value2);
+        StackValue &Stack::at(size_t index)
+        {
+            if (index >= _size) {
+                throw ErrorException("Stack::at() - index " + std::to_string(index) + " is out of range, size is " + std::to_string(_size));
+            }
+            return _values[index];
         }
 
-        std::vector<StackValue> *Stack::values()
+        void Stack::clear()
         {
-            return &_values;
+            while (_size != 0) {
+                _values[--_size] = StackValue();
+            }
         }
 
-        const StackValue Stack::top()
+        const StackValue &Stack::top() const
         {
-            return _values.back();
+            if (_size == 0) {
+                throw Exception("Stack::top() - stack is empty");
+            }
+            return _values[_size - 1];
         }
 
         int Stack::popInteger()
@@ -1,7 +1,8 @@
 #pragma once
 
 #include <memory>
-#include <vector>
+#include <string>
+#include "../VM/StackValue.h"
 
 namespace Falltergeist
 {
@@ -12,15 +13,17 @@ namespace Falltergeist
 
     namespace VM
     {
-        class StackValue;
-
+        // Stack of values with fixed capacity, allocated once and never reallocated
         class Stack
         {
             public:
-                Stack();
+                explicit Stack(size_t capacity);
 
                 ~Stack();
 
+                Stack(const Stack &) = delete;
+                Stack &operator=(const Stack &) = delete;
+
                 void push(const StackValue &value);
 
                 void push(unsigned int value);
@@ -33,7 +36,7 @@ namespace Falltergeist
 
                 void push(const std::string &value);
 
-                const StackValue pop();
+                StackValue pop();
 
                 int popInteger();
 
@@ -45,16 +48,23 @@ namespace Falltergeist
 
                 bool popLogical();
 
-                const StackValue top();
+                const StackValue &top() const;
+
+                // value at given position counting from the bottom of the stack
+                StackValue &at(size_t index);
+
+                void clear();
 
-                std::vector<StackValue> *values();
+                size_t size() const;
 
-                size_t size();
+                size_t capacity() const;
 
                 void swap();
 
             protected:
-                std::vector<StackValue> _values;
+                std::unique_ptr<StackValue[]> _values;
+                size_t _size = 0;
+                size_t _capacity;
         };
     }
 }
@@ -5,11 +5,14 @@
 #include "../Game/Object.h"
 #include "../VM/ErrorException.h"
 #include "../VM/StackValue.h"
+#include "../VM/StringPool.h"
 
 namespace Falltergeist
 {
     namespace VM
     {
+        static_assert(sizeof(StackValue) <= 16, "StackValue should fit in 16 bytes");
+
         StackValue::StackValue()
         {
             _type = Type::INTEGER;
@@ -31,7 +34,7 @@ namespace Falltergeist
         StackValue::StackValue(const std::string &value)
         {
             _type = Type::STRING;
-            _stringValue = value;
+            _stringId = StringPool::add(value);
         }
 
         StackValue::StackValue(Game::Object *value)
@@ -41,8 +44,80 @@ namespace Falltergeist
             _objectValue = value;
         }
 
+        StackValue::StackValue(const StackValue &other)
+        {
+            _assign(other);
+            if (_type == Type::STRING) {
+                StringPool::retain(_stringId);
+            }
+        }
+
+        StackValue::StackValue(StackValue &&other)
+        {
+            // the reference to a string moves along with the value
+            _assign(other);
+            other._type = Type::INTEGER;
+            other._intValue = 0;
+        }
+
+        StackValue &StackValue::operator=(const StackValue &other)
+        {
+            if (other._type == Type::STRING) {
+                StringPool::retain(other._stringId);
+            }
+            if (_type == Type::STRING) {
+                StringPool::release(_stringId);
+            }
+            _assign(other);
+            return *this;
+        }
+
+        StackValue &StackValue::operator=(StackValue &&other)
+        {
+            if (this == &other) {
+                return *this;
+            }
+            if (_type == Type::STRING) {
+                StringPool::release(_stringId);
+            }
+            _assign(other);
+            other._type = Type::INTEGER;
+            other._intValue = 0;
+            return *this;
+        }
+
         StackValue::~StackValue()
         {
+            if (_type == Type::STRING) {
+                StringPool::release(_stringId);
+            }
+        }
+
+        void StackValue::_assign(const StackValue &other)
+        {
+            _type = other._type;
+            switch (_type) {
+                case Type::INTEGER:
+                    _intValue = other._intValue;
+                    break;
+                case Type::FLOAT:
+                    _floatValue = other._floatValue;
+                    break;
+                case Type::STRING:
+                    _stringId = other._stringId;
+                    break;
+                case Type::OBJECT:
+                    _objectValue = other._objectValue;
+                    break;
+            }
+        }
+
+        StackValue StackValue::constant(uint32_t stringId)
+        {
+            StackValue value;
+            value._type = Type::STRING;
+            value._stringId = stringId;
+            return value;
         }
 
         StackValue::Type StackValue::type() const
@@ -73,13 +148,13 @@ namespace Falltergeist
             return _floatValue;
         }
 
-        std::string StackValue::stringValue() const
+        const std::string &StackValue::stringValue() const
         {
             if (_type != Type::STRING) {
                 throw ErrorException(
                     std::string("StackValue::stringValue() - stack value is not string, it is ") + typeName(_type));
             }
-            return _stringValue;
+            return StringPool::get(_stringId);
         }
 
         Game::Object *StackValue::objectValue() const
@@ -105,7 +180,7 @@ namespace Falltergeist
                     return ss.str();
                 }
                 case Type::STRING:
-                    return _stringValue;
+                    return StringPool::get(_stringId);
                 case Type::OBJECT:
                     return _objectValue ? _objectValue->name() : std::string(
                             "(null)"); // just in case, we should never create null object value
@@ -125,7 +200,7 @@ namespace Falltergeist
                 case Type::STRING: {
                     int result = 0;
                     try {
-                        result = std::stoi(_stringValue, nullptr, 0);
+                        result = std::stoi(StringPool::get(_stringId), nullptr, 0);
                     }
                     catch (const std::invalid_argument &) {}
                     catch (const std::out_of_range &) {}
@@ -146,7 +221,7 @@ namespace Falltergeist
                 case Type::FLOAT:
                     return (bool) _floatValue;
                 case Type::STRING:
-                    return _stringValue.length() > 0;
+                    return !StringPool::get(_stringId).empty();
                 case Type::OBJECT:
                     return _objectValue != nullptr;
             }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace Falltergeist
@@ -10,6 +11,8 @@ namespace Falltergeist
     }
     namespace VM
     {
+        // Value of a script variable or stack cell. Strings are stored in StringPool, so values are 16 bytes and cheap to copy.
+        // String values hold a reference to their pool entry.
         class StackValue
         {
             public:
@@ -31,7 +34,14 @@ namespace Falltergeist
 
                 StackValue(Game::Object *value);
 
-                virtual ~StackValue();
+                StackValue(const StackValue &other);
+                StackValue(StackValue &&other);
+                StackValue &operator=(const StackValue &other);
+                StackValue &operator=(StackValue &&other);
+                ~StackValue();
+
+                // Value of a string constant which is already interned in StringPool
+                static StackValue constant(uint32_t stringId);
 
                 Type type() const;
 
@@ -44,7 +54,7 @@ namespace Falltergeist
                 float floatValue() const;
 
                 // returns string value or throws exception if it's not string
-                std::string stringValue() const;
+                const std::string &stringValue() const;
 
                 // returns object pointer or throws exception if it's not object
                 Game::Object *objectValue() const;
@@ -67,8 +77,12 @@ namespace Falltergeist
                     int32_t _intValue;
                     float _floatValue;
                     Game::Object *_objectValue;
+                    // id within StringPool
+                    uint32_t _stringId;
                 };
-                std::string _stringValue;
+
+                // copies type and value without counting references
+                void _assign(const StackValue &other);
         };
     }
 }
@@ -0,0 +1,116 @@
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#include "../VM/ErrorException.h"
+#include "../VM/StringPool.h"
+
+namespace Falltergeist
+{
+    namespace VM
+    {
+        namespace
+        {
+            // reference counter of strings which are never removed
+            const uint32_t CONSTANT = std::numeric_limits<uint32_t>::max();
+
+            struct Entry
+            {
+                std::string value;
+                uint32_t references;
+            };
+
+            struct Storage
+            {
+                std::vector<Entry> entries;
+                // ids of removed strings, reused by the next ones
+                std::vector<uint32_t> freeIds;
+                // only constants are looked up by value
+                std::unordered_map<std::string, uint32_t> constants;
+                size_t size = 0;
+
+                Storage()
+                {
+                    // empty string always has id 0
+                    entries.push_back({std::string(), CONSTANT});
+                    constants.emplace(std::string(), 0);
+                    size = 1;
+                }
+
+                uint32_t add(const std::string &value, uint32_t references)
+                {
+                    ++size;
+                    if (!freeIds.empty()) {
+                        uint32_t id = freeIds.back();
+                        freeIds.pop_back();
+                        entries[id].value = value;
+                        entries[id].references = references;
+                        return id;
+                    }
+                    entries.push_back({value, references});
+                    return static_cast<uint32_t>(entries.size() - 1);
+                }
+            };
+
+            Storage &storage()
+            {
+                static Storage instance;
+                return instance;
+            }
+        }
+
+        uint32_t StringPool::intern(const std::string &value)
+        {
+            auto &pool = storage();
+            auto it = pool.constants.find(value);
+            if (it != pool.constants.end()) {
+                return it->second;
+            }
+            uint32_t id = pool.add(value, CONSTANT);
+            pool.constants.emplace(value, id);
+            return id;
+        }
+
+        uint32_t StringPool::add(const std::string &value)
+        {
+            if (value.empty()) {
+                return 0;
+            }
+            return storage().add(value, 1);
+        }
+
+        void StringPool::retain(uint32_t id)
+        {
+            auto &entry = storage().entries[id];
+            if (entry.references != CONSTANT) {
+                ++entry.references;
+            }
+        }
+
+        void StringPool::release(uint32_t id)
+        {
+            auto &pool = storage();
+            auto &entry = pool.entries[id];
+            if (entry.references == CONSTANT || --entry.references != 0) {
+                return;
+            }
+            // release memory of the string, not just its contents
+            std::string().swap(entry.value);
+            pool.freeIds.push_back(id);
+            --pool.size;
+        }
+
+        const std::string &StringPool::get(uint32_t id)
+        {
+            auto &pool = storage();
+            if (id >= pool.entries.size()) {
+                throw ErrorException("StringPool::get() - no string with id " + std::to_string(id));
+            }
+            return pool.entries[id].value;
+        }
+
+        size_t StringPool::size()
+        {
+            return storage().size;
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Falltergeist
+{
+    namespace VM
+    {
+        /**
+         * Storage of all strings used by script values, so stack values only keep 32-bit ids.
+         * Constants of script files are interned once and stay until the program exits.
+         * Strings made at run time are counted by the values which refer to them and are removed with the last one.
+         * Scripts run on the main thread only, so the pool is not synchronized and must not be used from other threads.
+         */
+        class StringPool
+        {
+            public:
+                // Returns id of given constant string, adding it to the pool if needed
+                static uint32_t intern(const std::string &value);
+
+                // Adds string made at run time with one reference and returns its id
+                static uint32_t add(const std::string &value);
+
+                // Adds and removes a reference to given string, constants are not counted
+                static void retain(uint32_t id);
+                static void release(uint32_t id);
+
+                // Returns string with given id
+                static const std::string &get(uint32_t id);
+
+                // Number of strings in the pool
+                static size_t size();
+
+            protected:
+                StringPool() = default;
+                ~StringPool() = default;
+        };
+    }
+}
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include "CrossPlatform.h"
+#include "Format/Dat/Entry.h"
+#include "Format/Dat/File.h"
+#include "VirtualFileSystem.h"
+
+namespace Falltergeist
+{
+    namespace
+    {
+        inline char normalizeChar(char chr)
+        {
+            return chr == '\\' ? '/' : static_cast<char>(::tolower(static_cast<unsigned char>(chr)));
+        }
+    }
+
+    void VirtualFileSystem::addDirectory(const std::string& path, const std::string& prefix, const std::vector<std::string>& subdirectories)
+    {
+        auto source = static_cast<uint32_t>(_sources.size());
+        _sources.push_back(path);
+
+        std::function<bool(const std::string&)> descend;
+        if (!subdirectories.empty())
+        {
+            descend = [&subdirectories](const std::string& directory) {
+                // nested directories are scanned whenever their top-level one is
+                std::string topDirectory = directory.substr(0, directory.find('/'));
+                std::transform(topDirectory.begin(), topDirectory.end(), topDirectory.begin(), normalizeChar);
+                return std::find(subdirectories.begin(), subdirectories.end(), topDirectory) != subdirectories.end();
+            };
+        }
+
+        for (auto& filename : CrossPlatform::findFiles(path, descend))
+        {
+            Record record;
+            record.pathLength = static_cast<uint32_t>(prefix.size() + filename.size());
+            record.pathOffset = _intern(prefix + filename, true);
+            record.diskPathLength = static_cast<uint32_t>(filename.size());
+            record.diskPathOffset = _intern(filename, false);
+            record.source = source;
+            record.entry = nullptr;
+            _records.push_back(record);
+        }
+    }
+
+    void VirtualFileSystem::addDatFile(Format::Dat::File* datFile)
+    {
+        auto source = static_cast<uint32_t>(_sources.size());
+        _sources.push_back(datFile->filename());
+
+        for (auto& item : datFile->entries())
+        {
+            Record record;
+            record.pathLength = static_cast<uint32_t>(item.first.size());
+            record.pathOffset = _intern(item.first, true);
+            record.diskPathOffset = 0;
+            record.diskPathLength = 0;
+            record.source = source;
+            record.entry = &item.second;
+            _records.push_back(record);
+        }
+    }
+
+    std::vector<std::string> VirtualFileSystem::topDirectories(const std::vector<Format::Dat::File*>& datFiles)
+    {
+        std::vector<std::string> directories;
+        for (auto datFile : datFiles)
+        {
+            for (auto& item : datFile->entries())
+            {
+                auto length = item.first.find_first_of("/\\");
+                if (length == std::string::npos)
+                {
+                    continue;
+                }
+                std::string directory = item.first.substr(0, length);
+                std::transform(directory.begin(), directory.end(), directory.begin(), normalizeChar);
+                if (std::find(directories.begin(), directories.end(), directory) == directories.end())
+                {
+                    directories.push_back(directory);
+                }
+            }
+        }
+        return directories;
+    }
+
+    void VirtualFileSystem::build()
+    {
+        const char* pool = _pool.data();
+        auto less = [pool](const Record& a, const Record& b) {
+            int result = std::char_traits<char>::compare(pool + a.pathOffset, pool + b.pathOffset, std::min(a.pathLength, b.pathLength));
+            if (result != 0)
+            {
+                return result < 0;
+            }
+            if (a.pathLength != b.pathLength)
+            {
+                return a.pathLength < b.pathLength;
+            }
+            return a.source < b.source;
+        };
+        auto equal = [pool](const Record& a, const Record& b) {
+            return a.pathLength == b.pathLength
+                && std::char_traits<char>::compare(pool + a.pathOffset, pool + b.pathOffset, a.pathLength) == 0;
+        };
+
+        std::sort(_records.begin(), _records.end(), less);
+        // the first one of equal paths comes from the source with the highest priority
+        _records.erase(std::unique(_records.begin(), _records.end(), equal), _records.end());
+        _records.shrink_to_fit();
+        _pool.shrink_to_fit();
+    }
+
+    const VirtualFileSystem::Record* VirtualFileSystem::find(const std::string& filename) const
+    {
+        auto it = std::lower_bound(_records.begin(), _records.end(), filename, [this](const Record& record, const std::string& value) {
+            return _compare(record, value, false) < 0;
+        });
+        if (it == _records.end() || _compare(*it, filename, false) != 0)
+        {
+            return nullptr;
+        }
+        return &*it;
+    }
+
+    VirtualFileSystem::Range VirtualFileSystem::list(const std::string& prefix) const
+    {
+        auto first = std::lower_bound(_records.begin(), _records.end(), prefix, [this](const Record& record, const std::string& value) {
+            return _compare(record, value, true) < 0;
+        });
+        auto last = std::upper_bound(first, _records.end(), prefix, [this](const std::string& value, const Record& record) {
+            return _compare(record, value, true) > 0;
+        });
+        return Range(_records.data() + (first - _records.begin()), _records.data() + (last - _records.begin()));
+    }
+
+    std::string VirtualFileSystem::path(const Record& record) const
+    {
+        return std::string(_pool.data() + record.pathOffset, record.pathLength);
+    }
+
+    std::string VirtualFileSystem::diskPath(const Record& record) const
+    {
+        return _sources.at(record.source) + "/" + std::string(_pool.data() + record.diskPathOffset, record.diskPathLength);
+    }
+
+    const std::string& VirtualFileSystem::sourceName(const Record& record) const
+    {
+        return _sources.at(record.source);
+    }
+
+    size_t VirtualFileSystem::size() const
+    {
+        return _records.size();
+    }
+
+    uint32_t VirtualFileSystem::_intern(const std::string& value, bool normalize)
+    {
+        auto offset = static_cast<uint32_t>(_pool.size());
+        for (auto chr : value)
+        {
+            _pool.push_back(normalize ? normalizeChar(chr) : chr);
+        }
+        return offset;
+    }
+
+    int VirtualFileSystem::_compare(const Record& record, const std::string& filename, bool prefixOnly) const
+    {
+        const char* path = _pool.data() + record.pathOffset;
+        size_t length = std::min<size_t>(record.pathLength, filename.size());
+        for (size_t i = 0; i != length; ++i)
+        {
+            auto a = static_cast<unsigned char>(path[i]);
+            auto b = static_cast<unsigned char>(normalizeChar(filename[i]));
+            if (a != b)
+            {
+                return a < b ? -1 : 1;
+            }
+        }
+        if (record.pathLength == filename.size() || (prefixOnly && record.pathLength > filename.size()))
+        {
+            return 0;
+        }
+        return record.pathLength < filename.size() ? -1 : 1;
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Dat
+        {
+            class Entry;
+            class File;
+        }
+    }
+
+    // Index of all game files from all sources: plain directories and DAT archives.
+    // Built once at startup. File names are stored normalized (lowercase, forward slashes) in a single string pool,
+    // records are kept in a flat sorted array, so lookups are case-insensitive binary searches which never allocate.
+    // When the same file exists in several sources, the one added first wins.
+    class VirtualFileSystem
+    {
+        public:
+            struct Record
+            {
+                // normalized path within the string pool
+                uint32_t pathOffset;
+                uint32_t pathLength;
+                // original path relative to the source directory, used to open files on case-sensitive file systems
+                uint32_t diskPathOffset;
+                uint32_t diskPathLength;
+                uint32_t source;
+                // nullptr for files from plain directories
+                Format::Dat::Entry* entry;
+            };
+
+            using Range = std::pair<const Record*, const Record*>;
+
+            // Adds all files from given directory and its subdirectories.
+            // Paths within the directory are prefixed with given prefix, e.g. "data/".
+            // When subdirectories are given, only files at the top level and within these subdirectories (in any case) are added.
+            void addDirectory(const std::string& path, const std::string& prefix = "", const std::vector<std::string>& subdirectories = {});
+
+            // Normalized names of top-level directories of all entries of given archives, e.g. "art" or "maps".
+            // Loose files can only override archive entries within these directories.
+            static std::vector<std::string> topDirectories(const std::vector<Format::Dat::File*>& datFiles);
+
+            // Adds all entries of given archive
+            void addDatFile(Format::Dat::File* datFile);
+
+            // Sorts records and removes overridden ones. Must be called after all sources are added.
+            void build();
+
+            // Record for given file name (in any case, with any slashes) or nullptr if there is no such file
+            const Record* find(const std::string& filename) const;
+
+            // All records which normalized paths start with given prefix, e.g. "art/critters/"
+            Range list(const std::string& prefix) const;
+
+            // Normalized path of given record
+            std::string path(const Record& record) const;
+
+            // Full path of the file on disk for records from plain directories
+            std::string diskPath(const Record& record) const;
+
+            // Directory path or DAT file name the record was taken from
+            const std::string& sourceName(const Record& record) const;
+
+            size_t size() const;
+
+        private:
+            std::vector<char> _pool;
+            std::vector<Record> _records;
+            std::vector<std::string> _sources;
+
+            uint32_t _intern(const std::string& value, bool normalize);
+            // Three-way comparison of normalized record path with the beginning of arbitrary file name
+            int _compare(const Record& record, const std::string& filename, bool prefixOnly) const;
+    };
+}